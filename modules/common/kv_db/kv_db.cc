@@ -15,59 +15,163 @@
  *****************************************************************************/
 #include "modules/common/kv_db/kv_db.h"
 
-#include <leveldb/env.h>
+#include <fcntl.h>
 #include <leveldb/options.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include "gflags/gflags.h"
+#include "modules/common/log.h"
 #include "modules/common/util/file.h"
-#include "modules/common/util/util.h"
 
 DEFINE_string(kv_db_path, "/apollo/data/kv_db", "Path to param DB file.");
+DEFINE_int32(kv_db_idle_timeout_ms, 200,
+             "Release the DB to other processes after it has not been used "
+             "for this long. Negative to keep it open until exit.");
 
 namespace apollo {
 namespace common {
 namespace {
 
-class BlockingEnv : public leveldb::EnvWrapper {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The process-wide DB handle. LevelDB allows only one process to open a DB, so
+ * the handle also holds an exclusive lock on "<kv_db_path>.lock" while open.
+ * Other processes wait in flock() until it is released.
+ */
+class DBHandle {
  public:
-  BlockingEnv() : leveldb::EnvWrapper(leveldb::Env::Default()) {}
-
-  // Block on trying to lock file.
-  leveldb::Status LockFile(const std::string& fname, leveldb::FileLock** lock) {
-    constexpr unsigned int USLEEP_INTERVAL = 100 * 1000;  // 0.1 second.
-    while (!leveldb::EnvWrapper::LockFile(fname, lock).ok()) {
-      AINFO_EVERY(100) << "Trying to get KVDB lock.";
-      usleep(USLEEP_INTERVAL);
+  static DBHandle *Instance() {
+    static DBHandle instance;
+    return &instance;
+  }
+
+  ~DBHandle() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+      Close();
+    }
+    cv_.notify_all();
+    if (releaser_.joinable()) {
+      releaser_.join();
     }
-    return leveldb::Status::OK();
   }
-};
 
-leveldb::Options DBOptions() {
-  leveldb::Options options;
-  options.create_if_missing = true;
-  options.env = new BlockingEnv();
-  return options;
-}
+  // Runs func with the DB, opening it if needed. Returns false if the DB could
+  // not be opened.
+  bool Run(const std::function<void(leveldb::DB *)> &func) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (db_ == nullptr && !Open()) {
+      return false;
+    }
+    func(db_.get());
+    last_access_ = Clock::now();
+    lock.unlock();
+    cv_.notify_all();
+    return true;
+  }
 
-}  // namespace
+  void Release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Close();
+  }
 
-std::unique_ptr<leveldb::DB> KVDB::GetDB() {
-  static const auto options = DBOptions();
-  leveldb::DB *db = nullptr;
-  CHECK(apollo::common::util::EnsureDirectory(FLAGS_kv_db_path));
-  const auto status = leveldb::DB::Open(options, FLAGS_kv_db_path, &db);
-  CHECK(status.ok()) << "Unable to open DB path " << FLAGS_kv_db_path
-                     << "\n" << status.ToString();
-  return std::unique_ptr<leveldb::DB>(db);
-}
+ private:
+  DBHandle() = default;
+
+  bool Open() {
+    if (!apollo::common::util::EnsureDirectory(FLAGS_kv_db_path)) {
+      AERROR << "Unable to create DB path " << FLAGS_kv_db_path;
+      return false;
+    }
+    const std::string lock_path = FLAGS_kv_db_path + ".lock";
+    lock_fd_ = open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lock_fd_ < 0) {
+      AERROR << "Unable to open " << lock_path << ": " << strerror(errno);
+      return false;
+    }
+    if (flock(lock_fd_, LOCK_EX | LOCK_NB) != 0) {
+      AINFO << "Waiting for another process to release KVDB.";
+      while (flock(lock_fd_, LOCK_EX) != 0 && errno == EINTR) {
+      }
+    }
+
+    leveldb::Options options;
+    options.create_if_missing = true;
+    leveldb::DB *db = nullptr;
+    const auto status = leveldb::DB::Open(options, FLAGS_kv_db_path, &db);
+    if (!status.ok()) {
+      AERROR << "Unable to open DB path " << FLAGS_kv_db_path << "\n"
+             << status.ToString();
+      Close();
+      return false;
+    }
+    db_.reset(db);
+    last_access_ = Clock::now();
+    if (!releaser_.joinable() && FLAGS_kv_db_idle_timeout_ms >= 0) {
+      releaser_ = std::thread(&DBHandle::ReleaseIdle, this);
+    }
+    return true;
+  }
+
+  void Close() {
+    db_.reset();
+    if (lock_fd_ >= 0) {
+      flock(lock_fd_, LOCK_UN);
+      close(lock_fd_);
+      lock_fd_ = -1;
+    }
+  }
+
+  // Closes the DB once it has been idle for FLAGS_kv_db_idle_timeout_ms.
+  void ReleaseIdle() {
+    const auto timeout =
+        std::chrono::milliseconds(FLAGS_kv_db_idle_timeout_ms);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+      if (db_ == nullptr) {
+        cv_.wait(lock);
+      } else if (Clock::now() >= last_access_ + timeout) {
+        Close();
+      } else {
+        cv_.wait_until(lock, last_access_ + timeout);
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::unique_ptr<leveldb::DB> db_;
+  int lock_fd_ = -1;
+  Clock::time_point last_access_;
+  bool stopped_ = false;
+  std::thread releaser_;
+};
+
+}  // namespace
 
 bool KVDB::Put(const std::string &key, const std::string &value,
                const bool sync) {
   leveldb::WriteOptions options;
   options.sync = sync;
 
-  const auto status = GetDB()->Put(options, key, value);
+  leveldb::Status status;
+  if (!DBHandle::Instance()->Run([&](leveldb::DB *db) {
+        status = db->Put(options, key, value);
+      })) {
+    return false;
+  }
   AERROR_IF(!status.ok()) << status.ToString();
   return status.ok();
 }
@@ -76,7 +180,12 @@ bool KVDB::Delete(const std::string &key, const bool sync) {
   leveldb::WriteOptions options;
   options.sync = sync;
 
-  const auto status = GetDB()->Delete(options, key);
+  leveldb::Status status;
+  if (!DBHandle::Instance()->Run([&](leveldb::DB *db) {
+        status = db->Delete(options, key);
+      })) {
+    return false;
+  }
   AERROR_IF(!status.ok()) << status.ToString();
   return status.ok();
 }
@@ -85,8 +194,10 @@ bool KVDB::Has(const std::string &key) {
   static leveldb::ReadOptions options;
 
   std::string value;
-  const auto status = GetDB()->Get(options, key, &value);
-  return !status.IsNotFound();
+  leveldb::Status status;
+  return DBHandle::Instance()->Run([&](leveldb::DB *db) {
+    status = db->Get(options, key, &value);
+  }) && !status.IsNotFound();
 }
 
 std::string KVDB::Get(const std::string &key,
@@ -94,9 +205,48 @@ std::string KVDB::Get(const std::string &key,
   static leveldb::ReadOptions options;
 
   std::string value;
-  const auto status = GetDB()->Get(options, key, &value);
+  leveldb::Status status;
+  if (!DBHandle::Instance()->Run([&](leveldb::DB *db) {
+        status = db->Get(options, key, &value);
+      })) {
+    return default_value;
+  }
   return status.ok() ? value : default_value;
 }
 
+bool KVDB::Write(const Batch &batch, const bool sync) {
+  leveldb::WriteOptions options;
+  options.sync = sync;
+
+  leveldb::Status status;
+  // LevelDB takes a mutable batch but does not modify it.
+  auto *write_batch = const_cast<leveldb::WriteBatch *>(&batch.batch_);
+  if (!DBHandle::Instance()->Run([&](leveldb::DB *db) {
+        status = db->Write(options, write_batch);
+      })) {
+    return false;
+  }
+  AERROR_IF(!status.ok()) << status.ToString();
+  return status.ok();
+}
+
+std::map<std::string, std::string> KVDB::GetByPrefix(
+    const std::string &prefix) {
+  static leveldb::ReadOptions options;
+
+  std::map<std::string, std::string> result;
+  DBHandle::Instance()->Run([&](leveldb::DB *db) {
+    std::unique_ptr<leveldb::Iterator> it(db->NewIterator(options));
+    for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+         it->Next()) {
+      result.emplace(it->key().ToString(), it->value().ToString());
+    }
+    AERROR_IF(!it->status().ok()) << it->status().ToString();
+  });
+  return result;
+}
+
+void KVDB::Release() { DBHandle::Instance()->Release(); }
+
 }  // namespace common
 }  // namespace apollo
@@ -18,7 +18,8 @@
 #define MODULES_COMMON_KV_DB_KV_DB_H_
 
 #include <leveldb/db.h>
-#include <memory>
+#include <leveldb/write_batch.h>
+#include <map>
 #include <string>
 
 /**
@@ -33,9 +34,31 @@ namespace common {
  *
  * @brief Lightweight key-value database to store system-wide parameters.
  *        We prefer keys like "apollo:data:commit_id".
+ *
+ *        The DB is opened once per process and kept open while it is in use.
+ *        It is released after being idle for FLAGS_kv_db_idle_timeout_ms, so
+ *        that other processes can open it. A process waiting for another one
+ *        to release the DB blocks on a file lock.
  */
 class KVDB {
  public:
+  /**
+   * @class Batch
+   * @brief A group of writes applied atomically by KVDB::Write().
+   */
+  class Batch {
+   public:
+    void Put(const std::string &key, const std::string &value) {
+      batch_.Put(key, value);
+    }
+    void Delete(const std::string &key) { batch_.Delete(key); }
+    void Clear() { batch_.Clear(); }
+
+   private:
+    friend class KVDB;
+    leveldb::WriteBatch batch_;
+  };
+
   /**
    * @brief Store {key, value} to DB.
    * @param sync Whether flush right after writing.
@@ -57,8 +80,25 @@ class KVDB {
   static std::string Get(const std::string &key,
                          const std::string &default_value = "");
 
- private:
-  static std::unique_ptr<leveldb::DB> GetDB();
+  /**
+   * @brief Apply all writes of a batch atomically.
+   * @param sync Whether flush right after writing.
+   * @return Success or not.
+   */
+  static bool Write(const Batch &batch, const bool sync = false);
+
+  /**
+   * @brief Get all {key, value} pairs whose key starts with the prefix, such
+   *        as "apollo:dreamview:".
+   */
+  static std::map<std::string, std::string> GetByPrefix(
+      const std::string &prefix);
+
+  /**
+   * @brief Release the DB now instead of after the idle timeout. The next
+   *        access opens it again.
+   */
+  static void Release();
 };
 
 }  // namespace common
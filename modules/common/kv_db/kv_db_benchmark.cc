@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "gflags/gflags.h"
+#include "modules/common/kv_db/kv_db.h"
+
+DECLARE_string(kv_db_path);
+
+namespace apollo {
+namespace common {
+namespace {
+
+void UseBenchmarkDB() { FLAGS_kv_db_path = "/tmp/kv_db_benchmark"; }
+
+void BM_Put(benchmark::State &state) {
+  UseBenchmarkDB();
+  int i = 0;
+  while (state.KeepRunning()) {
+    KVDB::Put("benchmark:key" + std::to_string(i++ % 100), "value");
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Get(benchmark::State &state) {
+  UseBenchmarkDB();
+  KVDB::Put("benchmark:key", "value");
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(KVDB::Get("benchmark:key"));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Writes range(0) keys per batch.
+void BM_WriteBatch(benchmark::State &state) {
+  UseBenchmarkDB();
+  KVDB::Batch batch;
+  for (int i = 0; i < state.range(0); ++i) {
+    batch.Put("benchmark:key" + std::to_string(i), "value");
+  }
+  while (state.KeepRunning()) {
+    KVDB::Write(batch);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_GetByPrefix(benchmark::State &state) {
+  UseBenchmarkDB();
+  KVDB::Batch batch;
+  for (int i = 0; i < 100; ++i) {
+    batch.Put("benchmark:prefix:key" + std::to_string(i), "value");
+  }
+  KVDB::Write(batch);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(KVDB::GetByPrefix("benchmark:prefix:"));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Opening the DB on every access, as each operation used to.
+void BM_GetReopen(benchmark::State &state) {
+  UseBenchmarkDB();
+  KVDB::Put("benchmark:key", "value");
+  while (state.KeepRunning()) {
+    KVDB::Release();
+    benchmark::DoNotOptimize(KVDB::Get("benchmark:key"));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Put);
+BENCHMARK(BM_Get);
+BENCHMARK(BM_WriteBatch)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_GetByPrefix);
+BENCHMARK(BM_GetReopen);
+
+}  // namespace
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
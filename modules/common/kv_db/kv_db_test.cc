@@ -15,6 +15,9 @@
  *****************************************************************************/
 #include "modules/common/kv_db/kv_db.h"
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -46,6 +49,66 @@ TEST(KVDBTest, GetDefault) {
   EXPECT_EQ("default", KVDB::Get("test_key", "default"));
 }
 
+TEST(KVDBTest, Batch) {
+  KVDB::Put("test_key", "val0");
+
+  KVDB::Batch batch;
+  batch.Put("test_key_a", "a");
+  batch.Put("test_key_b", "b");
+  batch.Delete("test_key");
+  EXPECT_FALSE(KVDB::Has("test_key_a"));
+  EXPECT_TRUE(KVDB::Write(batch));
+  EXPECT_EQ("a", KVDB::Get("test_key_a"));
+  EXPECT_EQ("b", KVDB::Get("test_key_b"));
+  EXPECT_FALSE(KVDB::Has("test_key"));
+
+  batch.Clear();
+  batch.Delete("test_key_a");
+  batch.Delete("test_key_b");
+  EXPECT_TRUE(KVDB::Write(batch, true));
+  EXPECT_FALSE(KVDB::Has("test_key_a"));
+  EXPECT_FALSE(KVDB::Has("test_key_b"));
+}
+
+TEST(KVDBTest, GetByPrefix) {
+  KVDB::Put("test_prefix:a", "0");
+  KVDB::Put("test_prefix:b", "1");
+  KVDB::Put("test_prefix_c", "2");
+
+  const auto values = KVDB::GetByPrefix("test_prefix:");
+  ASSERT_EQ(2, values.size());
+  EXPECT_EQ("0", values.at("test_prefix:a"));
+  EXPECT_EQ("1", values.at("test_prefix:b"));
+  EXPECT_TRUE(KVDB::GetByPrefix("test_prefix:z").empty());
+
+  KVDB::Delete("test_prefix:a");
+  KVDB::Delete("test_prefix:b");
+  KVDB::Delete("test_prefix_c");
+}
+
+TEST(KVDBTest, MultiProcesses) {
+  KVDB::Delete("test_key_child");
+  // The child must not inherit an open DB.
+  KVDB::Release();
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // Waits for the parent to release the DB when idle.
+    _exit(KVDB::Put("test_key_child", "child") ? 0 : 1);
+  }
+  KVDB::Put("test_key", "parent");
+
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  EXPECT_EQ("child", KVDB::Get("test_key_child"));
+  EXPECT_EQ("parent", KVDB::Get("test_key"));
+
+  KVDB::Delete("test_key_child");
+  KVDB::Delete("test_key");
+}
+
 TEST(KVDBTest, MultiThreads) {
   static const int N_THREADS = 3;
 
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/geometry_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/common/log.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+Points2d::Points2d(const std::vector<Vec2d> &points)
+    : x_(points.size()), y_(points.size()) {
+  for (size_t i = 0; i < points.size(); ++i) {
+    x_[i] = points[i].x();
+    y_[i] = points[i].y();
+  }
+}
+
+Points2d::Points2d(const Eigen::ArrayXd &x, const Eigen::ArrayXd &y)
+    : x_(x), y_(y) {
+  CHECK_EQ(x.size(), y.size());
+}
+
+Boxes2d::Boxes2d(const std::vector<Box2d> &boxes) {
+  const int size = static_cast<int>(boxes.size());
+  for (auto *array : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                      &half_length_, &half_width_, &min_x_, &max_x_, &min_y_,
+                      &max_y_}) {
+    array->resize(size);
+  }
+  for (int i = 0; i < size; ++i) {
+    const Box2d &box = boxes[i];
+    center_x_[i] = box.center_x();
+    center_y_[i] = box.center_y();
+    cos_heading_[i] = box.cos_heading();
+    sin_heading_[i] = box.sin_heading();
+    half_length_[i] = box.half_length();
+    half_width_[i] = box.half_width();
+    min_x_[i] = box.min_x();
+    max_x_[i] = box.max_x();
+    min_y_[i] = box.min_y();
+    max_y_[i] = box.max_y();
+  }
+}
+
+void DistancesTo(const LineSegment2d &line_segment, const Points2d &points,
+                 Eigen::ArrayXd *distances) {
+  const Eigen::ArrayXd x0 = points.x() - line_segment.start().x();
+  const Eigen::ArrayXd y0 = points.y() - line_segment.start().y();
+  if (line_segment.length() <= kMathEpsilon) {
+    *distances = (x0.square() + y0.square()).sqrt();
+    return;
+  }
+  const double unit_x = line_segment.unit_direction().x();
+  const double unit_y = line_segment.unit_direction().y();
+  const double end_x = line_segment.end().x() - line_segment.start().x();
+  const double end_y = line_segment.end().y() - line_segment.start().y();
+  const auto proj = x0 * unit_x + y0 * unit_y;
+  *distances =
+      (proj <= 0.0).select(
+          (x0.square() + y0.square()).sqrt(),
+          (proj >= line_segment.length())
+              .select(((x0 - end_x).square() + (y0 - end_y).square()).sqrt(),
+                      (x0 * unit_y - y0 * unit_x).abs()));
+}
+
+void DistancesTo(const std::vector<LineSegment2d> &polyline,
+                 const Points2d &points, Eigen::ArrayXd *distances) {
+  CHECK(!polyline.empty());
+  DistancesTo(polyline.front(), points, distances);
+  Eigen::ArrayXd segment_distances;
+  for (size_t i = 1; i < polyline.size(); ++i) {
+    DistancesTo(polyline[i], points, &segment_distances);
+    *distances = distances->min(segment_distances);
+  }
+}
+
+void DistancesTo(const AABox2d &box, const Points2d &points,
+                 Eigen::ArrayXd *distances) {
+  const auto dx = (points.x() - box.center_x()).abs() - box.half_length();
+  const auto dy = (points.y() - box.center_y()).abs() - box.half_width();
+  *distances = (dx <= 0.0).select(
+      dy.max(0.0),
+      (dy <= 0.0).select(dx, (dx.square() + dy.square()).sqrt()));
+}
+
+void DistancesTo(const Box2d &box, const Points2d &points,
+                 Eigen::ArrayXd *distances) {
+  const auto x0 = points.x() - box.center_x();
+  const auto y0 = points.y() - box.center_y();
+  const auto dx = (x0 * box.cos_heading() + y0 * box.sin_heading()).abs() -
+                  box.half_length();
+  const auto dy = (x0 * box.sin_heading() - y0 * box.cos_heading()).abs() -
+                  box.half_width();
+  *distances = (dx <= 0.0).select(
+      dy.max(0.0),
+      (dy <= 0.0).select(dx, (dx.square() + dy.square()).sqrt()));
+}
+
+void ArePointsIn(const AABox2d &box, const Points2d &points, BoolArray *in) {
+  *in = (points.x() - box.center_x()).abs() <=
+            box.half_length() + kMathEpsilon &&
+        (points.y() - box.center_y()).abs() <= box.half_width() + kMathEpsilon;
+}
+
+void ArePointsIn(const Box2d &box, const Points2d &points, BoolArray *in) {
+  const auto x0 = points.x() - box.center_x();
+  const auto y0 = points.y() - box.center_y();
+  *in = (x0 * box.cos_heading() + y0 * box.sin_heading()).abs() <=
+            box.half_length() + kMathEpsilon &&
+        (-x0 * box.sin_heading() + y0 * box.cos_heading()).abs() <=
+            box.half_width() + kMathEpsilon;
+}
+
+void ArePointsIn(const Polygon2d &polygon, const Points2d &points,
+                 BoolArray *in) {
+  const auto &vertices = polygon.points();
+  CHECK_GE(vertices.size(), 3);
+  const auto &x = points.x();
+  const auto &y = points.y();
+
+  // Crossing number of a ray to +x, as Polygon2d::IsPointIn.
+  in->setConstant(points.size(), false);
+  size_t j = vertices.size() - 1;
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const Vec2d &pi = vertices[i];
+    const Vec2d &pj = vertices[j];
+    const auto side = (pi.x() - x) * (pj.y() - y) - (pj.x() - x) * (pi.y() - y);
+    const auto crossing = (pi.y() > y) != (pj.y() > y);
+    if (pi.y() < pj.y()) {
+      *in = *in != (crossing && side > 0.0);
+    } else {
+      *in = *in != (crossing && side < 0.0);
+    }
+    j = i;
+  }
+
+  // Points on the boundary, as LineSegment2d::IsPointIn.
+  for (const auto &segment : polygon.line_segments()) {
+    const Vec2d &start = segment.start();
+    const Vec2d &end = segment.end();
+    if (segment.length() <= kMathEpsilon) {
+      *in = *in || ((x - start.x()).abs() <= kMathEpsilon &&
+                    (y - start.y()).abs() <= kMathEpsilon);
+      continue;
+    }
+    const double min_x = std::min(start.x(), end.x()) - kMathEpsilon;
+    const double max_x = std::max(start.x(), end.x()) + kMathEpsilon;
+    const double min_y = std::min(start.y(), end.y()) - kMathEpsilon;
+    const double max_y = std::max(start.y(), end.y()) + kMathEpsilon;
+    const auto prod =
+        (start.x() - x) * (end.y() - y) - (end.x() - x) * (start.y() - y);
+    *in = *in || (prod.abs() <= kMathEpsilon && x >= min_x && x <= max_x &&
+                  y >= min_y && y <= max_y);
+  }
+}
+
+void HasOverlaps(const Box2d &box, const Boxes2d &boxes, BoolArray *overlaps) {
+  const double cos_heading = box.cos_heading();
+  const double sin_heading = box.sin_heading();
+  const double dx1 = cos_heading * box.half_length();
+  const double dy1 = sin_heading * box.half_length();
+  const double dx2 = sin_heading * box.half_width();
+  const double dy2 = -cos_heading * box.half_width();
+
+  const Eigen::ArrayXd shift_x = boxes.center_x() - box.center_x();
+  const Eigen::ArrayXd shift_y = boxes.center_y() - box.center_y();
+  const Eigen::ArrayXd dx3 = boxes.cos_heading() * boxes.half_length();
+  const Eigen::ArrayXd dy3 = boxes.sin_heading() * boxes.half_length();
+  const Eigen::ArrayXd dx4 = boxes.sin_heading() * boxes.half_width();
+  const Eigen::ArrayXd dy4 = -boxes.cos_heading() * boxes.half_width();
+
+  // Bounding boxes, then the separating axes of both boxes, as
+  // Box2d::HasOverlap. Each test a <= b is written as a - b <= 0, which is
+  // exact for finite values since a - b is zero only if a == b, so that the
+  // tests are reduced with a vectorized max instead of boolean arrays.
+  Eigen::ArrayXd separation = (box.min_x() - boxes.max_x())
+                                  .max(boxes.min_x() - box.max_x())
+                                  .max(box.min_y() - boxes.max_y())
+                                  .max(boxes.min_y() - box.max_y());
+  separation = separation.max(
+      (shift_x * cos_heading + shift_y * sin_heading).abs() -
+      ((dx3 * cos_heading + dy3 * sin_heading).abs() +
+       (dx4 * cos_heading + dy4 * sin_heading).abs() + box.half_length()));
+  separation = separation.max(
+      (shift_x * sin_heading - shift_y * cos_heading).abs() -
+      ((dx3 * sin_heading - dy3 * cos_heading).abs() +
+       (dx4 * sin_heading - dy4 * cos_heading).abs() + box.half_width()));
+  separation = separation.max(
+      (shift_x * boxes.cos_heading() + shift_y * boxes.sin_heading()).abs() -
+      ((dx1 * boxes.cos_heading() + dy1 * boxes.sin_heading()).abs() +
+       (dx2 * boxes.cos_heading() + dy2 * boxes.sin_heading()).abs() +
+       boxes.half_length()));
+  separation = separation.max(
+      (shift_x * boxes.sin_heading() - shift_y * boxes.cos_heading()).abs() -
+      ((dx1 * boxes.sin_heading() - dy1 * boxes.cos_heading()).abs() +
+       (dx2 * boxes.sin_heading() - dy2 * boxes.cos_heading()).abs() +
+       boxes.half_width()));
+  *overlaps = separation <= 0.0;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
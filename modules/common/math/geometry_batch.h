@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Batch versions of the geometry queries of Vec2d, LineSegment2d,
+ * AABox2d, Box2d and Polygon2d, which run one query against many points or
+ * boxes.
+ *
+ * Points and boxes are stored as structure of arrays, and the queries are
+ * written as Eigen array expressions, which Eigen vectorizes with the SIMD
+ * instructions enabled at compile time and evaluates coefficient by
+ * coefficient otherwise. Predicates give the same results as the scalar
+ * methods. Distances are computed with sqrt instead of hypot, and may differ
+ * from the scalar ones in the last bits.
+ */
+
+#ifndef MODULES_COMMON_MATH_GEOMETRY_BATCH_H_
+#define MODULES_COMMON_MATH_GEOMETRY_BATCH_H_
+
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/polygon2d.h"
+#include "modules/common/math/vec2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+using BoolArray = Eigen::Array<bool, Eigen::Dynamic, 1>;
+
+/**
+ * @class Points2d
+ * @brief Points in 2-D stored as arrays of coordinates.
+ */
+class Points2d {
+ public:
+  Points2d() = default;
+
+  /**
+   * @brief Constructor which takes the points.
+   */
+  explicit Points2d(const std::vector<Vec2d> &points);
+
+  /**
+   * @brief Constructor which takes the coordinates of the points.
+   */
+  Points2d(const Eigen::ArrayXd &x, const Eigen::ArrayXd &y);
+
+  /**
+   * @brief Number of points.
+   */
+  int size() const { return static_cast<int>(x_.size()); }
+
+  const Eigen::ArrayXd &x() const { return x_; }
+  const Eigen::ArrayXd &y() const { return y_; }
+
+  /**
+   * @brief Gets a point.
+   */
+  Vec2d point(const int index) const { return Vec2d(x_[index], y_[index]); }
+
+ private:
+  Eigen::ArrayXd x_;
+  Eigen::ArrayXd y_;
+};
+
+/**
+ * @class Boxes2d
+ * @brief Rectangular bounding boxes in 2-D stored as arrays of their
+ * properties.
+ */
+class Boxes2d {
+ public:
+  Boxes2d() = default;
+
+  /**
+   * @brief Constructor which takes the boxes.
+   */
+  explicit Boxes2d(const std::vector<Box2d> &boxes);
+
+  /**
+   * @brief Number of boxes.
+   */
+  int size() const { return static_cast<int>(center_x_.size()); }
+
+  const Eigen::ArrayXd &center_x() const { return center_x_; }
+  const Eigen::ArrayXd &center_y() const { return center_y_; }
+  const Eigen::ArrayXd &cos_heading() const { return cos_heading_; }
+  const Eigen::ArrayXd &sin_heading() const { return sin_heading_; }
+  const Eigen::ArrayXd &half_length() const { return half_length_; }
+  const Eigen::ArrayXd &half_width() const { return half_width_; }
+  const Eigen::ArrayXd &min_x() const { return min_x_; }
+  const Eigen::ArrayXd &max_x() const { return max_x_; }
+  const Eigen::ArrayXd &min_y() const { return min_y_; }
+  const Eigen::ArrayXd &max_y() const { return max_y_; }
+
+ private:
+  Eigen::ArrayXd center_x_;
+  Eigen::ArrayXd center_y_;
+  Eigen::ArrayXd cos_heading_;
+  Eigen::ArrayXd sin_heading_;
+  Eigen::ArrayXd half_length_;
+  Eigen::ArrayXd half_width_;
+  Eigen::ArrayXd min_x_;
+  Eigen::ArrayXd max_x_;
+  Eigen::ArrayXd min_y_;
+  Eigen::ArrayXd max_y_;
+};
+
+/**
+ * @brief Computes the distances from points to a line segment, as
+ *        LineSegment2d::DistanceTo.
+ * @param line_segment The line segment.
+ * @param points The points.
+ * @param distances The distance of each point to the line segment.
+ */
+void DistancesTo(const LineSegment2d &line_segment, const Points2d &points,
+                 Eigen::ArrayXd *distances);
+
+/**
+ * @brief Computes the distances from points to a polyline, i.e. the shortest
+ *        distance to any of its line segments.
+ * @param polyline The line segments of the polyline, which must not be empty.
+ * @param points The points.
+ * @param distances The distance of each point to the polyline.
+ */
+void DistancesTo(const std::vector<LineSegment2d> &polyline,
+                 const Points2d &points, Eigen::ArrayXd *distances);
+
+/**
+ * @brief Computes the distances from points to an axis-aligned box, as
+ *        AABox2d::DistanceTo.
+ */
+void DistancesTo(const AABox2d &box, const Points2d &points,
+                 Eigen::ArrayXd *distances);
+
+/**
+ * @brief Computes the distances from points to a box, as Box2d::DistanceTo.
+ */
+void DistancesTo(const Box2d &box, const Points2d &points,
+                 Eigen::ArrayXd *distances);
+
+/**
+ * @brief Checks which points are within an axis-aligned box, as
+ *        AABox2d::IsPointIn.
+ */
+void ArePointsIn(const AABox2d &box, const Points2d &points, BoolArray *in);
+
+/**
+ * @brief Checks which points are within a box, as Box2d::IsPointIn.
+ */
+void ArePointsIn(const Box2d &box, const Points2d &points, BoolArray *in);
+
+/**
+ * @brief Checks which points are within a polygon, including its boundary, as
+ *        Polygon2d::IsPointIn.
+ */
+void ArePointsIn(const Polygon2d &polygon, const Points2d &points,
+                 BoolArray *in);
+
+/**
+ * @brief Checks which boxes overlap with a box, as Box2d::HasOverlap.
+ * @param box The box.
+ * @param boxes The boxes to check.
+ * @param overlaps Whether each of the boxes overlaps with the box.
+ */
+void HasOverlaps(const Box2d &box, const Boxes2d &boxes, BoolArray *overlaps);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_GEOMETRY_BATCH_H_
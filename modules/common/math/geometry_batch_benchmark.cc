@@ -0,0 +1,183 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/common/math/geometry_batch.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+std::vector<Vec2d> RandomPoints(const int num_points) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> coordinate(-50.0, 50.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.emplace_back(coordinate(engine), coordinate(engine));
+  }
+  return points;
+}
+
+std::vector<Box2d> RandomBoxes(const int num_boxes) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 10.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num_boxes; ++i) {
+    boxes.emplace_back(Vec2d(position(engine), position(engine)),
+                       heading(engine), size(engine), size(engine));
+  }
+  return boxes;
+}
+
+// A polyline of 20 segments across the points, like a lane.
+std::vector<LineSegment2d> Polyline() {
+  std::vector<LineSegment2d> polyline;
+  for (int i = 0; i < 20; ++i) {
+    const double x = -50.0 + 5.0 * i;
+    polyline.emplace_back(Vec2d(x, std::sin(i * 0.3) * 10.0),
+                          Vec2d(x + 5.0, std::sin(i * 0.3 + 0.3) * 10.0));
+  }
+  return polyline;
+}
+
+const Polygon2d &TestPolygon() {
+  static const Polygon2d polygon(
+      {{-30.0, -20.0}, {10.0, -35.0}, {40.0, -5.0}, {35.0, 30.0},
+       {0.0, 40.0}, {-25.0, 25.0}, {-40.0, 5.0}, {-35.0, -10.0}});
+  return polygon;
+}
+
+void BM_DistanceToPolyline(benchmark::State &state) {
+  const auto points = RandomPoints(state.range(0));
+  const auto polyline = Polyline();
+  std::vector<double> distances(points.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      double distance = std::numeric_limits<double>::infinity();
+      for (const auto &segment : polyline) {
+        distance = std::min(distance, segment.DistanceTo(points[i]));
+      }
+      distances[i] = distance;
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_DistanceToPolyline)->Arg(256)->Arg(4096);
+
+void BM_BatchDistanceToPolyline(benchmark::State &state) {
+  const Points2d points(RandomPoints(state.range(0)));
+  const auto polyline = Polyline();
+  Eigen::ArrayXd distances;
+  while (state.KeepRunning()) {
+    DistancesTo(polyline, points, &distances);
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_BatchDistanceToPolyline)->Arg(256)->Arg(4096);
+
+void BM_BoxIsPointIn(benchmark::State &state) {
+  const auto points = RandomPoints(state.range(0));
+  const Box2d box({3.0, -2.0}, 0.7, 30.0, 20.0);
+  std::vector<char> in(points.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      in[i] = box.IsPointIn(points[i]);
+    }
+    benchmark::DoNotOptimize(in.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_BoxIsPointIn)->Arg(256)->Arg(4096);
+
+void BM_BatchBoxIsPointIn(benchmark::State &state) {
+  const Points2d points(RandomPoints(state.range(0)));
+  const Box2d box({3.0, -2.0}, 0.7, 30.0, 20.0);
+  BoolArray in;
+  while (state.KeepRunning()) {
+    ArePointsIn(box, points, &in);
+    benchmark::DoNotOptimize(in.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_BatchBoxIsPointIn)->Arg(256)->Arg(4096);
+
+void BM_PolygonIsPointIn(benchmark::State &state) {
+  const auto points = RandomPoints(state.range(0));
+  std::vector<char> in(points.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      in[i] = TestPolygon().IsPointIn(points[i]);
+    }
+    benchmark::DoNotOptimize(in.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PolygonIsPointIn)->Arg(256)->Arg(4096);
+
+void BM_BatchPolygonIsPointIn(benchmark::State &state) {
+  const Points2d points(RandomPoints(state.range(0)));
+  BoolArray in;
+  while (state.KeepRunning()) {
+    ArePointsIn(TestPolygon(), points, &in);
+    benchmark::DoNotOptimize(in.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_BatchPolygonIsPointIn)->Arg(256)->Arg(4096);
+
+void BM_BoxHasOverlap(benchmark::State &state) {
+  const auto boxes = RandomBoxes(state.range(0));
+  const Box2d box({3.0, -2.0}, 0.7, 30.0, 20.0);
+  std::vector<char> overlaps(boxes.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      overlaps[i] = box.HasOverlap(boxes[i]);
+    }
+    benchmark::DoNotOptimize(overlaps.data());
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_BoxHasOverlap)->Arg(256)->Arg(4096);
+
+void BM_BatchBoxHasOverlap(benchmark::State &state) {
+  const Boxes2d boxes(RandomBoxes(state.range(0)));
+  const Box2d box({3.0, -2.0}, 0.7, 30.0, 20.0);
+  BoolArray overlaps;
+  while (state.KeepRunning()) {
+    HasOverlaps(box, boxes, &overlaps);
+    benchmark::DoNotOptimize(overlaps.data());
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_BatchBoxHasOverlap)->Arg(256)->Arg(4096);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
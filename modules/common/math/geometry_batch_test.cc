@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/geometry_batch.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// Random points in [-10, 10] x [-10, 10], with coordinates rounded to 0.5 for
+// some of them so that points on boundaries and corners are covered.
+Points2d RandomPoints(const int num_points) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    double x = coordinate(engine);
+    double y = coordinate(engine);
+    if (i % 3 == 0) {
+      x = std::round(x * 2.0) / 2.0;
+      y = std::round(y * 2.0) / 2.0;
+    }
+    points.emplace_back(x, y);
+  }
+  return Points2d(points);
+}
+
+std::vector<LineSegment2d> TestSegments() {
+  return {LineSegment2d({-3.0, -2.0}, {4.0, 5.0}),
+          LineSegment2d({1.0, 1.0}, {1.0, 1.0}),
+          LineSegment2d({-5.0, 2.0}, {5.0, 2.0}),
+          LineSegment2d({0.5, -6.0}, {0.5, 6.0})};
+}
+
+std::vector<Box2d> TestBoxes() {
+  return {Box2d({0.0, 0.0}, 0.0, 4.0, 2.0),
+          Box2d({1.5, -2.0}, M_PI / 4.0, 6.0, 3.0),
+          Box2d({-3.0, 4.0}, -1.2, 2.0, 5.0),
+          Box2d({2.0, 2.0}, M_PI / 2.0, 1.0, 1.0)};
+}
+
+// Distances computed with sqrt instead of hypot may differ in the last bits.
+void ExpectDistancesNear(const double expected, const double actual) {
+  EXPECT_NEAR(expected, actual, 1e-12 * std::max(1.0, expected));
+}
+
+}  // namespace
+
+TEST(GeometryBatchTest, DistancesToLineSegment) {
+  const Points2d points = RandomPoints(1000);
+  Eigen::ArrayXd distances;
+  for (const auto &segment : TestSegments()) {
+    DistancesTo(segment, points, &distances);
+    ASSERT_EQ(points.size(), distances.size());
+    for (int i = 0; i < points.size(); ++i) {
+      ExpectDistancesNear(segment.DistanceTo(points.point(i)), distances[i]);
+    }
+  }
+}
+
+TEST(GeometryBatchTest, DistancesToPolyline) {
+  const Points2d points = RandomPoints(1000);
+  const std::vector<LineSegment2d> polyline = {
+      LineSegment2d({-8.0, -1.0}, {-2.0, 3.0}),
+      LineSegment2d({-2.0, 3.0}, {2.0, 2.5}),
+      LineSegment2d({2.0, 2.5}, {7.0, -4.0})};
+  Eigen::ArrayXd distances;
+  DistancesTo(polyline, points, &distances);
+  for (int i = 0; i < points.size(); ++i) {
+    double expected = std::numeric_limits<double>::infinity();
+    for (const auto &segment : polyline) {
+      expected = std::min(expected, segment.DistanceTo(points.point(i)));
+    }
+    ExpectDistancesNear(expected, distances[i]);
+  }
+}
+
+TEST(GeometryBatchTest, AABox) {
+  const Points2d points = RandomPoints(1000);
+  const AABox2d box({1.0, -0.5}, 6.0, 3.0);
+  Eigen::ArrayXd distances;
+  BoolArray in;
+  DistancesTo(box, points, &distances);
+  ArePointsIn(box, points, &in);
+  for (int i = 0; i < points.size(); ++i) {
+    ExpectDistancesNear(box.DistanceTo(points.point(i)), distances[i]);
+    EXPECT_EQ(box.IsPointIn(points.point(i)), in[i]);
+  }
+  EXPECT_GT(in.count(), 0);
+}
+
+TEST(GeometryBatchTest, Box) {
+  const Points2d points = RandomPoints(1000);
+  Eigen::ArrayXd distances;
+  BoolArray in;
+  for (const auto &box : TestBoxes()) {
+    DistancesTo(box, points, &distances);
+    ArePointsIn(box, points, &in);
+    for (int i = 0; i < points.size(); ++i) {
+      ExpectDistancesNear(box.DistanceTo(points.point(i)), distances[i]);
+      EXPECT_EQ(box.IsPointIn(points.point(i)), in[i]);
+    }
+    EXPECT_GT(in.count(), 0);
+  }
+}
+
+TEST(GeometryBatchTest, ArePointsInPolygon) {
+  const Points2d points = RandomPoints(1000);
+  const std::vector<Polygon2d> polygons = {
+      Polygon2d(TestBoxes()[1]),
+      Polygon2d({{-5.0, -5.0}, {5.0, -5.0}, {0.0, 0.0}, {5.0, 5.0},
+                 {-5.0, 5.0}}),
+      Polygon2d({{0.0, 0.0}, {3.5, 0.5}, {7.0, 2.0}, {2.0, 6.0}})};
+  BoolArray in;
+  for (const auto &polygon : polygons) {
+    ArePointsIn(polygon, points, &in);
+    for (int i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(polygon.IsPointIn(points.point(i)), in[i]);
+    }
+    EXPECT_GT(in.count(), 0);
+  }
+  // Vertices and edges.
+  const Points2d boundary({{-5.0, -5.0}, {0.0, 0.0}, {2.5, 2.5}, {0.0, 5.0}});
+  ArePointsIn(polygons[1], boundary, &in);
+  EXPECT_TRUE(in.all());
+}
+
+TEST(GeometryBatchTest, HasOverlaps) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < 1000; ++i) {
+    boxes.emplace_back(Vec2d(position(engine), position(engine)),
+                       heading(engine), size(engine), size(engine));
+  }
+  // Touching the first test box.
+  boxes.emplace_back(Vec2d(4.0, 0.0), 0.0, 4.0, 2.0);
+  boxes.emplace_back(Vec2d(0.0, 2.0), M_PI, 4.0, 2.0);
+  const Boxes2d batch(boxes);
+  ASSERT_EQ(boxes.size(), batch.size());
+
+  BoolArray overlaps;
+  for (const auto &box : TestBoxes()) {
+    HasOverlaps(box, batch, &overlaps);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      EXPECT_EQ(box.HasOverlap(boxes[i]), overlaps[i]);
+    }
+    EXPECT_GT(overlaps.count(), 0);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -242,6 +242,15 @@ class KalmanFilter {
   // Kalman gain; marked as member to prevent memory re-allocation.
   Eigen::Matrix<T, XN, ZN> K_;
 
+  // Transposed Kalman gain; marked as member to prevent memory re-allocation.
+  Eigen::Matrix<T, ZN, XN> KT_;
+
+  // P * H^T; marked as member to prevent memory re-allocation.
+  Eigen::Matrix<T, XN, ZN> PHt_;
+
+  // (I - K * H) * P; marked as member to prevent memory re-allocation.
+  Eigen::Matrix<T, XN, XN> IKHP_;
+
   // true iff SetStateEstimate has been called.
   bool is_initialized_ = false;
 };
@@ -262,13 +271,29 @@ inline void KalmanFilter<T, XN, ZN, UN>::Correct(
   CHECK(is_initialized_);
   y_ = z - H_ * x_;
 
-  S_ = H_ * P_ * H_.transpose() + R_;
+  PHt_ = P_ * H_.transpose();
 
-  K_ = P_ * H_.transpose() * PseudoInverse<T, ZN>(S_);
+  S_ = H_ * PHt_ + R_;
+
+  // K = P * H^T * S^-1. S is symmetric, and positive definite unless the
+  // observation noise is degenerate, so solve S * K^T = (P * H^T)^T with its
+  // Cholesky factor.
+  KT_ = PHt_.transpose();
+  if (CholeskySolve<T, ZN, XN>(S_, &KT_)) {
+    K_ = KT_.transpose();
+  } else {
+    K_ = PHt_ * PseudoInverse<T, ZN>(S_);
+  }
 
   x_ = x_ + K_ * y_;
 
-  P_ = (Eigen::Matrix<T, XN, XN>::Identity() - K_ * H_) * P_;
+  // Joseph form (I - K * H) * P * (I - K * H)^T + K * R * K^T, which keeps P
+  // symmetric and positive semi-definite despite rounding errors. It is
+  // evaluated as A - A * H^T * K^T + K * R * K^T with A = (I - K * H) * P,
+  // which is P - K * (P * H^T)^T as P is symmetric.
+  IKHP_.noalias() = P_ - K_ * PHt_.transpose();
+  P_.noalias() = IKHP_ - (IKHP_ * H_.transpose()) * K_.transpose();
+  P_.noalias() += K_ * R_ * K_.transpose();
 }
 
 template <typename T, unsigned int XN, unsigned int ZN, unsigned int UN>
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/common/math/kalman_filter.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Constant acceleration in 2D with observed positions.
+Eigen::Matrix<double, 6, 6> TransitionMatrix() {
+  const double dt = 0.1;
+  Eigen::Matrix<double, 6, 6> F;
+  F.setIdentity();
+  F(0, 2) = dt;
+  F(0, 4) = 0.5 * dt * dt;
+  F(1, 3) = dt;
+  F(1, 5) = 0.5 * dt * dt;
+  F(2, 4) = dt;
+  F(3, 5) = dt;
+  return F;
+}
+
+Eigen::Matrix<double, 2, 6> ObservationMatrix() {
+  Eigen::Matrix<double, 2, 6> H;
+  H.setZero();
+  H(0, 0) = 1.0;
+  H(1, 1) = 1.0;
+  return H;
+}
+
+Eigen::Matrix<double, Eigen::Dynamic, 2> Observations(const int size) {
+  Eigen::Matrix<double, Eigen::Dynamic, 2> z(size, 2);
+  for (int i = 0; i < size; ++i) {
+    z(i, 0) = 0.1 * i;
+    z(i, 1) = -0.2 * i;
+  }
+  return z;
+}
+
+// Predicts and corrects range(0) filters.
+void BM_KalmanFilter(benchmark::State &state) {
+  const int size = state.range(0);
+  using Filter = KalmanFilter<double, 6, 2, 0>;
+  std::vector<Filter, Eigen::aligned_allocator<Filter>> filters(
+      size, Filter(Eigen::Matrix<double, 6, 1>::Zero(),
+                   Eigen::Matrix<double, 6, 6>::Identity()));
+  for (auto &filter : filters) {
+    filter.SetTransitionMatrix(TransitionMatrix());
+    filter.SetTransitionNoise(Eigen::Matrix<double, 6, 6>::Identity() * 0.01);
+    filter.SetObservationMatrix(ObservationMatrix());
+    filter.SetObservationNoise(Eigen::Matrix2d::Identity() * 0.5);
+  }
+  const auto z = Observations(size);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < size; ++i) {
+      filters[i].Predict();
+      filters[i].Correct(z.row(i).transpose());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_KalmanFilter)->Arg(16)->Arg(256)->Arg(4096);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
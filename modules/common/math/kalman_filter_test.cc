@@ -16,8 +16,11 @@
 
 #include "modules/common/math/kalman_filter.h"
 
+#include "Eigen/Dense"
 #include "gtest/gtest.h"
 
+#include "modules/common/math/matrix_operations.h"
+
 namespace apollo {
 namespace common {
 namespace math {
@@ -98,6 +101,108 @@ TEST(KalmanFilterTest, SyntheticTracking) {
   EXPECT_NEAR(0.11111, P_correct(1, 1), 0.001);
 }
 
+TEST(KalmanFilterTest, CholeskySolve) {
+  Eigen::Matrix3d m;
+  m << 4.0, 2.0, 0.6, 2.0, 5.0, 1.0, 0.6, 1.0, 3.0;
+  Eigen::Matrix<double, 3, 2> b;
+  b << 1.0, -2.0, 0.5, 3.0, -1.0, 0.25;
+  Eigen::Matrix<double, 3, 2> x = b;
+  ASSERT_TRUE((CholeskySolve<double, 3, 2>(m, &x)));
+  EXPECT_TRUE((m * x).isApprox(b, 1e-12));
+
+  // Only the lower triangle is used.
+  Eigen::Matrix3d lower = m;
+  lower(0, 1) = 100.0;
+  lower(0, 2) = -100.0;
+  lower(1, 2) = 100.0;
+  Eigen::Matrix<double, 3, 2> x_lower = b;
+  ASSERT_TRUE((CholeskySolve<double, 3, 2>(lower, &x_lower)));
+  EXPECT_TRUE(x_lower.isApprox(x, 1e-12));
+
+  // Not positive definite.
+  Eigen::Matrix2d indefinite;
+  indefinite << 1.0, 2.0, 2.0, 1.0;
+  Eigen::Vector2d y(1.0, 1.0);
+  EXPECT_FALSE((CholeskySolve<double, 2, 1>(indefinite, &y)));
+  Eigen::Matrix2d singular = Eigen::Matrix2d::Zero();
+  EXPECT_FALSE((CholeskySolve<double, 2, 1>(singular, &y)));
+}
+
+TEST(KalmanFilterTest, JosephFormCorrect) {
+  // Constant acceleration in 2D, with position observations.
+  const double dt = 0.1;
+  Eigen::Matrix<double, 6, 6> F = Eigen::Matrix<double, 6, 6>::Identity();
+  for (int i = 0; i < 2; ++i) {
+    F(i, i + 2) = dt;
+    F(i, i + 4) = 0.5 * dt * dt;
+    F(i + 2, i + 4) = dt;
+  }
+  Eigen::Matrix<double, 6, 6> Q = Eigen::Matrix<double, 6, 6>::Identity();
+  Q *= 0.01;
+  Eigen::Matrix<double, 2, 6> H = Eigen::Matrix<double, 2, 6>::Zero();
+  H(0, 0) = 1.0;
+  H(1, 1) = 1.0;
+  Eigen::Matrix2d R;
+  R << 0.5, 0.1, 0.1, 0.3;
+
+  Eigen::Matrix<double, 6, 1> x;
+  x << 1.0, 2.0, 3.0, -1.0, 0.5, 0.2;
+  Eigen::Matrix<double, 6, 6> A;
+  A << 1.0, 0.2, 0.0, 0.1, 0.0, 0.0, 0.0, 1.5, 0.3, 0.0, 0.1, 0.0, 0.0, 0.0,
+      2.0, 0.2, 0.0, 0.1, 0.1, 0.0, 0.0, 1.0, 0.3, 0.0, 0.0, 0.2, 0.0, 0.0,
+      0.5, 0.1, 0.0, 0.0, 0.1, 0.0, 0.0, 0.7;
+  const Eigen::Matrix<double, 6, 6> P = A * A.transpose();
+
+  KalmanFilter<double, 6, 2, 0> kf(x, P);
+  kf.SetTransitionMatrix(F);
+  kf.SetTransitionNoise(Q);
+  kf.SetObservationMatrix(H);
+  kf.SetObservationNoise(R);
+  const Eigen::Vector2d z(1.3, 1.8);
+  kf.Correct(z);
+
+  // The textbook gain with an inverse and the Joseph form.
+  const Eigen::Matrix2d S = H * P * H.transpose() + R;
+  const Eigen::Matrix<double, 6, 2> K = P * H.transpose() * S.inverse();
+  const Eigen::Matrix<double, 6, 6> IKH =
+      Eigen::Matrix<double, 6, 6>::Identity() - K * H;
+  const Eigen::Matrix<double, 6, 1> expected_x = x + K * (z - H * x);
+  const Eigen::Matrix<double, 6, 6> expected_P =
+      IKH * P * IKH.transpose() + K * R * K.transpose();
+  EXPECT_TRUE(kf.GetStateEstimate().isApprox(expected_x, 1e-12));
+  EXPECT_TRUE(kf.GetStateCovariance().isApprox(expected_P, 1e-12));
+
+  // The covariance stays symmetric and positive definite over many updates
+  // with precise observations.
+  R *= 1e-8;
+  kf.SetObservationNoise(R);
+  for (int i = 0; i < 1000; ++i) {
+    kf.Predict();
+    kf.Correct(z);
+  }
+  const Eigen::Matrix<double, 6, 6> P_final = kf.GetStateCovariance();
+  EXPECT_TRUE(P_final.isApprox(P_final.transpose(), 1e-9));
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, 6, 6>> eigen_solver(
+      P_final);
+  EXPECT_GT(eigen_solver.eigenvalues().minCoeff(), 0.0);
+}
+
+TEST(KalmanFilterTest, CorrectWithSingularInnovation) {
+  // Without uncertainty, S is zero and the pseudo-inverse is used instead of
+  // the Cholesky factor.
+  Eigen::Vector2d x(1.0, 2.0);
+  KalmanFilter<double, 2, 1, 0> kf(x, Eigen::Matrix2d::Zero());
+  Eigen::Matrix<double, 1, 2> H;
+  H << 1.0, 0.0;
+  kf.SetObservationMatrix(H);
+  kf.SetObservationNoise(Eigen::Matrix<double, 1, 1>::Zero());
+  Eigen::Matrix<double, 1, 1> z;
+  z(0, 0) = 5.0;
+  kf.Correct(z);
+  EXPECT_TRUE(kf.GetStateEstimate().isApprox(x));
+  EXPECT_TRUE(kf.GetStateCovariance().isZero());
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #ifndef MODULES_COMMON_MATH_MATRIX_OPERATIONS_H_
 #define MODULES_COMMON_MATH_MATRIX_OPERATIONS_H_
 
+#include <cmath>
 #include <utility>
 #include "Eigen/Dense"
 #include "Eigen/SVD"
@@ -72,6 +73,61 @@ Eigen::Matrix<T, N, M> PseudoInverse(const Eigen::Matrix<T, M, N>& m,
     return m.transpose() * PseudoInverse<T, M>(t);
 }
 
+/**
+ * @brief Solves m * x = b for a small symmetric positive definite matrix m
+ * with its Cholesky decomposition. Only the lower triangle of m is used. The
+ * loops have fixed bounds, so the compiler unrolls them, which is much faster
+ * than Eigen::LLT at these sizes.
+ *
+ * @param m The symmetric positive definite matrix
+ * @param b The right hand side, which is replaced by the solution x
+ *
+ * @return False if m is not positive definite, in which case b is undefined.
+ */
+template <typename T, unsigned int N, unsigned int M>
+bool CholeskySolve(const Eigen::Matrix<T, N, N>& m,
+                   Eigen::Matrix<T, N, M>* b) {
+  constexpr int n = static_cast<int>(N);
+  constexpr int cols = static_cast<int>(M);
+  // Lower triangular factor l with m = l * l^T.
+  Eigen::Matrix<T, N, N> l;
+  for (int j = 0; j < n; ++j) {
+    T d = m(j, j);
+    for (int k = 0; k < j; ++k) {
+      d -= l(j, k) * l(j, k);
+    }
+    if (!(d > 0)) {
+      return false;
+    }
+    l(j, j) = std::sqrt(d);
+    for (int i = j + 1; i < n; ++i) {
+      T v = m(i, j);
+      for (int k = 0; k < j; ++k) {
+        v -= l(i, k) * l(j, k);
+      }
+      l(i, j) = v / l(j, j);
+    }
+  }
+  // Forward substitution with l, then backward substitution with l^T.
+  for (int c = 0; c < cols; ++c) {
+    for (int i = 0; i < n; ++i) {
+      T v = (*b)(i, c);
+      for (int k = 0; k < i; ++k) {
+        v -= l(i, k) * (*b)(k, c);
+      }
+      (*b)(i, c) = v / l(i, i);
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      T v = (*b)(i, c);
+      for (int k = i + 1; k < n; ++k) {
+        v -= l(k, i) * (*b)(k, c);
+      }
+      (*b)(i, c) = v / l(i, i);
+    }
+  }
+  return true;
+}
+
 /**
  * @brief Implements Tustin's method for converting transfer functions from
  * continuous to discrete time domains.
@@ -28,6 +28,72 @@
 namespace apollo {
 namespace common {
 namespace math {
+namespace {
+
+// Index of the lowest point, the leftmost one on ties, or with sign -1 of the
+// highest point, the rightmost one on ties. Going counter-clockwise from there,
+// the edge headings increase from 0 or from pi respectively.
+int LowestPoint(const std::vector<Vec2d> &points, const double sign) {
+  int lowest = 0;
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double dx = sign * (points[i].x() - points[lowest].x());
+    const double dy = sign * (points[i].y() - points[lowest].y());
+    if (dy < 0.0 || (dy == 0.0 && dx < 0.0)) {
+      lowest = i;
+    }
+  }
+  return lowest;
+}
+
+// Distance between two convex polygons in O(n + m).
+//
+// It walks the edges of the Minkowski difference p1 - p2 in heading order.
+// Each of them is an edge of p1 against a vertex of p2 or the other way
+// round, and its distance to the origin is the distance between that edge
+// and vertex. The polygons overlap if the origin is inside the difference,
+// otherwise the distance is the smallest of these edge to vertex distances.
+// The general version takes the minimum over all edge and vertex pairs, which
+// gives the same result.
+double ConvexPolygonDistance(const Polygon2d &p1, const Polygon2d &p2) {
+  const auto &points1 = p1.points();
+  const auto &points2 = p2.points();
+  const auto &segments1 = p1.line_segments();
+  const auto &segments2 = p2.line_segments();
+  const int n1 = p1.num_points();
+  const int n2 = p2.num_points();
+  int i1 = LowestPoint(points1, 1.0);
+  int i2 = LowestPoint(points2, -1.0);
+  bool inside = true;
+  double distance = std::numeric_limits<double>::infinity();
+  for (int k1 = 0, k2 = 0; k1 < n1 || k2 < n2;) {
+    const int next1 = i1 + 1 == n1 ? 0 : i1 + 1;
+    const int next2 = i2 + 1 == n2 ? 0 : i2 + 1;
+    // The edges of -p2 are the reversed edges of p2.
+    const bool take1 =
+        k2 == n2 ||
+        (k1 < n1 && (points1[next1] - points1[i1])
+                            .CrossProd(points2[i2] - points2[next2]) >= 0.0);
+    // Only the edges the origin is outside of can be the closest ones.
+    if (take1) {
+      if (CrossProd(points1[i1], points1[next1], points2[i2]) < 0.0) {
+        inside = false;
+        distance = std::min(distance, segments1[i1].DistanceTo(points2[i2]));
+      }
+      i1 = next1;
+      ++k1;
+    } else {
+      if (CrossProd(points2[i2], points2[next2], points1[i1]) < 0.0) {
+        inside = false;
+        distance = std::min(distance, segments2[i2].DistanceTo(points1[i1]));
+      }
+      i2 = next2;
+      ++k2;
+    }
+  }
+  return inside ? 0.0 : distance;
+}
+
+}  // namespace
 
 Polygon2d::Polygon2d(const Box2d &box) {
   box.GetAllCorners(&points_);
@@ -95,6 +161,10 @@ double Polygon2d::DistanceTo(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
   CHECK_GE(polygon.num_points(), 3);
 
+  if (is_convex_ && polygon.is_convex()) {
+    return ConvexPolygonDistance(*this, polygon);
+  }
+
   if (IsPointIn(polygon.points()[0])) {
     return 0.0;
   }
@@ -302,14 +372,20 @@ bool Polygon2d::ClipConvexHull(const LineSegment2d &line_segment,
   }
   std::vector<double> prod(n);
   std::vector<int> side(n);
+  bool clipped = false;
   for (int i = 0; i < n; ++i) {
     prod[i] = CrossProd(line_segment.start(), line_segment.end(), (*points)[i]);
     if (std::abs(prod[i]) <= kMathEpsilon) {
       side[i] = 0;
     } else {
       side[i] = ((prod[i] < 0) ? -1 : 1);
+      clipped = clipped || side[i] < 0;
     }
   }
+  if (!clipped) {
+    // All points are kept as they are.
+    return true;
+  }
 
   std::vector<Vec2d> new_points;
   for (int i = 0; i < n; ++i) {
@@ -334,6 +410,10 @@ bool Polygon2d::ComputeOverlap(const Polygon2d &other_polygon,
   CHECK_GE(points_.size(), 3);
   CHECK_NOTNULL(overlap_polygon);
   CHECK(is_convex_ && other_polygon.is_convex());
+  if (other_polygon.max_x() < min_x_ || other_polygon.min_x() > max_x_ ||
+      other_polygon.max_y() < min_y_ || other_polygon.min_y() > max_y_) {
+    return false;
+  }
   std::vector<Vec2d> points = other_polygon.points();
   for (int i = 0; i < num_points_; ++i) {
     if (!ClipConvexHull(line_segments_[i], &points)) {
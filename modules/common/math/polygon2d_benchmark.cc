@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// A regular polygon with the given number of points.
+Polygon2d RegularPolygon(const Vec2d &center, const double radius,
+                         const int num_points) {
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.push_back(center + Vec2d::CreateUnitVec2d(2.0 * M_PI * i /
+                                                     num_points) *
+                                  radius);
+  }
+  return Polygon2d(points);
+}
+
+// Polygons of range(0) points whose centers are range(1) / 10 radii apart.
+void PolygonPair(const benchmark::State &state, Polygon2d *poly1,
+                 Polygon2d *poly2) {
+  const double distance = state.range(1) / 10.0;
+  *poly1 = RegularPolygon({0.0, 0.0}, 1.0, state.range(0));
+  *poly2 = RegularPolygon({distance, 0.3 * distance}, 1.0, state.range(0));
+}
+
+void BM_HasOverlap(benchmark::State &state) {
+  Polygon2d poly1;
+  Polygon2d poly2;
+  PolygonPair(state, &poly1, &poly2);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(poly1.HasOverlap(poly2));
+  }
+}
+
+void BM_DistanceTo(benchmark::State &state) {
+  Polygon2d poly1;
+  Polygon2d poly2;
+  PolygonPair(state, &poly1, &poly2);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(poly1.DistanceTo(poly2));
+  }
+}
+
+void BM_ComputeOverlap(benchmark::State &state) {
+  Polygon2d poly1;
+  Polygon2d poly2;
+  PolygonPair(state, &poly1, &poly2);
+  Polygon2d overlap;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(poly1.ComputeOverlap(poly2, &overlap));
+  }
+}
+
+// Overlapping (5), nearly touching (19) and separate (30) polygons.
+void PolygonPairArgs(benchmark::internal::Benchmark *benchmark) {
+  for (const int num_points : {4, 16, 64, 256}) {
+    for (const int distance : {5, 19, 30}) {
+      benchmark->Args({num_points, distance});
+    }
+  }
+}
+
+BENCHMARK(BM_HasOverlap)->Apply(PolygonPairArgs);
+BENCHMARK(BM_DistanceTo)->Apply(PolygonPairArgs);
+BENCHMARK(BM_ComputeOverlap)->Apply(PolygonPairArgs);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -16,6 +16,8 @@
 
 #include "modules/common/math/polygon2d.h"
 
+#include <algorithm>
+#include <random>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -49,6 +51,38 @@ bool ProjectByXSlow(const std::vector<Vec2d> &points, double x,
   return *min_y <= *max_y;
 }
 
+double DistanceSlow(const Polygon2d &poly1, const Polygon2d &poly2) {
+  if (poly1.IsPointIn(poly2.points()[0]) ||
+      poly2.IsPointIn(poly1.points()[0])) {
+    return 0.0;
+  }
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto &seg1 : poly1.line_segments()) {
+    for (const auto &seg2 : poly2.line_segments()) {
+      if (seg1.HasIntersect(seg2)) {
+        return 0.0;
+      }
+      distance = std::min(distance, seg1.DistanceTo(seg2.start()));
+      distance = std::min(distance, seg2.DistanceTo(seg1.start()));
+    }
+  }
+  return distance;
+}
+
+Polygon2d RandomConvexPolygon(const Vec2d &center, const double radius,
+                              const int num_points, std::mt19937 *random) {
+  std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+  std::uniform_real_distribution<double> scale(0.5, 1.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.push_back(center + Vec2d::CreateUnitVec2d(angle(*random)) *
+                                  radius * scale(*random));
+  }
+  Polygon2d polygon;
+  EXPECT_TRUE(Polygon2d::ComputeConvexHull(points, &polygon));
+  return polygon;
+}
+
 }  // namespace
 
 TEST(Polygon2dTest, polygon_IsPointIn) {
@@ -259,6 +293,38 @@ TEST(Polygon2dTest, DistanceToPolygon) {
   EXPECT_NEAR(poly4.DistanceTo(poly3), 0.0, 1e-5);
 }
 
+TEST(Polygon2dTest, DistanceToConvexPolygon) {
+  std::mt19937 random(17);
+  std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+  std::uniform_int_distribution<int> num_points(3, 30);
+  for (int i = 0; i < 2000; ++i) {
+    const Polygon2d poly1 = RandomConvexPolygon(
+        {coordinate(random), coordinate(random)}, 5.0, num_points(random),
+        &random);
+    const Polygon2d poly2 = RandomConvexPolygon(
+        {coordinate(random), coordinate(random)}, 5.0, num_points(random),
+        &random);
+    const double expected = DistanceSlow(poly1, poly2);
+    EXPECT_NEAR(expected, poly1.DistanceTo(poly2), 1e-9);
+    EXPECT_NEAR(expected, poly2.DistanceTo(poly1), 1e-9);
+    EXPECT_EQ(expected <= kMathEpsilon, poly1.HasOverlap(poly2));
+  }
+
+  // Touching edges and corners, and parallel edges.
+  const Polygon2d box1(Box2d::CreateAABox({0, 0}, {1, 1}));
+  const Polygon2d box2(Box2d::CreateAABox({1, 0}, {2, 1}));
+  const Polygon2d box3(Box2d::CreateAABox({1, 1}, {2, 2}));
+  const Polygon2d box4(Box2d::CreateAABox({0, 2}, {1, 3}));
+  const Polygon2d diamond({{3, 1}, {4, 2}, {3, 3}, {2, 2}});
+  EXPECT_NEAR(0.0, box1.DistanceTo(box2), 1e-9);
+  EXPECT_NEAR(0.0, box1.DistanceTo(box3), 1e-9);
+  EXPECT_NEAR(1.0, box1.DistanceTo(box4), 1e-9);
+  EXPECT_NEAR(0.0, box3.DistanceTo(diamond), 1e-9);
+  EXPECT_NEAR(std::sqrt(0.5), box2.DistanceTo(diamond), 1e-9);
+  EXPECT_TRUE(box1.HasOverlap(box3));
+  EXPECT_FALSE(box1.HasOverlap(box4));
+}
+
 TEST(Polygon2dTest, ContainPolygon) {
   const Polygon2d poly1(Box2d::CreateAABox({0, 0}, {3, 3}));
   const Polygon2d poly2(Box2d::CreateAABox({1, 1}, {2, 2}));
@@ -16,6 +16,17 @@
 
 #include "modules/common/util/json_util.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "google/protobuf/stubs/strutil.h"
 #include "google/protobuf/util/json_util.h"
 #include "modules/common/log.h"
 
@@ -25,6 +36,10 @@ namespace util {
 namespace {
 
 using Json = nlohmann::json;
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
 using google::protobuf::util::MessageToJsonString;
 
 google::protobuf::util::JsonOptions JsonOption() {
@@ -33,6 +48,328 @@ google::protobuf::util::JsonOptions JsonOption() {
   return json_option;
 }
 
+// Fields of a message sorted by json name, which is the order nlohmann::json
+// dumps object keys in.
+const std::vector<const FieldDescriptor *> &SortedFields(
+    const Descriptor *descriptor) {
+  static std::mutex mutex;
+  static auto *cache = new std::unordered_map<
+      const Descriptor *, std::vector<const FieldDescriptor *>>();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto iter = cache->find(descriptor);
+  if (iter == cache->end()) {
+    std::vector<const FieldDescriptor *> fields;
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      fields.push_back(descriptor->field(i));
+    }
+    std::sort(fields.begin(), fields.end(),
+              [](const FieldDescriptor *a, const FieldDescriptor *b) {
+                return a->json_name() < b->json_name();
+              });
+    iter = cache->emplace(descriptor, std::move(fields)).first;
+  }
+  return iter->second;
+}
+
+/**
+ * Writes a proto as MessageToJsonString() with always_print_primitive_fields
+ * does, after nlohmann::json parses and dumps it again: object keys are sorted,
+ * numbers are reformatted and strings are escaped the nlohmann::json way.
+ */
+class TypedJsonWriter {
+ public:
+  explicit TypedJsonWriter(std::string *json) : json_(json) {}
+
+  void WriteString(const std::string &str) {
+    static const char kHex[] = "0123456789abcdef";
+    json_->push_back('"');
+    for (const char c : str) {
+      switch (c) {
+        case '"':
+          json_->append("\\\"");
+          break;
+        case '\\':
+          json_->append("\\\\");
+          break;
+        case '\b':
+          json_->append("\\b");
+          break;
+        case '\f':
+          json_->append("\\f");
+          break;
+        case '\n':
+          json_->append("\\n");
+          break;
+        case '\r':
+          json_->append("\\r");
+          break;
+        case '\t':
+          json_->append("\\t");
+          break;
+        default:
+          if (c >= 0x00 && c <= 0x1f) {
+            json_->append("\\u00");
+            json_->push_back(kHex[c >> 4]);
+            json_->push_back(kHex[c & 0x0f]);
+          } else {
+            json_->push_back(c);
+          }
+      }
+    }
+    json_->push_back('"');
+  }
+
+  // Returns false on well-known types, which have their own json mappings.
+  bool WriteMessage(const Message &message) {
+    const Descriptor *descriptor = message.GetDescriptor();
+    if (descriptor->file()->package() == "google.protobuf") {
+      return false;
+    }
+    const Reflection *reflection = message.GetReflection();
+
+    json_->push_back('{');
+    bool first = true;
+    for (const FieldDescriptor *field : SortedFields(descriptor)) {
+      // Unset primitive fields are printed with their default values, unless
+      // they are in a oneof.
+      if (!field->is_repeated() &&
+          (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE ||
+           field->containing_oneof() != nullptr) &&
+          !reflection->HasField(message, field)) {
+        continue;
+      }
+      if (!first) {
+        json_->push_back(',');
+      }
+      first = false;
+      WriteString(field->json_name());
+      json_->push_back(':');
+
+      if (field->is_map()) {
+        if (!WriteMap(message, field)) {
+          return false;
+        }
+      } else if (field->is_repeated()) {
+        json_->push_back('[');
+        const int size = reflection->FieldSize(message, field);
+        for (int i = 0; i < size; ++i) {
+          if (i > 0) {
+            json_->push_back(',');
+          }
+          if (!WriteValue(message, field, i)) {
+            return false;
+          }
+        }
+        json_->push_back(']');
+      } else if (!WriteValue(message, field, -1)) {
+        return false;
+      }
+    }
+    json_->push_back('}');
+    return true;
+  }
+
+ private:
+  // Writes the field value, or the index-th value of a repeated field.
+  bool WriteValue(const Message &message, const FieldDescriptor *field,
+                  const int index) {
+    const Reflection *reflection = message.GetReflection();
+#define GET_VALUE(TYPE)                                                 \
+  (index < 0 ? reflection->Get##TYPE(message, field)                    \
+             : reflection->GetRepeated##TYPE(message, field, index))
+
+    switch (field->cpp_type()) {
+      case FieldDescriptor::CPPTYPE_INT32:
+        json_->append(std::to_string(GET_VALUE(Int32)));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        json_->append(std::to_string(GET_VALUE(UInt32)));
+        break;
+      // 64-bit integers are quoted.
+      case FieldDescriptor::CPPTYPE_INT64:
+        WriteString(std::to_string(GET_VALUE(Int64)));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        WriteString(std::to_string(GET_VALUE(UInt64)));
+        break;
+      case FieldDescriptor::CPPTYPE_DOUBLE: {
+        double value = GET_VALUE(Double);
+        if (IsNonFiniteDefault(message, field, index, value)) {
+          value = 0.0;
+        }
+        WriteDouble(value);
+        break;
+      }
+      case FieldDescriptor::CPPTYPE_FLOAT: {
+        float value = GET_VALUE(Float);
+        if (IsNonFiniteDefault(message, field, index, value)) {
+          value = 0.0f;
+        }
+        WriteFloatingPoint(value, google::protobuf::SimpleFtoa(value));
+        break;
+      }
+      case FieldDescriptor::CPPTYPE_BOOL:
+        json_->append(GET_VALUE(Bool) ? "true" : "false");
+        break;
+      case FieldDescriptor::CPPTYPE_ENUM: {
+        const int value = GET_VALUE(EnumValue);
+        const auto *enum_value = field->enum_type()->FindValueByNumber(value);
+        if (enum_value != nullptr) {
+          WriteString(enum_value->name());
+        } else {
+          json_->append(std::to_string(value));
+        }
+        break;
+      }
+      case FieldDescriptor::CPPTYPE_STRING: {
+        std::string scratch;
+        const std::string &value =
+            index < 0 ? reflection->GetStringReference(message, field, &scratch)
+                      : reflection->GetRepeatedStringReference(
+                            message, field, index, &scratch);
+        if (field->type() == FieldDescriptor::TYPE_BYTES) {
+          std::string base64;
+          google::protobuf::Base64Escape(value, &base64);
+          WriteString(base64);
+        } else {
+          WriteString(value);
+        }
+        break;
+      }
+      case FieldDescriptor::CPPTYPE_MESSAGE:
+        return WriteMessage(GET_VALUE(Message));
+    }
+#undef GET_VALUE
+    return true;
+  }
+
+  // Protobuf prints unset fields with a nan or inf default, such as the
+  // coordinates of PointENU, as 0.
+  static bool IsNonFiniteDefault(const Message &message,
+                                 const FieldDescriptor *field, const int index,
+                                 const double value) {
+    return index < 0 && !std::isfinite(value) &&
+           !message.GetReflection()->HasField(message, field);
+  }
+
+  // Map entries become object keys, which are sorted and unique.
+  bool WriteMap(const Message &message, const FieldDescriptor *field) {
+    const Reflection *reflection = message.GetReflection();
+    const Descriptor *entry_descriptor = field->message_type();
+    const FieldDescriptor *key_field = entry_descriptor->FindFieldByNumber(1);
+    const FieldDescriptor *value_field = entry_descriptor->FindFieldByNumber(2);
+
+    const int size = reflection->FieldSize(message, field);
+    std::vector<std::pair<std::string, const Message *>> entries;
+    entries.reserve(size);
+    for (int i = 0; i < size; ++i) {
+      const Message &entry = reflection->GetRepeatedMessage(message, field, i);
+      entries.emplace_back(MapKey(entry, key_field), &entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const std::pair<std::string, const Message *> &a,
+                        const std::pair<std::string, const Message *> &b) {
+                       return a.first < b.first;
+                     });
+
+    json_->push_back('{');
+    bool first = true;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      // The last of duplicate keys wins.
+      if (i + 1 < entries.size() && entries[i + 1].first == entries[i].first) {
+        continue;
+      }
+      if (!first) {
+        json_->push_back(',');
+      }
+      first = false;
+      WriteString(entries[i].first);
+      json_->push_back(':');
+      if (!WriteValue(*entries[i].second, value_field, -1)) {
+        return false;
+      }
+    }
+    json_->push_back('}');
+    return true;
+  }
+
+  static std::string MapKey(const Message &entry,
+                            const FieldDescriptor *key_field) {
+    const Reflection *reflection = entry.GetReflection();
+    switch (key_field->cpp_type()) {
+      case FieldDescriptor::CPPTYPE_INT32:
+        return std::to_string(reflection->GetInt32(entry, key_field));
+      case FieldDescriptor::CPPTYPE_UINT32:
+        return std::to_string(reflection->GetUInt32(entry, key_field));
+      case FieldDescriptor::CPPTYPE_INT64:
+        return std::to_string(reflection->GetInt64(entry, key_field));
+      case FieldDescriptor::CPPTYPE_UINT64:
+        return std::to_string(reflection->GetUInt64(entry, key_field));
+      case FieldDescriptor::CPPTYPE_BOOL:
+        return reflection->GetBool(entry, key_field) ? "true" : "false";
+      default:
+        return reflection->GetString(entry, key_field);
+    }
+  }
+
+  // Protobuf prints floating point numbers in their shortest round-trip form,
+  // which nlohmann::json parses as an integer if it looks like one, and
+  // otherwise dumps with digits10 precision.
+  void WriteFloatingPoint(const double value, const std::string &text) {
+    if (std::isnan(value)) {
+      WriteString("NaN");
+      return;
+    }
+    if (std::isinf(value)) {
+      WriteString(value > 0 ? "Infinity" : "-Infinity");
+      return;
+    }
+    if (text.find_first_of(".eE") == std::string::npos) {
+      json_->append(text == "-0" ? "0" : text);
+      return;
+    }
+
+    const double parsed = std::strtod(text.c_str(), nullptr);
+    if (parsed == 0.0) {
+      json_->append(std::signbit(parsed) ? "-0.0" : "0.0");
+      return;
+    }
+    char buffer[64];
+    const int size =
+        snprintf(buffer, sizeof(buffer), "%.*g",
+                 std::numeric_limits<double>::digits10, parsed);
+    json_->append(buffer, size);
+    if (std::find_if(buffer, buffer + size, [](const char c) {
+          return c == '.' || c == 'e' || c == 'E';
+        }) == buffer + size) {
+      json_->append(".0");
+    }
+  }
+
+  // The same as WriteFloatingPoint(value, SimpleDtoa(value)). SimpleDtoa()
+  // prints 15 digits, or 17 if 15 do not round-trip. Most doubles need only
+  // 15, and then its output is already what nlohmann::json dumps.
+  void WriteDouble(const double value) {
+    if (std::isfinite(value)) {
+      char buffer[32];
+      const int size = snprintf(buffer, sizeof(buffer), "%.*g",
+                                std::numeric_limits<double>::digits10, value);
+      if (std::strtod(buffer, nullptr) == value) {
+        if (std::strcmp(buffer, "-0") == 0) {
+          json_->push_back('0');
+        } else {
+          json_->append(buffer, size);
+        }
+        return;
+      }
+    }
+    WriteFloatingPoint(value, google::protobuf::SimpleDtoa(value));
+  }
+
+  std::string *json_;
+};
+
 }  // namespace
 
 nlohmann::json JsonUtil::ProtoToTypedJson(
@@ -48,6 +385,21 @@ nlohmann::json JsonUtil::ProtoToTypedJson(
   return json_obj;
 }
 
+void JsonUtil::ProtoToTypedJsonString(const std::string &json_type,
+                                      const google::protobuf::Message &proto,
+                                      std::string *json) {
+  json->clear();
+  TypedJsonWriter writer(json);
+  json->append("{\"data\":");
+  if (!writer.WriteMessage(proto)) {
+    *json = ProtoToTypedJson(json_type, proto).dump();
+    return;
+  }
+  json->append(",\"type\":");
+  writer.WriteString(json_type);
+  json->push_back('}');
+}
+
 bool JsonUtil::GetStringFromJson(const Json &json, const std::string &key,
                                  std::string *value) {
   const auto iter = json.find(key);
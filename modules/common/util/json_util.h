@@ -36,6 +36,16 @@ class JsonUtil {
   static nlohmann::json ProtoToTypedJson(
       const std::string &json_type, const google::protobuf::Message &proto);
 
+  /**
+   * @brief Write ProtoToTypedJson(json_type, proto).dump() directly, without
+   *        building the json. The output is identical.
+   * @param json The output, which is cleared first. Reusing it across calls
+   *        avoids reallocation.
+   */
+  static void ProtoToTypedJsonString(const std::string &json_type,
+                                     const google::protobuf::Message &proto,
+                                     std::string *json);
+
   /**
    * @brief Get a string value from the given json[key].
    * @return Whether the field exists and is a valid string.
@@ -16,10 +16,16 @@
 
 #include "modules/common/util/json_util.h"
 
+#include <limits>
+#include <string>
+
 #include "google/protobuf/util/json_util.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "modules/common/proto/error_code.pb.h"
+#include "modules/common/proto/geometry.pb.h"
+#include "modules/common/proto/header.pb.h"
+#include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
 namespace common {
@@ -36,6 +42,53 @@ TEST(JsonUtilTest, ProtoToTypedJson) {
   EXPECT_EQ("MsgA", json_obj["data"]["msg"]);
 }
 
+TEST(JsonUtilTest, ProtoToTypedJsonString) {
+  std::string json;
+  auto expect_same = [&json](const google::protobuf::Message &proto) {
+    JsonUtil::ProtoToTypedJsonString("TypeA", proto, &json);
+    EXPECT_EQ(JsonUtil::ProtoToTypedJson("TypeA", proto).dump(), json);
+  };
+
+  StatusPb status;
+  expect_same(status);
+  status.set_error_code(ErrorCode::CONTROL_ERROR);
+  status.set_msg("a\"b\\c\n\t\x01/<>\xc3\xa9");
+  expect_same(status);
+
+  // Unset fields and the nan defaults of unset coordinates.
+  Header header;
+  expect_same(header);
+  header.set_timestamp_sec(1513807824.58);
+  header.set_lidar_timestamp(1513807824580000000);
+  header.set_sequence_num(7);
+  *header.mutable_status() = status;
+  expect_same(header);
+
+  PointENU point;
+  expect_same(point);
+  point.set_x(-0.0);
+  point.set_y(std::numeric_limits<double>::quiet_NaN());
+  point.set_z(-std::numeric_limits<double>::infinity());
+  expect_same(point);
+
+  Path path;
+  expect_same(path);
+  path.set_name("path");
+  for (const double value : {0.0, 1.0, -3.0, 0.1, 1.0 / 3.0, 1e-7, 123456.789,
+                             1e21, -2.5e-300, 4.9e-324}) {
+    auto *path_point = path.add_path_point();
+    path_point->set_x(value);
+    path_point->set_kappa(value * 7.0);
+    path_point->set_lane_id("lane");
+  }
+  expect_same(path);
+
+  // The output buffer is reused.
+  json = "garbage";
+  JsonUtil::ProtoToTypedJsonString("TypeA", point, &json);
+  EXPECT_EQ(JsonUtil::ProtoToTypedJson("TypeA", point).dump(), json);
+}
+
 TEST(JsonUtilTest, GetStringFromJson) {
   Json json_obj;
   json_obj["key1"] = 0;
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/data/record/record_reader.h"
+#include "modules/data/record/record_writer.h"
+
+namespace apollo {
+namespace data {
+namespace record {
+namespace {
+
+const char kRecordFile[] = "/tmp/record_benchmark.record";
+const char kPointCloudTopic[] =
+    "/apollo/sensor/velodyne64/compensator/PointCloud2";
+const char kImageTopic[] = "/apollo/sensor/camera/traffic/image_long";
+
+// Seconds of data, with point clouds and images at 10Hz.
+constexpr int kDurationSec = 5;
+constexpr int kFrequency = 10;
+
+// A scan of a 64 beam lidar, 16 bytes per point for x, y, z and intensity.
+std::string PointCloud(std::mt19937 *engine) {
+  std::normal_distribution<float> noise(0.0f, 0.02f);
+  std::string content;
+  for (int beam = 0; beam < 64; ++beam) {
+    for (int column = 0; column < 1000; ++column) {
+      const float azimuth = column * 2.0f * M_PI / 1000;
+      const float range = 10.0f + beam * 0.5f + noise(*engine);
+      const float point[] = {range * std::cos(azimuth),
+                             range * std::sin(azimuth), -1.5f + beam * 0.05f,
+                             static_cast<float>(column % 256)};
+      content.append(reinterpret_cast<const char *>(point), sizeof(point));
+    }
+  }
+  return content;
+}
+
+// A 640x480 rgb8 image of smooth gradients with sensor noise.
+std::string Image(std::mt19937 *engine) {
+  std::uniform_int_distribution<int> noise(0, 3);
+  std::string content(640 * 480 * 3, '\0');
+  for (int y = 0; y < 480; ++y) {
+    for (int x = 0; x < 640; ++x) {
+      auto *pixel = reinterpret_cast<uint8_t *>(&content[(y * 640 + x) * 3]);
+      pixel[0] = x * 255 / 640 + noise(*engine);
+      pixel[1] = y * 255 / 480 + noise(*engine);
+      pixel[2] = 128 + noise(*engine);
+    }
+  }
+  return content;
+}
+
+// Writes the synthetic streams, returning the number of bytes of messages.
+int64_t WriteRecord(const std::vector<std::string> &point_clouds,
+                    const std::vector<std::string> &images,
+                    const bool compress) {
+  RecordWriter writer(1 << 20, compress);
+  writer.Open(kRecordFile);
+  int64_t bytes = 0;
+  for (int i = 0; i < kDurationSec * kFrequency; ++i) {
+    const auto &point_cloud = point_clouds[i % point_clouds.size()];
+    const auto &image = images[i % images.size()];
+    writer.Write(kPointCloudTopic, 0.1 * i, point_cloud);
+    writer.Write(kImageTopic, 0.1 * i + 0.05, image);
+    bytes += point_cloud.size() + image.size();
+  }
+  writer.Close();
+  return bytes;
+}
+
+struct Streams {
+  Streams() {
+    std::mt19937 engine(0);
+    for (int i = 0; i < 4; ++i) {
+      point_clouds.push_back(PointCloud(&engine));
+      images.push_back(Image(&engine));
+    }
+  }
+  std::vector<std::string> point_clouds;
+  std::vector<std::string> images;
+};
+
+const Streams &GetStreams() {
+  static const Streams streams;
+  return streams;
+}
+
+// Recording throughput, with (1) or without (0) compression.
+void BM_Write(benchmark::State &state) {
+  const auto &streams = GetStreams();
+  int64_t bytes = 0;
+  while (state.KeepRunning()) {
+    bytes += WriteRecord(streams.point_clouds, streams.images, state.range(0));
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_Write)
+    ->Arg(1)
+    ->Arg(0)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Reading all the messages with range(0) threads.
+void BM_ReadAll(benchmark::State &state) {
+  const auto &streams = GetStreams();
+  WriteRecord(streams.point_clouds, streams.images, true);
+  RecordReader reader;
+  reader.Open(kRecordFile);
+  int64_t bytes = 0;
+  while (state.KeepRunning()) {
+    reader.Read({}, 0.0, kDurationSec,
+                [&bytes](const RecordMessage &message) {
+                  bytes += message.content.size();
+                },
+                state.range(0));
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ReadAll)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Reading the point clouds of a 0.5s window.
+void BM_ReadWindow(benchmark::State &state) {
+  const auto &streams = GetStreams();
+  WriteRecord(streams.point_clouds, streams.images, true);
+  RecordReader reader;
+  reader.Open(kRecordFile);
+  int64_t bytes = 0;
+  while (state.KeepRunning()) {
+    reader.Read({kPointCloudTopic}, 2.0, 2.5,
+                [&bytes](const RecordMessage &message) {
+                  bytes += message.content.size();
+                },
+                state.range(0));
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ReadWindow)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
+
+BENCHMARK_MAIN();
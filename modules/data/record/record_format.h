@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Constants and encoding helpers of the record file layout described in
+ * record.proto, shared by RecordWriter and RecordReader.
+ */
+
+#ifndef MODULES_DATA_RECORD_RECORD_FORMAT_H_
+#define MODULES_DATA_RECORD_RECORD_FORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace apollo {
+namespace data {
+namespace record {
+
+constexpr char kRecordMagic[] = "APOLLORECORD";
+constexpr size_t kRecordMagicSize = sizeof(kRecordMagic) - 1;
+constexpr uint32_t kRecordVersion = 1;
+
+// Magic and version.
+constexpr size_t kRecordHeaderSize = kRecordMagicSize + sizeof(uint32_t);
+// Index offset, index size and magic.
+constexpr size_t kRecordFooterSize = 2 * sizeof(uint64_t) + kRecordMagicSize;
+// Topic id, time and content size of a message in a chunk.
+constexpr size_t kMessageHeaderSize =
+    sizeof(uint32_t) + sizeof(double) + sizeof(uint32_t);
+
+// Values are stored in the byte order of the host, which is little-endian on
+// all the supported platforms.
+template <typename T>
+void AppendValue(const T value, std::string *out) {
+  out->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadValue(const char *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
+
+#endif  // MODULES_DATA_RECORD_RECORD_FORMAT_H_
@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/record/record_reader.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <future>
+#include <limits>
+#include <memory>
+
+#include "modules/common/log.h"
+#include "modules/common/util/ctpl_stl.h"
+#include "modules/data/record/record_format.h"
+
+namespace apollo {
+namespace data {
+namespace record {
+namespace {
+
+// Reads size bytes at offset, retrying short reads.
+bool ReadAt(const int fd, const uint64_t offset, const size_t size,
+            std::string *data) {
+  data->resize(size);
+  size_t done = 0;
+  while (done < size) {
+    const ssize_t n = pread(fd, &(*data)[done], size - done, offset + done);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+}  // namespace
+
+RecordReader::~RecordReader() { Close(); }
+
+bool RecordReader::Open(const std::string &path) {
+  Close();
+  fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) {
+    AERROR << "Unable to open record file " << path;
+    return false;
+  }
+
+  struct stat file_stat;
+  std::string header;
+  std::string footer;
+  if (fstat(fd_, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) <
+          kRecordHeaderSize + kRecordFooterSize ||
+      !ReadAt(fd_, 0, kRecordHeaderSize, &header) ||
+      !ReadAt(fd_, file_stat.st_size - kRecordFooterSize, kRecordFooterSize,
+              &footer) ||
+      header.compare(0, kRecordMagicSize, kRecordMagic) != 0 ||
+      footer.compare(2 * sizeof(uint64_t), kRecordMagicSize, kRecordMagic) !=
+          0) {
+    AERROR << path << " is not a complete record file.";
+    Close();
+    return false;
+  }
+  const uint32_t version =
+      ReadValue<uint32_t>(header.data() + kRecordMagicSize);
+  if (version != kRecordVersion) {
+    AERROR << "Unsupported version " << version << " of record file " << path;
+    Close();
+    return false;
+  }
+
+  const uint64_t index_offset = ReadValue<uint64_t>(footer.data());
+  const uint64_t index_size =
+      ReadValue<uint64_t>(footer.data() + sizeof(uint64_t));
+  std::string index;
+  if (index_offset + index_size + kRecordFooterSize !=
+          static_cast<uint64_t>(file_stat.st_size) ||
+      !ReadAt(fd_, index_offset, index_size, &index) ||
+      !index_.ParseFromString(index)) {
+    AERROR << "Unable to read the index of record file " << path;
+    Close();
+    return false;
+  }
+
+  topics_.assign(index_.topic().begin(), index_.topic().end());
+  for (size_t i = 0; i < topics_.size(); ++i) {
+    topic_ids_.emplace(topics_[i], i);
+  }
+  topic_chunks_.resize(topics_.size());
+  for (int i = 0; i < index_.chunk_size(); ++i) {
+    for (const auto &range : index_.chunk(i).topic_range()) {
+      if (range.topic_id() >= topics_.size()) {
+        AERROR << "Invalid topic in the index of record file " << path;
+        Close();
+        return false;
+      }
+      topic_chunks_[range.topic_id()].push_back(
+          {range.begin_time(), range.end_time(), i});
+    }
+  }
+  // Times never decrease, so the first and last messages are in the first
+  // and last chunks.
+  if (index_.chunk_size() > 0) {
+    begin_time_ = std::numeric_limits<double>::max();
+    for (const auto &range : index_.chunk(0).topic_range()) {
+      begin_time_ = std::min(begin_time_, range.begin_time());
+    }
+    end_time_ = std::numeric_limits<double>::lowest();
+    for (const auto &range :
+         index_.chunk(index_.chunk_size() - 1).topic_range()) {
+      end_time_ = std::max(end_time_, range.end_time());
+    }
+  }
+  return true;
+}
+
+void RecordReader::Close() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  index_.Clear();
+  topics_.clear();
+  topic_ids_.clear();
+  topic_chunks_.clear();
+  begin_time_ = 0.0;
+  end_time_ = 0.0;
+}
+
+int RecordReader::MessageCount(const std::string &topic) const {
+  const auto iter = topic_ids_.find(topic);
+  if (iter == topic_ids_.end()) {
+    return 0;
+  }
+  int count = 0;
+  for (const auto &topic_chunk : topic_chunks_[iter->second]) {
+    for (const auto &range : index_.chunk(topic_chunk.chunk).topic_range()) {
+      if (range.topic_id() == iter->second) {
+        count += range.message_count();
+      }
+    }
+  }
+  return count;
+}
+
+bool RecordReader::Read(const std::vector<std::string> &topics,
+                        const double begin_time, const double end_time,
+                        const Callback &callback, const int num_threads) const {
+  if (fd_ < 0) {
+    AERROR << "RecordReader is not open.";
+    return false;
+  }
+  std::vector<uint32_t> topic_ids;
+  std::vector<bool> topic_mask(topics_.size(), topics.empty());
+  if (topics.empty()) {
+    for (size_t i = 0; i < topics_.size(); ++i) {
+      topic_ids.push_back(i);
+    }
+  }
+  for (const auto &topic : topics) {
+    const auto iter = topic_ids_.find(topic);
+    if (iter != topic_ids_.end() && !topic_mask[iter->second]) {
+      topic_ids.push_back(iter->second);
+      topic_mask[iter->second] = true;
+    }
+  }
+  const std::vector<int> chunks = FindChunks(topic_ids, begin_time, end_time);
+
+  std::vector<RecordMessage> messages;
+  if (num_threads <= 1 || chunks.size() <= 1) {
+    for (const int chunk : chunks) {
+      messages.clear();
+      if (!ReadChunk(chunk, topic_mask, begin_time, end_time, &messages)) {
+        return false;
+      }
+      for (const auto &message : messages) {
+        callback(message);
+      }
+    }
+    return true;
+  }
+
+  // Chunks are read and decompressed by the pool, a few ahead of the one
+  // being passed to the callback, which keeps the output in order and bounds
+  // the memory used.
+  using ChunkMessages = std::unique_ptr<std::vector<RecordMessage>>;
+  apollo::common::util::ThreadPool pool(num_threads);
+  std::deque<std::future<ChunkMessages>> pending;
+  const size_t max_pending = 2 * num_threads;
+  size_t next = 0;
+  bool ok = true;
+  while (next < chunks.size() || !pending.empty()) {
+    while (next < chunks.size() && pending.size() < max_pending) {
+      const int chunk = chunks[next++];
+      pending.push_back(pool.Push([this, chunk, &topic_mask, begin_time,
+                                   end_time](int) {
+        ChunkMessages chunk_messages(new std::vector<RecordMessage>());
+        if (!ReadChunk(chunk, topic_mask, begin_time, end_time,
+                       chunk_messages.get())) {
+          chunk_messages.reset();
+        }
+        return chunk_messages;
+      }));
+    }
+    const ChunkMessages chunk_messages = pending.front().get();
+    pending.pop_front();
+    if (chunk_messages == nullptr) {
+      ok = false;
+      next = chunks.size();
+    } else if (ok) {
+      for (const auto &message : *chunk_messages) {
+        callback(message);
+      }
+    }
+  }
+  return ok;
+}
+
+bool RecordReader::Read(const std::vector<std::string> &topics,
+                        const double begin_time, const double end_time,
+                        std::vector<RecordMessage> *messages,
+                        const int num_threads) const {
+  return Read(topics, begin_time, end_time,
+              [messages](const RecordMessage &message) {
+                messages->push_back(message);
+              },
+              num_threads);
+}
+
+std::vector<int> RecordReader::FindChunks(
+    const std::vector<uint32_t> &topic_ids, const double begin_time,
+    const double end_time) const {
+  std::vector<int> chunks;
+  for (const uint32_t topic_id : topic_ids) {
+    // Times never decrease in a record file, so the chunks of a topic are
+    // sorted by both their begin and end times.
+    const auto &topic_chunks = topic_chunks_[topic_id];
+    auto iter = std::lower_bound(
+        topic_chunks.begin(), topic_chunks.end(), begin_time,
+        [](const TopicChunk &topic_chunk, const double time) {
+          return topic_chunk.end_time < time;
+        });
+    for (; iter != topic_chunks.end() && iter->begin_time <= end_time;
+         ++iter) {
+      chunks.push_back(iter->chunk);
+    }
+  }
+  std::sort(chunks.begin(), chunks.end());
+  chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+  return chunks;
+}
+
+bool RecordReader::ReadChunk(const int chunk,
+                             const std::vector<bool> &topic_mask,
+                             const double begin_time, const double end_time,
+                             std::vector<RecordMessage> *messages) const {
+  const ChunkIndex &chunk_index = index_.chunk(chunk);
+  std::string stored;
+  if (!ReadAt(fd_, chunk_index.offset(), chunk_index.size(), &stored)) {
+    AERROR << "Unable to read record chunk " << chunk;
+    return false;
+  }
+  std::string raw;
+  if (chunk_index.compressed()) {
+    uLongf size = chunk_index.raw_size();
+    raw.resize(size);
+    if (uncompress(reinterpret_cast<Bytef *>(&raw[0]), &size,
+                   reinterpret_cast<const Bytef *>(stored.data()),
+                   stored.size()) != Z_OK ||
+        size != chunk_index.raw_size()) {
+      AERROR << "Unable to decompress record chunk " << chunk;
+      return false;
+    }
+  } else {
+    raw.swap(stored);
+  }
+
+  size_t pos = 0;
+  while (pos < raw.size()) {
+    if (raw.size() - pos < kMessageHeaderSize) {
+      AERROR << "Truncated message in record chunk " << chunk;
+      return false;
+    }
+    const char *header = raw.data() + pos;
+    const uint32_t topic_id = ReadValue<uint32_t>(header);
+    const double time = ReadValue<double>(header + sizeof(uint32_t));
+    const uint32_t size =
+        ReadValue<uint32_t>(header + sizeof(uint32_t) + sizeof(double));
+    pos += kMessageHeaderSize;
+    if (topic_id >= topic_mask.size() || raw.size() - pos < size) {
+      AERROR << "Invalid message in record chunk " << chunk;
+      return false;
+    }
+    if (topic_mask[topic_id] && time >= begin_time && time <= end_time) {
+      messages->emplace_back();
+      RecordMessage &message = messages->back();
+      message.topic = topics_[topic_id];
+      message.time = time;
+      message.content.assign(raw, pos, size);
+    }
+    pos += size;
+  }
+  return true;
+}
+
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Reader of indexed record files.
+ */
+
+#ifndef MODULES_DATA_RECORD_RECORD_READER_H_
+#define MODULES_DATA_RECORD_RECORD_READER_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/data/proto/record.pb.h"
+
+/**
+ * @namespace apollo::data::record
+ * @brief apollo::data::record
+ */
+namespace apollo {
+namespace data {
+namespace record {
+
+struct RecordMessage {
+  std::string topic;
+  // Time of the message in seconds.
+  double time = 0.0;
+  // Serialized message.
+  std::string content;
+};
+
+/**
+ * @class RecordReader
+ *
+ * @brief Reads messages from a record file written by RecordWriter. Open()
+ * loads only the index at the end of the file. Read() then finds the chunks
+ * with messages of the given topics in a time range by binary search, and only
+ * reads and decompresses those, optionally on several threads.
+ *
+ * Read() may be called from several threads at once.
+ */
+class RecordReader {
+ public:
+  using Callback = std::function<void(const RecordMessage &)>;
+
+  RecordReader() = default;
+  ~RecordReader();
+
+  /**
+   * @brief Opens a record file and loads its index.
+   * @return false if the file can't be read or isn't a record file.
+   */
+  bool Open(const std::string &path);
+
+  /**
+   * @brief Closes the file.
+   */
+  void Close();
+
+  /**
+   * @brief Topics of the messages in the file.
+   */
+  const std::vector<std::string> &topics() const { return topics_; }
+
+  /**
+   * @brief Number of messages of a topic.
+   */
+  int MessageCount(const std::string &topic) const;
+
+  /**
+   * @brief Time of the first message, or 0 for an empty file.
+   */
+  double begin_time() const { return begin_time_; }
+
+  /**
+   * @brief Time of the last message, or 0 for an empty file.
+   */
+  double end_time() const { return end_time_; }
+
+  /**
+   * @brief Calls callback with the messages of the topics in [begin_time,
+   * end_time], in the order they were written.
+   * @param topics Topics to read. Empty to read all the topics.
+   * @param begin_time Start of the time range in seconds.
+   * @param end_time End of the time range in seconds.
+   * @param callback Called on the calling thread for each message.
+   * @param num_threads Number of threads reading and decompressing chunks.
+   * @return false if a chunk failed to be read.
+   */
+  bool Read(const std::vector<std::string> &topics, const double begin_time,
+            const double end_time, const Callback &callback,
+            const int num_threads = 1) const;
+
+  /**
+   * @brief Appends the messages of the topics in [begin_time, end_time] to
+   * messages, in the order they were written.
+   * @return false if a chunk failed to be read.
+   */
+  bool Read(const std::vector<std::string> &topics, const double begin_time,
+            const double end_time, std::vector<RecordMessage> *messages,
+            const int num_threads = 1) const;
+
+ private:
+  // Chunk with messages of a topic and their time range.
+  struct TopicChunk {
+    double begin_time;
+    double end_time;
+    int chunk;
+  };
+
+  // Returns the sorted indices of the chunks with messages of the topics in
+  // the time range.
+  std::vector<int> FindChunks(const std::vector<uint32_t> &topic_ids,
+                              const double begin_time,
+                              const double end_time) const;
+
+  bool ReadChunk(const int chunk, const std::vector<bool> &topic_mask,
+                 const double begin_time, const double end_time,
+                 std::vector<RecordMessage> *messages) const;
+
+  int fd_ = -1;
+  RecordIndex index_;
+  std::vector<std::string> topics_;
+  std::unordered_map<std::string, uint32_t> topic_ids_;
+  // Chunks of each topic in time order.
+  std::vector<std::vector<TopicChunk>> topic_chunks_;
+  double begin_time_ = 0.0;
+  double end_time_ = 0.0;
+};
+
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
+
+#endif  // MODULES_DATA_RECORD_RECORD_READER_H_
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/record/record_reader.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/data/record/record_writer.h"
+
+namespace apollo {
+namespace data {
+namespace record {
+
+namespace {
+
+const char kRecordFile[] = "/tmp/record_reader_test.record";
+
+// Content of the i-th message.
+std::string Content(const int i) {
+  return std::string(i % 97, 'a' + i % 26) + std::to_string(i);
+}
+
+// Topics and times of the i-th message: a fast topic every 0.01s, and a slow
+// one every 0.1s.
+std::string Topic(const int i) { return i % 10 == 0 ? "/slow" : "/fast"; }
+double Time(const int i) { return 100.0 + 0.01 * i; }
+
+}  // namespace
+
+class RecordReaderTest : public ::testing::Test {
+ protected:
+  // Writes messages in small chunks so that there are many of them.
+  void WriteRecord(const bool compress) {
+    RecordWriter writer(2000, compress);
+    ASSERT_TRUE(writer.Open(kRecordFile));
+    for (int i = 0; i < kNumMessages; ++i) {
+      ASSERT_TRUE(writer.Write(Topic(i), Time(i), Content(i)));
+    }
+    ASSERT_TRUE(writer.Close());
+  }
+
+  // Expects messages to be the written ones of the topic in the time range.
+  void ExpectMessages(const std::string &topic, const double begin_time,
+                      const double end_time,
+                      const std::vector<RecordMessage> &messages) {
+    size_t count = 0;
+    for (int i = 0; i < kNumMessages; ++i) {
+      if ((topic.empty() || Topic(i) == topic) && Time(i) >= begin_time &&
+          Time(i) <= end_time) {
+        ASSERT_LT(count, messages.size());
+        EXPECT_EQ(Topic(i), messages[count].topic);
+        EXPECT_DOUBLE_EQ(Time(i), messages[count].time);
+        EXPECT_EQ(Content(i), messages[count].content);
+        ++count;
+      }
+    }
+    EXPECT_EQ(count, messages.size());
+  }
+
+  static constexpr int kNumMessages = 1000;
+};
+
+constexpr int RecordReaderTest::kNumMessages;
+
+TEST_F(RecordReaderTest, ReadAll) {
+  for (const bool compress : {true, false}) {
+    WriteRecord(compress);
+    RecordReader reader;
+    ASSERT_TRUE(reader.Open(kRecordFile));
+    EXPECT_EQ(std::vector<std::string>({"/slow", "/fast"}), reader.topics());
+    EXPECT_EQ(100, reader.MessageCount("/slow"));
+    EXPECT_EQ(900, reader.MessageCount("/fast"));
+    EXPECT_EQ(0, reader.MessageCount("/unknown"));
+    EXPECT_DOUBLE_EQ(Time(0), reader.begin_time());
+    EXPECT_DOUBLE_EQ(Time(kNumMessages - 1), reader.end_time());
+
+    std::vector<RecordMessage> messages;
+    EXPECT_TRUE(reader.Read({}, 0.0, 1000.0, &messages));
+    ExpectMessages("", 0.0, 1000.0, messages);
+  }
+}
+
+TEST_F(RecordReaderTest, ReadTopicInTimeRange) {
+  WriteRecord(true);
+  RecordReader reader;
+  ASSERT_TRUE(reader.Open(kRecordFile));
+
+  std::vector<RecordMessage> messages;
+  EXPECT_TRUE(reader.Read({"/slow"}, 102.0, 105.0, &messages));
+  ExpectMessages("/slow", 102.0, 105.0, messages);
+
+  messages.clear();
+  EXPECT_TRUE(reader.Read({"/fast", "/unknown"}, 103.333, 103.5, &messages));
+  ExpectMessages("/fast", 103.333, 103.5, messages);
+
+  messages.clear();
+  EXPECT_TRUE(reader.Read({"/unknown"}, 0.0, 1000.0, &messages));
+  EXPECT_TRUE(messages.empty());
+  EXPECT_TRUE(reader.Read({}, 200.0, 300.0, &messages));
+  EXPECT_TRUE(messages.empty());
+}
+
+TEST_F(RecordReaderTest, ReadInParallel) {
+  WriteRecord(true);
+  RecordReader reader;
+  ASSERT_TRUE(reader.Open(kRecordFile));
+
+  std::vector<RecordMessage> messages;
+  EXPECT_TRUE(reader.Read({}, 101.0, 108.0, &messages, 4));
+  ExpectMessages("", 101.0, 108.0, messages);
+}
+
+TEST_F(RecordReaderTest, WriteOutOfOrder) {
+  RecordWriter writer;
+  ASSERT_TRUE(writer.Open(kRecordFile));
+  EXPECT_TRUE(writer.Write("/topic", 2.0, "a"));
+  EXPECT_FALSE(writer.Write("/topic", 1.0, "b"));
+  EXPECT_TRUE(writer.Write("/other", 2.0, "c"));
+  EXPECT_TRUE(writer.Close());
+  EXPECT_FALSE(writer.Write("/topic", 3.0, "d"));
+
+  RecordReader reader;
+  ASSERT_TRUE(reader.Open(kRecordFile));
+  std::vector<RecordMessage> messages;
+  EXPECT_TRUE(reader.Read({}, 0.0, 10.0, &messages));
+  ASSERT_EQ(2, messages.size());
+  EXPECT_EQ("a", messages[0].content);
+  EXPECT_EQ("c", messages[1].content);
+}
+
+TEST_F(RecordReaderTest, OpenInvalidFile) {
+  RecordReader reader;
+  EXPECT_FALSE(reader.Open("/tmp/record_reader_test.not_exist"));
+
+  WriteRecord(true);
+  std::ifstream input(kRecordFile, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(input)),
+                            std::istreambuf_iterator<char>());
+  // Truncated as if the recorder had been killed.
+  std::ofstream(kRecordFile, std::ios::binary | std::ios::trunc)
+      << content.substr(0, content.size() / 2);
+  EXPECT_FALSE(reader.Open(kRecordFile));
+  std::vector<RecordMessage> messages;
+  EXPECT_FALSE(reader.Read({}, 0.0, 1000.0, &messages));
+}
+
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
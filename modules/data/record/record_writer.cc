@@ -0,0 +1,231 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/record/record_writer.h"
+
+#include <zlib.h>
+
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/data/record/record_format.h"
+
+namespace apollo {
+namespace data {
+namespace record {
+namespace {
+
+// Number of full chunks which may wait for the background thread before
+// Write() blocks, which bounds the memory used when the disk is too slow.
+constexpr size_t kMaxPendingChunks = 8;
+
+}  // namespace
+
+RecordWriter::RecordWriter(const size_t chunk_size, const bool compress,
+                           const int num_compress_threads)
+    : chunk_size_(chunk_size),
+      compress_(compress),
+      compress_pool_(compress ? num_compress_threads : 1) {}
+
+RecordWriter::~RecordWriter() {
+  if (IsOpen()) {
+    Close();
+  }
+}
+
+bool RecordWriter::Open(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (open_) {
+    AERROR << "RecordWriter is already open.";
+    return false;
+  }
+  file_.open(path, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    AERROR << "Unable to open record file " << path;
+    return false;
+  }
+  std::string header(kRecordMagic, kRecordMagicSize);
+  AppendValue(kRecordVersion, &header);
+  file_.write(header.data(), header.size());
+
+  open_ = true;
+  closing_ = false;
+  ok_ = file_.good();
+  last_time_ = std::numeric_limits<double>::lowest();
+  index_.Clear();
+  topic_ids_.clear();
+  chunk_ = Chunk();
+  chunk_topic_ranges_.clear();
+  writer_thread_ = std::thread(&RecordWriter::WriteChunks, this);
+  return ok_;
+}
+
+bool RecordWriter::Write(const std::string &topic, const double time,
+                         const std::string &content) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!open_ || !ok_) {
+    return false;
+  }
+  if (time < last_time_) {
+    AERROR << "Message of " << topic << " at " << time
+           << " is before the previous message at " << last_time_;
+    return false;
+  }
+  last_time_ = time;
+
+  auto topic_iter = topic_ids_.find(topic);
+  if (topic_iter == topic_ids_.end()) {
+    topic_iter = topic_ids_.emplace(topic, index_.topic_size()).first;
+    index_.add_topic(topic);
+  }
+  const uint32_t topic_id = topic_iter->second;
+
+  AppendValue(topic_id, &chunk_.data);
+  AppendValue(time, &chunk_.data);
+  AppendValue(static_cast<uint32_t>(content.size()), &chunk_.data);
+  chunk_.data.append(content);
+
+  TopicRange *range = nullptr;
+  const auto range_iter = chunk_topic_ranges_.find(topic_id);
+  if (range_iter == chunk_topic_ranges_.end()) {
+    chunk_topic_ranges_.emplace(topic_id, chunk_.index.topic_range_size());
+    range = chunk_.index.add_topic_range();
+    range->set_topic_id(topic_id);
+    range->set_begin_time(time);
+  } else {
+    range = chunk_.index.mutable_topic_range(range_iter->second);
+  }
+  range->set_end_time(time);
+  range->set_message_count(range->message_count() + 1);
+
+  if (chunk_.data.size() >= chunk_size_) {
+    FlushChunk(&lock);
+  }
+  return true;
+}
+
+bool RecordWriter::Close() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!open_) {
+    return false;
+  }
+  open_ = false;
+  FlushChunk(&lock);
+  closing_ = true;
+  lock.unlock();
+  cv_.notify_all();
+  writer_thread_.join();
+  lock.lock();
+
+  std::string index;
+  index_.SerializeToString(&index);
+  const uint64_t index_offset = file_.tellp();
+  AppendValue(index_offset, &index);
+  AppendValue(static_cast<uint64_t>(index.size() - sizeof(uint64_t)), &index);
+  index.append(kRecordMagic, kRecordMagicSize);
+  file_.write(index.data(), index.size());
+  file_.close();
+  return ok_ && !file_.fail();
+}
+
+bool RecordWriter::IsOpen() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return open_;
+}
+
+void RecordWriter::FlushChunk(std::unique_lock<std::mutex> *lock) {
+  if (chunk_.data.empty()) {
+    return;
+  }
+  cv_.wait(*lock, [this]() {
+    return pending_chunks_.size() < kMaxPendingChunks || !ok_;
+  });
+  auto chunk = std::make_shared<Chunk>(std::move(chunk_));
+  const bool compress = compress_;
+  pending_chunks_.push_back(compress_pool_.Push([chunk, compress](int) {
+    return CompressChunk(std::move(*chunk), compress);
+  }));
+  chunk_ = Chunk();
+  chunk_topic_ranges_.clear();
+  cv_.notify_all();
+}
+
+void RecordWriter::WriteChunks() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock,
+             [this]() { return closing_ || !pending_chunks_.empty(); });
+    if (pending_chunks_.empty()) {
+      break;
+    }
+    std::future<Chunk> future = std::move(pending_chunks_.front());
+    pending_chunks_.pop_front();
+    const bool ok = ok_;
+    // Only this thread uses the file until it is joined in Close().
+    lock.unlock();
+    Chunk chunk = future.get();
+    const bool written = ok && WriteChunk(&chunk);
+    lock.lock();
+    if (written) {
+      index_.add_chunk()->Swap(&chunk.index);
+    } else {
+      ok_ = false;
+    }
+    cv_.notify_all();
+  }
+}
+
+RecordWriter::Chunk RecordWriter::CompressChunk(Chunk chunk,
+                                                const bool compress) {
+  chunk.index.set_raw_size(chunk.data.size());
+  if (!compress) {
+    return chunk;
+  }
+  uLongf size = compressBound(chunk.data.size());
+  std::string compressed(size, '\0');
+  const int status =
+      compress2(reinterpret_cast<Bytef *>(&compressed[0]), &size,
+                reinterpret_cast<const Bytef *>(chunk.data.data()),
+                chunk.data.size(), Z_BEST_SPEED);
+  if (status != Z_OK) {
+    AWARN << "Unable to compress record chunk: " << status;
+    return chunk;
+  }
+  // Keep incompressible chunks as they are.
+  if (size < chunk.data.size()) {
+    compressed.resize(size);
+    chunk.data.swap(compressed);
+    chunk.index.set_compressed(true);
+  }
+  return chunk;
+}
+
+bool RecordWriter::WriteChunk(Chunk *chunk) {
+  chunk->index.set_offset(file_.tellp());
+  chunk->index.set_size(chunk->data.size());
+  file_.write(chunk->data.data(), chunk->data.size());
+  if (!file_.good()) {
+    AERROR << "Unable to write record chunk.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
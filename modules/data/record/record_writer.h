@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Writer of indexed record files.
+ */
+
+#ifndef MODULES_DATA_RECORD_RECORD_WRITER_H_
+#define MODULES_DATA_RECORD_RECORD_WRITER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "modules/common/util/ctpl_stl.h"
+#include "modules/data/proto/record.pb.h"
+
+/**
+ * @namespace apollo::data::record
+ * @brief apollo::data::record
+ */
+namespace apollo {
+namespace data {
+namespace record {
+
+/**
+ * @class RecordWriter
+ *
+ * @brief Writes messages of many topics into a record file. Messages are
+ * grouped into chunks which are compressed by a thread pool and written in
+ * order by a background thread, so Write() only copies the message. An index
+ * of the chunks with the time range of each topic is written at the end of
+ * the file, see record.proto for the layout.
+ *
+ * Write() is thread-safe. Message times must not decrease, which holds for the
+ * receive times of a recorder.
+ */
+class RecordWriter {
+ public:
+  /**
+   * @brief Constructor.
+   * @param chunk_size Size of the messages in a chunk before it is written.
+   * @param compress Whether to compress the chunks with zlib.
+   * @param num_compress_threads Number of threads compressing chunks.
+   */
+  explicit RecordWriter(const size_t chunk_size = 1 << 20,
+                        const bool compress = true,
+                        const int num_compress_threads = 2);
+
+  /**
+   * @brief Closes the file if it is open.
+   */
+  ~RecordWriter();
+
+  /**
+   * @brief Creates a record file, overwriting any existing one.
+   * @return false if the file can't be opened.
+   */
+  bool Open(const std::string &path);
+
+  /**
+   * @brief Adds a message to the file.
+   * @param topic Topic of the message.
+   * @param time Time of the message in seconds, not before the previous one.
+   * @param content Serialized message.
+   * @return false if the file isn't open, the time is before the previous
+   * message or a previous chunk failed to be written.
+   */
+  bool Write(const std::string &topic, const double time,
+             const std::string &content);
+
+  /**
+   * @brief Writes the pending messages and the index, and closes the file.
+   * @return false if any part of the file failed to be written.
+   */
+  bool Close();
+
+  /**
+   * @brief Returns whether a file is open for writing.
+   */
+  bool IsOpen() const;
+
+ private:
+  struct Chunk {
+    std::string data;
+    ChunkIndex index;
+  };
+
+  // Hands the current chunk to the compression pool. Requires mutex_.
+  void FlushChunk(std::unique_lock<std::mutex> *lock);
+
+  // Compresses the chunk if it makes it smaller.
+  static Chunk CompressChunk(Chunk chunk, const bool compress);
+
+  // Writes the compressed chunks in order until the file is closed.
+  void WriteChunks();
+
+  bool WriteChunk(Chunk *chunk);
+
+  const size_t chunk_size_;
+  const bool compress_;
+  apollo::common::util::ThreadPool compress_pool_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::ofstream file_;
+  bool open_ = false;
+  bool closing_ = false;
+  bool ok_ = true;
+  double last_time_ = 0.0;
+
+  RecordIndex index_;
+  std::unordered_map<std::string, uint32_t> topic_ids_;
+
+  // Chunk receiving messages, and chunks being compressed in file order.
+  Chunk chunk_;
+  // Position of each topic in chunk_.index.topic_range.
+  std::unordered_map<uint32_t, int> chunk_topic_ranges_;
+  std::deque<std::future<Chunk>> pending_chunks_;
+  std::thread writer_thread_;
+};
+
+}  // namespace record
+}  // namespace data
+}  // namespace apollo
+
+#endif  // MODULES_DATA_RECORD_RECORD_WRITER_H_
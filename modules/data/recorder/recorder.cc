@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/recorder/recorder.h"
+
+#include <algorithm>
+#include <ctime>
+#include <type_traits>
+#include <utility>
+
+#include "gflags/gflags.h"
+#include "google/protobuf/message.h"
+#include "ros/include/ros/ros.h"
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/file.h"
+
+DEFINE_string(recorder_adapter_config_filename,
+              "modules/data/conf/recorder_adapter.conf",
+              "The adapter config file of the topics to record.");
+
+DEFINE_string(recorder_dir, "/apollo/data/record",
+              "Directory of the recorded files.");
+
+DEFINE_double(recorder_split_duration, 60.0,
+              "Start a new record file after this many seconds.");
+
+DEFINE_int32(recorder_chunk_size, 1 << 20,
+             "Size in bytes of the messages grouped into a compressed chunk.");
+
+DEFINE_bool(recorder_compress, true, "Whether to compress recorded chunks.");
+
+DEFINE_int32(recorder_compress_threads, 2,
+             "Number of threads compressing recorded chunks.");
+
+namespace apollo {
+namespace data {
+namespace {
+
+using apollo::common::adapter::AdapterManager;
+using apollo::common::adapter::enable_if_t;
+
+template <typename T>
+void Serialize(
+    const T &message, std::string *content,
+    enable_if_t<std::is_base_of<google::protobuf::Message, T>::value> * =
+        nullptr) {
+  message.SerializeToString(content);
+}
+
+// Sensor data such as point clouds and images are ROS messages.
+template <typename T>
+void Serialize(
+    const T &message, std::string *content,
+    enable_if_t<!std::is_base_of<google::protobuf::Message, T>::value> * =
+        nullptr) {
+  const uint32_t size = ros::serialization::serializationLength(message);
+  content->resize(size);
+  ros::serialization::OStream stream(
+      reinterpret_cast<uint8_t *>(&(*content)[0]), size);
+  ros::serialization::serialize(stream, message);
+}
+
+}  // namespace
+
+using apollo::common::ErrorCode;
+using apollo::common::Status;
+
+std::string Recorder::Name() const { return "recorder"; }
+
+Status Recorder::Init() {
+  AdapterManager::Init(FLAGS_recorder_adapter_config_filename);
+  if (!apollo::common::util::EnsureDirectory(FLAGS_recorder_dir)) {
+    return Status(ErrorCode::DATA_RECORDER_ERROR,
+                  "Unable to create " + FLAGS_recorder_dir);
+  }
+  return Status::OK();
+}
+
+#define RECORD_ADAPTER(name)                                                 \
+  if (AdapterManager::Get##name() != nullptr) {                              \
+    const std::string topic = AdapterManager::Get##name()->topic_name();     \
+    AINFO << "Recording " << topic;                                          \
+    AdapterManager::Add##name##Callback(                                     \
+        [this, topic](const apollo::common::adapter::name##Adapter::DataType \
+                          &message) { Record(topic, message); });            \
+  }
+
+Status Recorder::Start() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!OpenNewFile(apollo::common::time::Clock::NowInSeconds())) {
+      return Status(ErrorCode::DATA_RECORDER_ERROR,
+                    "Unable to open a record file in " + FLAGS_recorder_dir);
+    }
+  }
+
+  RECORD_ADAPTER(Chassis);
+  RECORD_ADAPTER(ChassisDetail);
+  RECORD_ADAPTER(ControlCommand);
+  RECORD_ADAPTER(Gps);
+  RECORD_ADAPTER(Imu);
+  RECORD_ADAPTER(RawImu);
+  RECORD_ADAPTER(Localization);
+  RECORD_ADAPTER(Monitor);
+  RECORD_ADAPTER(Pad);
+  RECORD_ADAPTER(PerceptionObstacles);
+  RECORD_ADAPTER(Planning);
+  RECORD_ADAPTER(PointCloud);
+  RECORD_ADAPTER(ImageShort);
+  RECORD_ADAPTER(ImageLong);
+  RECORD_ADAPTER(Prediction);
+  RECORD_ADAPTER(TrafficLightDetection);
+  RECORD_ADAPTER(RoutingRequest);
+  RECORD_ADAPTER(RoutingResponse);
+  RECORD_ADAPTER(RelativeOdometry);
+  RECORD_ADAPTER(InsStat);
+  RECORD_ADAPTER(InsStatus);
+  RECORD_ADAPTER(GnssStatus);
+  RECORD_ADAPTER(SystemStatus);
+  RECORD_ADAPTER(StaticInfo);
+  RECORD_ADAPTER(Mobileye);
+  RECORD_ADAPTER(DelphiESR);
+  RECORD_ADAPTER(ContiRadar);
+  RECORD_ADAPTER(CompressedImage);
+  RECORD_ADAPTER(GnssRtkObs);
+  RECORD_ADAPTER(GnssRtkEph);
+  RECORD_ADAPTER(GnssBestPose);
+  RECORD_ADAPTER(LocalizationMsfGnss);
+  RECORD_ADAPTER(LocalizationMsfLidar);
+  RECORD_ADAPTER(LocalizationMsfSinsPva);
+  RECORD_ADAPTER(LocalizationMsfStatus);
+
+  return Status::OK();
+}
+
+#undef RECORD_ADAPTER
+
+void Recorder::Stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closing_.valid()) {
+    closing_.get();
+  }
+  if (writer_ != nullptr) {
+    writer_->Close();
+    writer_.reset();
+  }
+}
+
+template <typename T>
+void Recorder::Record(const std::string &topic, const T &message) {
+  std::string content;
+  Serialize(message, &content);
+  Write(topic, content);
+}
+
+void Recorder::Write(const std::string &topic, const std::string &content) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_ == nullptr) {
+    return;
+  }
+  // Record files require non-decreasing times, even if the clock is adjusted.
+  last_time_ =
+      std::max(last_time_, apollo::common::time::Clock::NowInSeconds());
+  if (last_time_ - file_begin_time_ >= FLAGS_recorder_split_duration &&
+      !OpenNewFile(last_time_)) {
+    // Keep writing to the current file, and retry after another split
+    // duration.
+    file_begin_time_ = last_time_;
+  }
+  writer_->Write(topic, last_time_, content);
+}
+
+bool Recorder::OpenNewFile(const double time) {
+  const std::time_t seconds = static_cast<std::time_t>(time);
+  std::tm local_time;
+  localtime_r(&seconds, &local_time);
+  char name[32];
+  std::strftime(name, sizeof(name), "%Y%m%d%H%M%S.record", &local_time);
+  const std::string path = FLAGS_recorder_dir + "/" + name;
+
+  std::unique_ptr<record::RecordWriter> writer(new record::RecordWriter(
+      FLAGS_recorder_chunk_size, FLAGS_recorder_compress,
+      FLAGS_recorder_compress_threads));
+  if (!writer->Open(path)) {
+    AERROR << "Unable to open record file " << path;
+    return false;
+  }
+  AINFO << "Recording to " << path;
+
+  // Closing flushes the chunks still being compressed, which should not block
+  // the callbacks.
+  if (closing_.valid()) {
+    closing_.get();
+  }
+  if (writer_ != nullptr) {
+    std::shared_ptr<record::RecordWriter> previous(std::move(writer_));
+    closing_ = std::async(std::launch::async,
+                          [previous]() { return previous->Close(); });
+  }
+  writer_ = std::move(writer);
+  file_begin_time_ = time;
+  return true;
+}
+
+}  // namespace data
+}  // namespace apollo
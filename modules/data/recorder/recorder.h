@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DATA_RECORDER_RECORDER_H_
+#define MODULES_DATA_RECORDER_RECORDER_H_
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "modules/common/apollo_app.h"
+#include "modules/data/record/record_writer.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @class Recorder
+ *
+ * @brief Records the messages of all the topics enabled in its adapter config
+ * into indexed record files, which are split by duration.
+ */
+class Recorder : public apollo::common::ApolloApp {
+ public:
+  std::string Name() const override;
+  apollo::common::Status Init() override;
+  apollo::common::Status Start() override;
+  void Stop() override;
+
+ private:
+  template <typename T>
+  void Record(const std::string &topic, const T &message);
+
+  // Writes a serialized message, starting a new file when the current one is
+  // long enough.
+  void Write(const std::string &topic, const std::string &content);
+
+  // Closes the current file in the background and opens a new one.
+  bool OpenNewFile(const double time);
+
+  std::mutex mutex_;
+  std::unique_ptr<record::RecordWriter> writer_;
+  double file_begin_time_ = 0.0;
+  double last_time_ = 0.0;
+  // Closing of the previous file.
+  std::future<bool> closing_;
+};
+
+}  // namespace data
+}  // namespace apollo
+
+#endif  // MODULES_DATA_RECORDER_RECORDER_H_
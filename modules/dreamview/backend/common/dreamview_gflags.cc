@@ -37,6 +37,21 @@ DEFINE_bool(enable_sim_control, false,
             "Whether to enable SimControl to publish localization and chassis "
             "message.");
 
+DEFINE_bool(sim_control_virtual_clock, false,
+            "Whether SimControl drives a virtual clock on /clock as fast as "
+            "planning keeps up, instead of following the wall clock. It "
+            "takes over the ROS time of the whole dreamview process. The "
+            "other modules must run with --use_ros_time and the ROS parameter "
+            "/use_sim_time set to true.");
+
+DEFINE_double(sim_control_planning_period, 0.1,
+              "Virtual time (s) SimControl advances before waiting for a new "
+              "planning trajectory. Should match the planning loop period.");
+
+DEFINE_double(sim_control_planning_timeout, 1.0,
+              "Wall time (s) SimControl waits for planning before advancing "
+              "the virtual clock anyway.");
+
 DEFINE_bool(routing_from_file, false,
             "Whether Dreamview reads initial routing response from file.");
 
@@ -31,6 +31,12 @@ DECLARE_string(server_ports);
 
 DECLARE_bool(enable_sim_control);
 
+DECLARE_bool(sim_control_virtual_clock);
+
+DECLARE_double(sim_control_planning_period);
+
+DECLARE_double(sim_control_planning_timeout);
+
 DECLARE_bool(routing_from_file);
 
 DECLARE_string(routing_response_file);
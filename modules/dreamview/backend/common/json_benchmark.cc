@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "modules/common/util/json_util.h"
+#include "modules/dreamview/proto/simulation_world.pb.h"
+#include "modules/map/proto/map.pb.h"
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+using apollo::common::util::JsonUtil;
+
+// A map of range(0) lanes with 100 points on each curve.
+apollo::hdmap::Map MapData(const int num_lanes) {
+  apollo::hdmap::Map map;
+  for (int i = 0; i < num_lanes; ++i) {
+    auto *lane = map.add_lane();
+    lane->mutable_id()->set_id("lane_" + std::to_string(i));
+    for (auto *curve : {lane->mutable_central_curve(),
+                        lane->mutable_left_boundary()->mutable_curve(),
+                        lane->mutable_right_boundary()->mutable_curve()}) {
+      auto *segment = curve->add_segment();
+      segment->set_s(0.0);
+      segment->set_length(50.0);
+      for (int j = 0; j < 100; ++j) {
+        auto *point = segment->mutable_line_segment()->add_point();
+        point->set_x(587000.123456 + i * 3.5 + j * 0.013);
+        point->set_y(4141000.654321 + j * 0.5);
+      }
+    }
+  }
+  return map;
+}
+
+// A world of range(0) obstacles with predictions and a planning trajectory.
+SimulationWorld World(const int num_objects) {
+  SimulationWorld world;
+  world.set_timestamp_sec(1513807824.58);
+  world.set_sequence_num(42);
+  for (int i = 0; i < num_objects; ++i) {
+    auto *object = world.add_object();
+    object->set_id(std::to_string(i));
+    object->set_position_x(100.0 + i * 1.7);
+    object->set_position_y(-50.0 + i * 0.3);
+    object->set_heading(0.01 * i);
+    for (int j = 0; j < 8; ++j) {
+      auto *point = object->add_polygon_point();
+      point->set_x(object->position_x() + j * 0.25);
+      point->set_y(object->position_y() - j * 0.25);
+    }
+    auto *prediction = object->add_prediction();
+    prediction->set_probability(0.75);
+    for (int j = 0; j < 50; ++j) {
+      auto *point = prediction->add_predicted_trajectory();
+      point->set_x(object->position_x() + j * 0.1);
+      point->set_y(object->position_y() + j * 0.1);
+    }
+  }
+  for (int i = 0; i < 200; ++i) {
+    auto *point = world.add_planning_trajectory();
+    point->set_position_x(i * 0.37);
+    point->set_position_y(i * 0.11);
+    point->set_heading(0.001 * i);
+  }
+  return world;
+}
+
+void BM_MapDataToTypedJson(benchmark::State &state) {
+  const auto map = MapData(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(JsonUtil::ProtoToTypedJson("MapData", map).dump());
+  }
+}
+
+void BM_MapDataToTypedJsonString(benchmark::State &state) {
+  const auto map = MapData(state.range(0));
+  std::string json;
+  while (state.KeepRunning()) {
+    JsonUtil::ProtoToTypedJsonString("MapData", map, &json);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void BM_SimulationWorldToTypedJson(benchmark::State &state) {
+  const auto world = World(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        JsonUtil::ProtoToTypedJson("SimulationWorld", world).dump());
+  }
+}
+
+void BM_SimulationWorldToTypedJsonString(benchmark::State &state) {
+  const auto world = World(state.range(0));
+  std::string json;
+  while (state.KeepRunning()) {
+    JsonUtil::ProtoToTypedJsonString("SimulationWorld", world, &json);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+BENCHMARK(BM_MapDataToTypedJson)->Arg(10)->Arg(100);
+BENCHMARK(BM_MapDataToTypedJsonString)->Arg(10)->Arg(100);
+BENCHMARK(BM_SimulationWorldToTypedJson)->Arg(10)->Arg(100);
+BENCHMARK(BM_SimulationWorldToTypedJsonString)->Arg(10)->Arg(100);
+
+}  // namespace
+}  // namespace dreamview
+}  // namespace apollo
+
+BENCHMARK_MAIN();
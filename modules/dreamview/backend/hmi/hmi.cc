@@ -17,6 +17,7 @@
 #include "modules/dreamview/backend/hmi/hmi.h"
 
 #include <cstdlib>
+#include <fstream>
 #include <thread>
 #include <vector>
 
@@ -175,10 +176,14 @@ void HMI::RegisterMessageHandlers() {
   // Send current config and status to new HMI client.
   websocket_->RegisterConnectionReadyHandler(
       [this](WebSocketHandler::Connection *conn) {
-        websocket_->SendData(
-            conn, JsonUtil::ProtoToTypedJson("HMIConfig", config_).dump());
-        websocket_->SendData(
-            conn, JsonUtil::ProtoToTypedJson("HMIStatus", status_).dump());
+        std::string json;
+        JsonUtil::ProtoToTypedJsonString("HMIConfig", config_, &json);
+        websocket_->SendData(conn, json);
+        {
+          std::lock_guard<std::mutex> lock(status_mutex_);
+          JsonUtil::ProtoToTypedJsonString("HMIStatus", status_, &json);
+        }
+        websocket_->SendData(conn, json);
       });
 
   // HMI client asks for executing module command.
@@ -288,7 +293,10 @@ void HMI::RegisterMessageHandlers() {
       [this](const monitor::SystemStatus &system_status) {
         if (Clock::NowInSeconds() - system_status.header().timestamp_sec() <
             FLAGS_system_status_lifetime_seconds) {
-          *status_.mutable_system_status() = system_status;
+          {
+            std::lock_guard<std::mutex> lock(status_mutex_);
+            *status_.mutable_system_status() = system_status;
+          }
           BroadcastHMIStatus();
         }
       });
@@ -297,8 +305,12 @@ void HMI::RegisterMessageHandlers() {
 void HMI::BroadcastHMIStatus() const {
   // In unit tests, we may leave websocket_ as NULL and skip broadcasting.
   if (websocket_) {
-    websocket_->BroadcastData(
-        JsonUtil::ProtoToTypedJson("HMIStatus", status_).dump());
+    std::string json;
+    {
+      std::lock_guard<std::mutex> lock(status_mutex_);
+      JsonUtil::ProtoToTypedJsonString("HMIStatus", status_, &json);
+    }
+    websocket_->BroadcastData(json);
   }
 }
 
@@ -323,7 +335,12 @@ int HMI::RunComponentCommand(const Map<std::string, Component> &components,
 }
 
 void HMI::RunModeCommand(const std::string &command_name) {
-  RunModeCommand(status_.current_mode(), command_name);
+  std::string mode;
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    mode = status_.current_mode();
+  }
+  RunModeCommand(mode, command_name);
 }
 
 void HMI::RunModeCommand(const std::string &mode,
@@ -348,58 +365,144 @@ void HMI::ChangeDrivingModeTo(const std::string &new_mode) {
 }
 
 void HMI::ChangeMapTo(const std::string &map_name) {
-  if (status_.current_map() == map_name) {
-    return;
-  }
   const auto *map_dir = FindOrNull(config_.available_maps(), map_name);
   if (map_dir == nullptr) {
     AERROR << "Unknown map " << map_name;
     return;
   }
-  status_.set_current_map(map_name);
-  apollo::common::KVDB::Put("apollo:dreamview:map", map_name);
-
-  FLAGS_map_dir = *map_dir;
-  // Append new map_dir flag to global flagfile.
-  std::ofstream fout(FLAGS_global_flagfile, std::ios_base::app);
-  CHECK(fout) << "Fail to open " << FLAGS_global_flagfile;
-  fout << "\n--map_dir=" << *map_dir << std::endl;
-  // Also reload simulation map.
-  CHECK(map_service_->ReloadMap(true)) << "Failed to load map from "
-                                       << *map_dir;
-  RunModeCommand("stop");
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (status_.has_pending_map() ? status_.pending_map() == map_name
+                                  : status_.current_map() == map_name) {
+      return;
+    }
+    status_.set_pending_map(map_name);
+  }
   BroadcastHMIStatus();
+  const std::string dir = *map_dir;
+  switch_thread_.Push(
+      [this, map_name, dir](int) { SwitchMap(map_name, dir); });
 }
 
 void HMI::ChangeVehicleTo(const std::string &vehicle_name) {
-  if (status_.current_vehicle() == vehicle_name) {
-    return;
-  }
   const auto *vehicle = FindOrNull(config_.available_vehicles(), vehicle_name);
   if (vehicle == nullptr) {
     AERROR << "Unknown vehicle " << vehicle_name;
     return;
   }
-  status_.set_current_vehicle(vehicle_name);
-  apollo::common::KVDB::Put("apollo:dreamview:vehicle", vehicle_name);
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (status_.has_pending_vehicle()
+            ? status_.pending_vehicle() == vehicle_name
+            : status_.current_vehicle() == vehicle_name) {
+      return;
+    }
+    status_.set_pending_vehicle(vehicle_name);
+  }
+  BroadcastHMIStatus();
+  const std::string dir = *vehicle;
+  switch_thread_.Push([this, vehicle_name, dir](int) {
+    SwitchVehicle(vehicle_name, dir);
+  });
+}
+
+void HMI::SwitchMap(const std::string &map_name, const std::string &map_dir) {
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (status_.pending_map() != map_name) {
+      return;
+    }
+  }
+  UpdateSwitchProgress(0.0);
+
+  // The current map keeps serving until the new one is loaded, and
+  // FLAGS_map_dir is only changed when it is swapped in.
+  const bool loaded = map_service_->ReloadMap(
+      true, map_dir,
+      [this](const double progress) { UpdateSwitchProgress(progress); });
+  if (loaded) {
+    apollo::common::KVDB::Put("apollo:dreamview:map", map_name);
+    // Append new map_dir flag to global flagfile.
+    std::ofstream fout(FLAGS_global_flagfile, std::ios_base::app);
+    CHECK(fout) << "Fail to open " << FLAGS_global_flagfile;
+    fout << "\n--map_dir=" << map_dir << std::endl;
+  } else {
+    AERROR << "Failed to load map from " << map_dir;
+  }
 
-  CHECK(VehicleManager::instance()->UseVehicle(*vehicle));
-  RunModeCommand("stop");
-  // Check available updates for current vehicle.
-  // CheckOTAUpdates();
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (loaded) {
+      status_.set_current_map(map_name);
+    }
+    if (status_.pending_map() == map_name) {
+      status_.clear_pending_map();
+    }
+    status_.clear_switch_progress();
+  }
+  if (loaded) {
+    RunModeCommand("stop");
+  }
   BroadcastHMIStatus();
 }
 
-void HMI::ChangeModeTo(const std::string &mode_name) {
-  if (status_.current_mode() == mode_name) {
-    return;
+void HMI::SwitchVehicle(const std::string &vehicle_name,
+                        const std::string &vehicle_dir) {
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (status_.pending_vehicle() != vehicle_name) {
+      return;
+    }
+  }
+  UpdateSwitchProgress(0.0);
+
+  const bool used = VehicleManager::instance()->UseVehicle(vehicle_dir);
+  if (used) {
+    apollo::common::KVDB::Put("apollo:dreamview:vehicle", vehicle_name);
+  } else {
+    AERROR << "Failed to use vehicle " << vehicle_dir;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (used) {
+      status_.set_current_vehicle(vehicle_name);
+    }
+    if (status_.pending_vehicle() == vehicle_name) {
+      status_.clear_pending_vehicle();
+    }
+    status_.clear_switch_progress();
+  }
+  if (used) {
+    RunModeCommand("stop");
+    // Check available updates for current vehicle.
+    // CheckOTAUpdates();
   }
+  BroadcastHMIStatus();
+}
+
+void HMI::UpdateSwitchProgress(const double progress) {
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    status_.set_switch_progress(progress);
+  }
+  BroadcastHMIStatus();
+}
+
+void HMI::ChangeModeTo(const std::string &mode_name) {
   if (!ContainsKey(config_.modes(), mode_name)) {
     AERROR << "Unknown mode " << mode_name;
     return;
   }
-  const std::string previous_mode = status_.current_mode();
-  status_.set_current_mode(mode_name);
+  std::string previous_mode;
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (status_.current_mode() == mode_name) {
+      return;
+    }
+    previous_mode = status_.current_mode();
+    status_.set_current_mode(mode_name);
+  }
   apollo::common::KVDB::Put("apollo:dreamview:mode", mode_name);
 
   RunModeCommand(previous_mode, "stop");
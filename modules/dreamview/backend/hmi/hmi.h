@@ -17,9 +17,11 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_HMI_HMI_H_
 #define MODULES_DREAMVIEW_BACKEND_HMI_HMI_H_
 
+#include <mutex>
 #include <string>
 
 #include "gtest/gtest_prod.h"
+#include "modules/common/util/ctpl_stl.h"
 #include "modules/dreamview/backend/handlers/websocket.h"
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/proto/hmi_config.pb.h"
@@ -53,20 +55,35 @@ class HMI {
   void RunModeCommand(const std::string &mode, const std::string &command_name);
 
   static void ChangeDrivingModeTo(const std::string &new_mode);
+  // Map and vehicle changes are queued as background switches, so that the
+  // websocket threads are not blocked while loading them.
   void ChangeMapTo(const std::string &map_name);
   void ChangeVehicleTo(const std::string &vehicle_name);
   void ChangeModeTo(const std::string &mode_name);
 
+  // Background switches, which are skipped if a later change superseded them.
+  void SwitchMap(const std::string &map_name, const std::string &map_dir);
+  void SwitchVehicle(const std::string &vehicle_name,
+                     const std::string &vehicle_dir);
+  void UpdateSwitchProgress(const double progress);
+
   // Check if there is available updates.
   void CheckOTAUpdates();
 
   HMIConfig config_;
   HMIStatus status_;
+  // Guards status_, which is updated from websocket, callback and switch
+  // threads.
+  mutable std::mutex status_mutex_;
 
   // No ownership.
   WebSocketHandler *websocket_;
   MapService *map_service_;
 
+  // Runs the map and vehicle switches one at a time. Declared last so that
+  // pending switches finish before the other members are destroyed.
+  apollo::common::util::ThreadPool switch_thread_{1};
+
   FRIEND_TEST(HMITest, RunComponentCommand);
 };
 
@@ -110,33 +110,69 @@ nlohmann::json MapElementIds::Json() const {
 }
 
 MapService::MapService(bool use_sim_map) : use_sim_map_(use_sim_map) {
-  ReloadMap(false);
+  ReloadMap(false, FLAGS_map_dir);
 }
 
-bool MapService::ReloadMap(bool force_reload) {
-  boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-  bool ret = true;
+bool MapService::ReloadMap(bool force_reload, const std::string &map_dir,
+                           const ProgressCallback &progress_callback) {
+  const auto report_progress = [&progress_callback](const double progress) {
+    if (progress_callback) {
+      progress_callback(progress);
+    }
+  };
+
+  std::unique_ptr<hdmap::HDMap> hdmap;
+  std::unique_ptr<hdmap::HDMap> sim_map;
   if (force_reload) {
-    ret = HDMapUtil::ReloadMaps();
+    hdmap = hdmap::CreateMap(hdmap::BaseMapFile(map_dir));
+    if (hdmap == nullptr) {
+      return false;
+    }
+    report_progress(use_sim_map_ ? 0.5 : 0.9);
+    if (use_sim_map_) {
+      sim_map = hdmap::CreateMap(SimMapFile(map_dir));
+      if (sim_map == nullptr) {
+        return false;
+      }
+      report_progress(0.9);
+    }
   }
-  hdmap_ = HDMapUtil::BaseMapPtr();
-  sim_map_ = use_sim_map_ ? HDMapUtil::SimMapPtr() : HDMapUtil::BaseMapPtr();
-  if (hdmap_ == nullptr || sim_map_ == nullptr) {
-    pending_ = true;
-    AWARN << "No map data available yet.";
-  } else {
-    pending_ = false;
+  double x_offset = 0.0;
+  double y_offset = 0.0;
+  ReadOffsets(map_dir, &x_offset, &y_offset);
+
+  {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    if (force_reload) {
+      // The previous maps are released after unlocking.
+      reloaded_hdmap_.swap(hdmap);
+      reloaded_sim_map_.swap(sim_map);
+      hdmap_ = reloaded_hdmap_.get();
+      sim_map_ = use_sim_map_ ? reloaded_sim_map_.get() : hdmap_;
+      FLAGS_map_dir = map_dir;
+    } else {
+      hdmap_ = HDMapUtil::BaseMapPtr();
+      sim_map_ =
+          use_sim_map_ ? HDMapUtil::SimMapPtr() : HDMapUtil::BaseMapPtr();
+    }
+    if (hdmap_ == nullptr || sim_map_ == nullptr) {
+      pending_ = true;
+      AWARN << "No map data available yet.";
+    } else {
+      pending_ = false;
+    }
+    x_offset_ = x_offset;
+    y_offset_ = y_offset;
   }
-
-  // Update the x,y-offsets if present.
-  UpdateOffsets();
-  return ret;
+  AINFO << "Updated with map: x_offset " << x_offset << ", y_offset "
+        << y_offset;
+  report_progress(1.0);
+  return true;
 }
 
-void MapService::UpdateOffsets() {
-  x_offset_ = 0.0;
-  y_offset_ = 0.0;
-  std::ifstream ifs(FLAGS_map_dir + meta_filename_);
+void MapService::ReadOffsets(const std::string &map_dir, double *x_offset,
+                             double *y_offset) const {
+  std::ifstream ifs(map_dir + meta_filename_);
   if (!ifs.is_open()) {
     AINFO << "Failed to open map meta file: " << meta_filename_;
   } else {
@@ -147,36 +183,34 @@ void MapService::UpdateOffsets() {
     for (auto it = json.begin(); it != json.end(); ++it) {
       auto val = it.value();
       if (val.is_object()) {
-        auto x_offset = val.find("xoffset");
-        if (x_offset == val.end()) {
+        auto x_offset_iter = val.find("xoffset");
+        if (x_offset_iter == val.end()) {
           AWARN << "Cannot find x_offset for this map " << it.key();
           continue;
         }
 
-        if (!x_offset->is_number()) {
+        if (!x_offset_iter->is_number()) {
           AWARN << "Expect x_offset with type 'number', but was "
-                << x_offset->type_name();
+                << x_offset_iter->type_name();
           continue;
         }
-        x_offset_ = x_offset.value();
+        *x_offset = x_offset_iter.value();
 
-        auto y_offset = val.find("yoffset");
-        if (y_offset == val.end()) {
+        auto y_offset_iter = val.find("yoffset");
+        if (y_offset_iter == val.end()) {
           AWARN << "Cannot find y_offset for this map " << it.key();
           continue;
         }
 
-        if (!y_offset->is_number()) {
+        if (!y_offset_iter->is_number()) {
           AWARN << "Expect y_offset with type 'number', but was "
-                << y_offset->type_name();
+                << y_offset_iter->type_name();
           continue;
         }
-        y_offset_ = y_offset.value();
+        *y_offset = y_offset_iter.value();
       }
     }
   }
-  AINFO << "Updated with map: x_offset " << x_offset_ << ", y_offset "
-        << y_offset_;
 }
 
 MapElementIds MapService::CollectMapElementIds(const PointENU &point,
@@ -21,6 +21,8 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 #define MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,6 +67,9 @@ struct MapElementIds {
 
 class MapService {
  public:
+  // Called with the fraction in [0, 1] of a map reload that is done.
+  using ProgressCallback = std::function<void(double progress)>;
+
   explicit MapService(bool use_sim_map = true);
 
   inline double GetXOffset() const { return x_offset_; }
@@ -98,11 +103,16 @@ class MapService {
   bool ConstructLaneWayPoint(const double x, const double y,
                              routing::LaneWaypoint *laneWayPoint) const;
 
-  // Reload map from current FLAGS_map_dir.
-  bool ReloadMap(bool force_reload);
+  // Reload map from map_dir. A forced reload loads the map files without
+  // holding the lock, so the current map keeps serving queries until the new
+  // one is swapped in, and FLAGS_map_dir is only set to map_dir with the swap.
+  // If it fails, the current map and FLAGS_map_dir are kept.
+  bool ReloadMap(bool force_reload, const std::string &map_dir,
+                 const ProgressCallback &progress_callback = nullptr);
 
  private:
-  void UpdateOffsets();
+  void ReadOffsets(const std::string &map_dir, double *x_offset,
+                   double *y_offset) const;
   bool GetNearestLane(const double x, const double y,
                       apollo::hdmap::LaneInfoConstPtr *nearest_lane,
                       double *nearest_s, double *nearest_l) const;
@@ -117,6 +127,10 @@ class MapService {
   const hdmap::HDMap *hdmap_ = nullptr;
   // A downsampled map for dreamview frontend display.
   const hdmap::HDMap *sim_map_ = nullptr;
+  // Maps loaded by forced reloads, which are owned by the service instead of
+  // HDMapUtil, so that they can be loaded while the current ones serve.
+  std::unique_ptr<hdmap::HDMap> reloaded_hdmap_;
+  std::unique_ptr<hdmap::HDMap> reloaded_sim_map_;
   bool pending_ = true;
   const std::string meta_filename_ = "/metaInfo.json";
   double x_offset_ = 0.0;
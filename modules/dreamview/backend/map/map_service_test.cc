@@ -16,6 +16,12 @@
 
 #include "modules/dreamview/backend/map/map_service.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -102,5 +108,59 @@ TEST_F(MapServiceTest, GetStartPoint) {
   EXPECT_DOUBLE_EQ(0.0, start_point.z());
 }
 
+TEST_F(MapServiceTest, ReloadMapKeepsServing) {
+  PointENU p;
+  p.set_x(0.0);
+  p.set_y(0.0);
+
+  // Query the map as the websocket handlers do while it is reloaded, and
+  // measure how long the queries are blocked. The reload is held in the
+  // middle of loading for much longer than the queries may be blocked, as
+  // the test map loads too fast to catch a lock held while loading.
+  const std::chrono::milliseconds kLoadPause(200);
+  const std::chrono::duration<double, std::milli> kMaxLatency(50.0);
+  std::vector<double> progresses;
+  std::atomic<bool> reloaded(false);
+  std::thread reload_thread([this, &progresses, &reloaded, &kLoadPause]() {
+    EXPECT_TRUE(map_service->ReloadMap(
+        true, "modules/dreamview/backend/testdata",
+        [&progresses, &kLoadPause](const double progress) {
+          progresses.push_back(progress);
+          if (progress < 1.0) {
+            std::this_thread::sleep_for(kLoadPause);
+          }
+        }));
+    reloaded = true;
+  });
+  int num_queries = 0;
+  std::chrono::duration<double, std::milli> max_latency(0.0);
+  while (!reloaded || num_queries == 0) {
+    const auto start = std::chrono::steady_clock::now();
+    const MapElementIds map_element_ids =
+        map_service->CollectMapElementIds(p, 20000.0);
+    max_latency =
+        std::max(max_latency, std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start));
+    EXPECT_THAT(map_element_ids.lane, UnorderedElementsAre("l1"));
+    ++num_queries;
+  }
+  reload_thread.join();
+  AINFO << num_queries << " queries during reload, max latency "
+        << max_latency.count() << " ms";
+  EXPECT_GT(num_queries, 1);
+  EXPECT_LT(max_latency, kMaxLatency);
+
+  ASSERT_FALSE(progresses.empty());
+  EXPECT_TRUE(std::is_sorted(progresses.begin(), progresses.end()));
+  EXPECT_DOUBLE_EQ(1.0, progresses.back());
+
+  // A failed reload keeps the current map and map directory.
+  EXPECT_FALSE(
+      map_service->ReloadMap(true, "modules/dreamview/backend/not_exist"));
+  EXPECT_EQ("modules/dreamview/backend/testdata", FLAGS_map_dir);
+  EXPECT_THAT(map_service->CollectMapElementIds(p, 20000.0).lane,
+              UnorderedElementsAre("l1"));
+}
+
 }  // namespace dreamview
 }  // namespace apollo
@@ -16,12 +16,14 @@
 
 #include "modules/dreamview/backend/sim_control/sim_control.h"
 
+#include <chrono>
 #include <cmath>
 
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
+#include "rosgraph_msgs/Clock.h"
 
 namespace apollo {
 namespace dreamview {
@@ -66,7 +68,10 @@ SimControl::SimControl(const MapService* map_service)
       received_planning_(false),
       planning_count_(-1),
       re_routing_triggered_(false),
-      enabled_(FLAGS_enable_sim_control) {}
+      enabled_(FLAGS_enable_sim_control),
+      use_virtual_clock_(FLAGS_sim_control_virtual_clock) {}
+
+SimControl::~SimControl() { Stop(); }
 
 void SimControl::Init(bool set_start_point, double start_velocity,
                       double start_acceleration) {
@@ -75,9 +80,24 @@ void SimControl::Init(bool set_start_point, double start_velocity,
   AdapterManager::AddRoutingResponseCallback(&SimControl::OnRoutingResponse,
                                              this);
 
-  // Start timer to publish localization and chassis messages.
-  sim_control_timer_ = AdapterManager::CreateTimer(
-      ros::Duration(kSimControlInterval), &SimControl::TimerCallback, this);
+  if (use_virtual_clock_) {
+    // Start from the wall clock, then only the virtual clock moves time on.
+    virtual_time_ = Clock::NowInSeconds();
+    last_planning_wait_ = virtual_time_;
+    if (AdapterManager::IsRos()) {
+      ros::NodeHandle node_handle;
+      clock_publisher_ =
+          node_handle.advertise<rosgraph_msgs::Clock>("/clock", 1);
+      Clock::SetMode(Clock::ROS);
+    } else {
+      Clock::SetMode(Clock::MOCK);
+    }
+    SetVirtualTime(virtual_time_);
+  } else {
+    // Start timer to publish localization and chassis messages.
+    sim_control_timer_ = AdapterManager::CreateTimer(
+        ros::Duration(kSimControlInterval), &SimControl::TimerCallback, this);
+  }
 
   if (set_start_point) {
     apollo::common::PointENU start_point;
@@ -85,6 +105,7 @@ void SimControl::Init(bool set_start_point, double start_velocity,
       AWARN << "Failed to get a dummy start point from map!";
       return;
     }
+    std::lock_guard<std::mutex> lock(mutex_);
     SetStartPoint(start_point.x(), start_point.y());
   }
 
@@ -118,6 +139,11 @@ void SimControl::SetStartPoint(const double x, const double y) {
 }
 
 void SimControl::ClearPlanning() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ResetPlanning();
+}
+
+void SimControl::ResetPlanning() {
   current_trajectory_.Clear();
   received_planning_ = false;
   planning_count_ = 0;
@@ -127,26 +153,54 @@ void SimControl::OnRoutingResponse(const RoutingResponse& routing) {
   CHECK_LE(2, routing.routing_request().waypoint_size());
   const auto& start_pose = routing.routing_request().waypoint(0).pose();
 
+  std::lock_guard<std::mutex> lock(mutex_);
   current_routing_header_ = routing.header();
 
   // If this is from a planning re-routing request, don't reset car's location.
   re_routing_triggered_ =
       routing.routing_request().header().module_name() == "planning";
   if (!re_routing_triggered_) {
-    ClearPlanning();
+    ResetPlanning();
     SetStartPoint(start_pose.x(), start_pose.y());
   }
 }
 
 void SimControl::Start() {
-  if (enabled_) {
+  if (!enabled_) {
+    return;
+  }
+  if (!use_virtual_clock_) {
     sim_control_timer_.start();
+  } else if (!AdapterManager::IsRos()) {
+    // Without ROS the virtual time is kept by the MOCK Clock, which must not
+    // be set while other threads read it, so it is only stepped by the owner.
+    AWARN << "The virtual clock only runs on its own thread with ROS.";
+  } else if (!virtual_clock_running_.exchange(true)) {
+    virtual_clock_thread_.reset(
+        new std::thread(&SimControl::RunVirtualClock, this));
   }
 }
 
-void SimControl::Stop() { sim_control_timer_.stop(); }
+void SimControl::Stop() {
+  sim_control_timer_.stop();
+  if (virtual_clock_running_.exchange(false)) {
+    planning_cv_.notify_all();
+    virtual_clock_thread_->join();
+    virtual_clock_thread_.reset();
+  }
+}
 
 void SimControl::OnPlanning(const apollo::planning::ADCTrajectory& trajectory) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_planning_time_ = trajectory.header().timestamp_sec();
+    UpdatePlanning(trajectory);
+  }
+  planning_cv_.notify_all();
+}
+
+void SimControl::UpdatePlanning(
+    const apollo::planning::ADCTrajectory& trajectory) {
   // Reset current trajectory and the indices upon receiving a new trajectory.
   // The routing SimControl owns must match with the one Planning has.
   if (re_routing_triggered_ ||
@@ -162,7 +216,7 @@ void SimControl::OnPlanning(const apollo::planning::ADCTrajectory& trajectory) {
       received_planning_ = true;
     }
   } else {
-    ClearPlanning();
+    ResetPlanning();
   }
 }
 
@@ -184,7 +238,68 @@ bool SimControl::NextPointWithinRange() {
 
 void SimControl::TimerCallback(const ros::TimerEvent& event) { RunOnce(); }
 
+void SimControl::RunVirtualClock() {
+  const double start_time = virtual_time_;
+  const auto wall_start_time = std::chrono::steady_clock::now();
+  for (int step = 1; virtual_clock_running_; ++step) {
+    StepVirtualClock();
+    if (step % kStepsPerSpeedReport == 0) {
+      const std::chrono::duration<double> wall_time =
+          std::chrono::steady_clock::now() - wall_start_time;
+      AINFO << "SimControl runs at "
+            << (virtual_time_ - start_time) / wall_time.count()
+            << " simulated seconds per wall second.";
+    }
+  }
+}
+
+void SimControl::StepVirtualClock() {
+  if (virtual_time_ - last_planning_wait_ >=
+      FLAGS_sim_control_planning_period) {
+    WaitForPlanning(last_planning_wait_);
+    last_planning_wait_ = virtual_time_;
+  }
+  SetVirtualTime(virtual_time_ + kSimControlInterval);
+  RunOnce();
+}
+
+void SimControl::SetVirtualTime(const double time) {
+  virtual_time_ = time;
+  if (AdapterManager::IsRos()) {
+    // Set our own clock directly instead of waiting for the /clock message.
+    rosgraph_msgs::Clock clock;
+    clock.clock.fromSec(time);
+    ros::Time::setNow(clock.clock);
+    clock_publisher_.publish(clock);
+  } else {
+    Clock::SetNow(apollo::common::time::From(time).time_since_epoch());
+  }
+}
+
+void SimControl::WaitForPlanning(const double since) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (latest_planning_time_ <= 0.0) {
+    // There is nothing to keep pace with before planning starts, so go at the
+    // speed of the wall clock.
+    planning_cv_.wait_for(
+        lock, std::chrono::duration<double>(FLAGS_sim_control_planning_period),
+        [this] {
+          return !virtual_clock_running_ || latest_planning_time_ > 0.0;
+        });
+    return;
+  }
+  if (!planning_cv_.wait_for(
+          lock,
+          std::chrono::duration<double>(FLAGS_sim_control_planning_timeout),
+          [this, since] {
+            return !virtual_clock_running_ || latest_planning_time_ > since;
+          })) {
+    AWARN << "No planning since " << since << ", advancing the clock anyway.";
+  }
+}
+
 void SimControl::RunOnce() {
+  std::lock_guard<std::mutex> lock(mutex_);
   // Result of the interpolation.
   double lambda = 0.0;
   auto current_time = Clock::NowInSeconds();
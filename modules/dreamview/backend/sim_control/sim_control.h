@@ -21,7 +21,12 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_SIM_CONTROL_SIM_CONTROL_H_
 #define MODULES_DREAMVIEW_BACKEND_SIM_CONTROL_SIM_CONTROL_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "gtest/gtest_prod.h"
 #include "modules/common/adapters/adapter_manager.h"
@@ -40,6 +45,19 @@ namespace dreamview {
  * @brief A module that simulates a 'perfect control' algorithm, which assumes
  * an ideal world where the car can be perfectly placed wherever the planning
  * asks it to be, with the expected speed, acceleration, etc.
+ *
+ * By default it follows the wall clock. With --sim_control_virtual_clock it
+ * drives a virtual clock instead, which moves on as soon as planning has
+ * produced a trajectory for the current planning period, so the simulation
+ * runs as fast as the modules allow. The clock is shared through the ROS
+ * /clock topic, so each ROS master runs its own simulation.
+ *
+ * The virtual clock takes over the process-wide time: it sets ros::Time with
+ * ros::Time::setNow and switches apollo::common::time::Clock to ROS mode, or
+ * to MOCK mode without ROS. Everything else in the process, e.g. the rest of
+ * dreamview, then sees the virtual time, and neither is restored afterwards.
+ * The MOCK clock is not thread-safe, so without ROS the virtual clock thread
+ * is not started and the clock only moves on with StepVirtualClock.
  */
 class SimControl {
  public:
@@ -49,6 +67,8 @@ class SimControl {
    */
   explicit SimControl(const MapService *map_service);
 
+  ~SimControl();
+
   /**
    * @brief setup callbacks and timer
    * @param set_start_point initialize localization.
@@ -57,13 +77,13 @@ class SimControl {
             double start_acceleration = 0.0);
 
   /**
-   * @brief Starts the timer to publish simulated localization and chassis
-   * messages.
+   * @brief Starts the timer, or the virtual clock thread with ROS, to publish
+   * simulated localization and chassis messages.
    */
   void Start();
 
   /**
-   * @brief Stops the timer.
+   * @brief Stops the timer or the virtual clock thread.
    */
   void Stop();
 
@@ -77,12 +97,21 @@ class SimControl {
    */
   void RunOnce();
 
+  /**
+   * @brief Advances the virtual clock by one step and publishes simulated
+   * localization and chassis at the new time. Once per planning period, waits
+   * for a new planning trajectory first.
+   */
+  void StepVirtualClock();
+
  private:
   void OnPlanning(const apollo::planning::ADCTrajectory &trajectory);
+  // Callers must hold mutex_.
+  void UpdatePlanning(const apollo::planning::ADCTrajectory &trajectory);
   void OnRoutingResponse(const apollo::routing::RoutingResponse &routing);
 
   // Reset the start point, which can be a dummy point on the map or received
-  // from the routing module.
+  // from the routing module. Callers must hold mutex_.
   void SetStartPoint(const double x, const double y);
 
   void Freeze();
@@ -92,6 +121,14 @@ class SimControl {
 
   void TimerCallback(const ros::TimerEvent &event);
 
+  void RunVirtualClock();
+  void SetVirtualTime(const double time);
+  // Waits until a trajectory newer than the given time is received.
+  void WaitForPlanning(const double since);
+
+  // Callers must hold mutex_.
+  void ResetPlanning();
+
   void PublishChassis(double lambda);
   void PublishLocalization(double lambda);
 
@@ -138,7 +175,27 @@ class SimControl {
 
   static constexpr int kPlanningCountToStart = 5;
 
+  // Guards the planning state above, which the ROS callbacks update while the
+  // timer or the virtual clock thread reads it.
+  std::mutex mutex_;
+  std::condition_variable planning_cv_;
+  // Header timestamp of the latest trajectory received, 0 if none.
+  double latest_planning_time_ = 0.0;
+
+  // Virtual clock mode, only touched by the virtual clock thread once started.
+  const bool use_virtual_clock_;
+  double virtual_time_ = 0.0;
+  // The virtual time of the last wait for planning.
+  double last_planning_wait_ = 0.0;
+  std::atomic<bool> virtual_clock_running_{false};
+  std::unique_ptr<std::thread> virtual_clock_thread_;
+  ros::Publisher clock_publisher_;
+
+  // Steps between two reports of the simulation speed.
+  static constexpr int kStepsPerSpeedReport = 1000;
+
   FRIEND_TEST(SimControlTest, Test);
+  FRIEND_TEST(SimControlTest, VirtualClock);
 };
 
 }  // namespace dreamview
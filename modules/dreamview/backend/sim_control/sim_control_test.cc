@@ -40,7 +40,11 @@ namespace dreamview {
 
 class SimControlTest : public ::testing::Test {
  public:
-  SimControlTest() {
+  SimControlTest()
+      : clock_mode_(Clock::mode()), ros_sim_time_(ros::Time::isSimTime()) {
+    if (ros_sim_time_) {
+      ros_now_ = ros::Time::now();
+    }
     FLAGS_enable_sim_control = false;
     FLAGS_map_dir = "modules/dreamview/backend/testdata";
     FLAGS_base_map_filename = "garage.bin";
@@ -84,9 +88,24 @@ class SimControlTest : public ::testing::Test {
     AdapterManager::Init(config);
   }
 
+  // The tests and the virtual clock take over the process-wide clocks, which
+  // are restored for the other tests.
+  virtual void TearDown() {
+    FLAGS_sim_control_virtual_clock = false;
+    Clock::SetMode(clock_mode_);
+    if (ros_sim_time_) {
+      ros::Time::setNow(ros_now_);
+    } else {
+      ros::Time::useSystemTime();
+    }
+  }
+
  protected:
   std::unique_ptr<MapService> map_service_;
   std::unique_ptr<SimControl> sim_control_;
+  const Clock::ClockMode clock_mode_;
+  const bool ros_sim_time_;
+  ros::Time ros_now_;
 };
 
 void SetTrajectory(const std::vector<double> &xs, const std::vector<double> &ys,
@@ -178,5 +197,48 @@ TEST_F(SimControlTest, Test) {
   }
 }
 
+TEST_F(SimControlTest, VirtualClock) {
+  FLAGS_enable_sim_control = false;
+  FLAGS_sim_control_virtual_clock = true;
+  Clock::SetMode(Clock::MOCK);
+  Clock::SetNow(apollo::common::time::From(100.0).time_since_epoch());
+  SimControl sim_control(map_service_.get());
+  sim_control.Init(false);
+  sim_control.SetStartPoint(1.0, 1.0);
+
+  planning::ADCTrajectory adc_trajectory;
+  SetTrajectory({1.0, 1.1, 1.2, 1.3, 1.4}, {1.0, 1.1, 1.2, 1.3, 1.4},
+                {40.0, 50.0, 60.0, 70.0, 80.0}, {40.0, 50.0, 60.0, 70.0, 80.0},
+                {0.2, 0.6, 0.8, 1.0, 1.5}, {1.0, 2.0, 3.0, 4.0, 5.0},
+                {0.0, 0.1, 0.2, 0.3, 0.4}, &adc_trajectory);
+  adc_trajectory.mutable_header()->set_timestamp_sec(100.0);
+  sim_control.OnPlanning(adc_trajectory);
+
+  // Time only moves on with the steps, however long they take.
+  sim_control.StepVirtualClock();
+  EXPECT_NEAR(100.01, Clock::NowInSeconds(), 1e-6);
+  EXPECT_NEAR(41.0,
+              AdapterManager::GetChassis()->GetLatestPublished()->speed_mps(),
+              1e-6);
+
+  for (int i = 0; i < 10; ++i) {
+    sim_control.StepVirtualClock();
+  }
+  EXPECT_NEAR(100.11, Clock::NowInSeconds(), 1e-6);
+  EXPECT_NEAR(51.0,
+              AdapterManager::GetChassis()->GetLatestPublished()->speed_mps(),
+              1e-6);
+  const auto &pose =
+      AdapterManager::GetLocalization()->GetLatestPublished()->pose();
+  EXPECT_NEAR(1.11, pose.position().x(), 1e-6);
+  EXPECT_NEAR(1.11, pose.position().y(), 1e-6);
+
+  // Without ROS no thread sets the MOCK clock behind the test's back.
+  sim_control.enabled_ = true;
+  sim_control.Start();
+  EXPECT_FALSE(sim_control.virtual_clock_running_);
+  EXPECT_NEAR(100.11, Clock::NowInSeconds(), 1e-6);
+}
+
 }  // namespace dreamview
 }  // namespace apollo
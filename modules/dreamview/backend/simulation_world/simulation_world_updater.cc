@@ -49,8 +49,9 @@ SimulationWorldUpdater::SimulationWorldUpdater(WebSocketHandler *websocket,
         if (iter != json.end()) {
           MapElementIds map_element_ids(*iter);
           auto retrieved = map_service_->RetrieveMapElements(map_element_ids);
-          websocket_->SendData(
-              conn, JsonUtil::ProtoToTypedJson("MapData", retrieved).dump());
+          std::string response;
+          JsonUtil::ProtoToTypedJsonString("MapData", retrieved, &response);
+          websocket_->SendData(conn, response);
         }
       });
 
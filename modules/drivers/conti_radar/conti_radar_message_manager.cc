@@ -45,6 +45,16 @@ ContiRadarMessageManager::ContiRadarMessageManager() {
   AddRecvProtocolData<ObjectGeneralInfo60B, true>();
   AddRecvProtocolData<ObjectListStatus60A, true>();
   AddRecvProtocolData<ObjectQualityInfo60C, true>();
+
+  static_cast<ObjectGeneralInfo60B *>(
+      protocol_data_map_[ObjectGeneralInfo60B::ID])
+      ->set_object_index(&object_index_);
+  static_cast<ObjectQualityInfo60C *>(
+      protocol_data_map_[ObjectQualityInfo60C::ID])
+      ->set_object_index(&object_index_);
+  static_cast<ObjectExtendedInfo60D *>(
+      protocol_data_map_[ObjectExtendedInfo60D::ID])
+      ->set_object_index(&object_index_);
 }
 
 void ContiRadarMessageManager::set_radar_conf(RadarConf radar_conf) {
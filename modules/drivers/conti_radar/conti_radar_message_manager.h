@@ -25,6 +25,7 @@
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
 #include "modules/drivers/canbus/can_comm/can_sender.h"
 #include "modules/drivers/canbus/can_comm/message_manager.h"
+#include "modules/drivers/conti_radar/protocol/object_index.h"
 #include "modules/drivers/conti_radar/protocol/radar_config_200.h"
 #include "modules/drivers/proto/conti_radar.pb.h"
 
@@ -58,6 +59,8 @@ class ContiRadarMessageManager : public MessageManager<ContiRadar> {
  private:
   bool is_configured_ = false;
   RadarConfig200 radar_config_;
+  // object id -> position in sensor_data_.contiobs for the current cycle
+  ObjectIndex object_index_;
   std::shared_ptr<CanClient> can_client_;
 };
 
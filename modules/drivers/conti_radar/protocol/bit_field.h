@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_BIT_FIELD_H_
+#define MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_BIT_FIELD_H_
+
+#include <cstdint>
+
+namespace apollo {
+namespace drivers {
+namespace conti_radar {
+
+// Conti radar signals are Motorola (big-endian) ordered. Once an 8-byte frame
+// is loaded as one big-endian word, every signal is a contiguous run of bits
+// and is extracted with a single shift and mask.
+struct BitField {
+  // position of the least significant bit in the frame word
+  int lsb;
+  // number of bits
+  int width;
+};
+
+// Describes a signal by the byte holding its most significant bit, the
+// position of that bit within the byte, and the signal width.
+constexpr BitField MakeBitField(const int msb_byte, const int msb_bit,
+                                const int width) {
+  return BitField{(7 - msb_byte) * 8 + msb_bit - width + 1, width};
+}
+
+inline uint64_t FrameToWord(const std::uint8_t* bytes, int32_t length) {
+  uint64_t word = 0;
+  for (int32_t i = 0; i < 8; ++i) {
+    word <<= 8;
+    if (i < length) {
+      word |= bytes[i];
+    }
+  }
+  return word;
+}
+
+inline int32_t ExtractBitField(const uint64_t word, const BitField& field) {
+  return static_cast<int32_t>((word >> field.lsb) &
+                              ((uint64_t{1} << field.width) - 1));
+}
+
+}  // namespace conti_radar
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_BIT_FIELD_H_
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/conti_radar/protocol/bit_field.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/drivers/canbus/common/byte.h"
+
+namespace apollo {
+namespace drivers {
+namespace conti_radar {
+
+using apollo::drivers::canbus::Byte;
+
+TEST(BitFieldTest, MakeBitField) {
+  const BitField field = MakeBitField(1, 7, 11);
+  EXPECT_EQ(45, field.lsb);
+  EXPECT_EQ(11, field.width);
+}
+
+TEST(BitFieldTest, MatchesByte) {
+  const uint8_t bytes[8] = {0x9a, 0x5c, 0xe3, 0x17, 0xb8, 0x4f, 0xd2, 0x61};
+  const uint64_t frame = FrameToWord(bytes, 8);
+  // a signal starting at the given bit of one byte and continuing into the
+  // most significant bits of the next byte, as in the conti radar frames
+  for (int byte = 0; byte < 7; ++byte) {
+    for (int msb_bit = 0; msb_bit < 8; ++msb_bit) {
+      for (int next_bits = 0; next_bits <= 8; ++next_bits) {
+        Byte t0(bytes + byte);
+        int32_t expected = t0.get_byte(0, msb_bit + 1);
+        if (next_bits > 0) {
+          Byte t1(bytes + byte + 1);
+          expected <<= next_bits;
+          expected |= t1.get_byte(8 - next_bits, next_bits);
+        }
+        const BitField field =
+            MakeBitField(byte, msb_bit, msb_bit + 1 + next_bits);
+        EXPECT_EQ(expected, ExtractBitField(frame, field));
+      }
+    }
+  }
+}
+
+TEST(BitFieldTest, ShortFrame) {
+  const uint8_t bytes[2] = {0xff, 0xff};
+  const uint64_t frame = FrameToWord(bytes, 2);
+  EXPECT_EQ(0xff, ExtractBitField(frame, MakeBitField(1, 7, 8)));
+  EXPECT_EQ(0, ExtractBitField(frame, MakeBitField(2, 7, 8)));
+}
+
+}  // namespace conti_radar
+}  // namespace drivers
+}  // namespace apollo
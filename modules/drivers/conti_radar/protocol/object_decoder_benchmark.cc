@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <array>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/time/time.h"
+#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/conti_radar/protocol/const_vars.h"
+#include "modules/drivers/conti_radar/protocol/object_extended_info_60d.h"
+#include "modules/drivers/conti_radar/protocol/object_general_info_60b.h"
+#include "modules/drivers/conti_radar/protocol/object_index.h"
+#include "modules/drivers/conti_radar/protocol/object_list_status_60a.h"
+#include "modules/drivers/conti_radar/protocol/object_quality_info_60c.h"
+
+namespace apollo {
+namespace drivers {
+namespace conti_radar {
+namespace {
+
+using apollo::drivers::canbus::Byte;
+
+typedef std::array<uint8_t, 8> Frame;
+
+// The CAN frames of one radar cycle: a 0x60A list status frame, then the
+// 0x60B, 0x60C and 0x60D frames of every object.
+struct Cycle {
+  Frame list_status;
+  std::vector<Frame> general_info;
+  std::vector<Frame> quality_info;
+  std::vector<Frame> extended_info;
+};
+
+// Synthetic frames built the same way as in object_index_test. Quality and
+// extended frames arrive in reverse id order, the worst case for a linear
+// scan.
+Cycle MakeCycle(const int num_objects) {
+  Cycle cycle;
+  cycle.list_status = {{static_cast<uint8_t>(num_objects), 0, 0, 1, 0x10, 0, 0,
+                        0}};
+  for (int id = 0; id < num_objects; ++id) {
+    cycle.general_info.push_back(
+        {{static_cast<uint8_t>(id), static_cast<uint8_t>(id),
+          static_cast<uint8_t>(id * 3), static_cast<uint8_t>(id * 5),
+          static_cast<uint8_t>(id * 11), static_cast<uint8_t>(id * 13),
+          static_cast<uint8_t>(id * 17), static_cast<uint8_t>(id * 19)}});
+  }
+  for (int id = num_objects - 1; id >= 0; --id) {
+    const Frame frame = {
+        {static_cast<uint8_t>(id), static_cast<uint8_t>(id * 23),
+         static_cast<uint8_t>(id * 29), static_cast<uint8_t>(id * 31),
+         static_cast<uint8_t>(id * 37), static_cast<uint8_t>(id * 41),
+         static_cast<uint8_t>(id * 43), static_cast<uint8_t>(id * 47)}};
+    cycle.quality_info.push_back(frame);
+    cycle.extended_info.push_back(frame);
+  }
+  return cycle;
+}
+
+// The per-field decoder the 0x60B, 0x60C and 0x60D frames used before the
+// bit-field tables: every signal builds its own Byte views of one or two
+// bytes, and objects are found by a linear scan over contiobs.
+namespace legacy {
+
+int32_t GetField(const uint8_t* bytes, const int32_t byte,
+                 const int32_t start_pos, const int32_t len) {
+  Byte t0(bytes + byte);
+  return t0.get_byte(start_pos, len);
+}
+
+int32_t GetField(const uint8_t* bytes, const int32_t byte,
+                 const int32_t start_pos, const int32_t len,
+                 const int32_t next_start_pos, const int32_t next_len) {
+  Byte t0(bytes + byte);
+  int32_t x = t0.get_byte(start_pos, len);
+
+  Byte t1(bytes + byte + 1);
+  int32_t t = t1.get_byte(next_start_pos, next_len);
+
+  x <<= next_len;
+  x |= t;
+  return x;
+}
+
+void ParseGeneralInfo(const uint8_t* bytes, ContiRadar* conti_radar) {
+  int obj_id = GetField(bytes, 0, 0, 8);
+  auto conti_obs = conti_radar->add_contiobs();
+  conti_obs->set_clusterortrack(false);
+  conti_obs->set_obstacle_id(obj_id);
+  conti_obs->set_longitude_dist(GetField(bytes, 1, 0, 8, 3, 5) *
+                                    OBJECT_DIST_RES +
+                                OBJECT_DIST_LONG_MIN);
+  conti_obs->set_lateral_dist(GetField(bytes, 2, 0, 3, 0, 8) *
+                                  OBJECT_DIST_RES +
+                              OBJECT_DIST_LAT_MIN);
+  conti_obs->set_longitude_vel(GetField(bytes, 4, 0, 8, 6, 2) *
+                                   OBJECT_VREL_RES +
+                               OBJECT_VREL_LONG_MIN);
+  conti_obs->set_lateral_vel(GetField(bytes, 5, 0, 6, 5, 3) *
+                                 OBJECT_VREL_RES +
+                             OBJECT_VREL_LAT_MIN);
+  conti_obs->set_rcs(GetField(bytes, 7, 0, 8) * OBJECT_RCS_RES +
+                     OBJECT_RCS_MIN);
+  conti_obs->set_dynprop(GetField(bytes, 6, 0, 3));
+  double timestamp = apollo::common::time::Clock::NowInSeconds();
+  auto header = conti_obs->mutable_header();
+  header->CopyFrom(conti_radar->header());
+  header->set_timestamp_sec(timestamp);
+}
+
+void ParseQualityInfo(const uint8_t* bytes, ContiRadar* conti_radar) {
+  int obj_id = GetField(bytes, 0, 0, 8);
+  for (int i = 0; i < conti_radar->contiobs_size(); ++i) {
+    if (conti_radar->contiobs(i).obstacle_id() == obj_id) {
+      auto obs = conti_radar->mutable_contiobs(i);
+      obs->set_longitude_dist_rms(LINEAR_RMS[GetField(bytes, 1, 3, 5)]);
+      obs->set_lateral_dist_rms(LINEAR_RMS[GetField(bytes, 1, 0, 3, 6, 2)]);
+      obs->set_longitude_vel_rms(LINEAR_RMS[GetField(bytes, 2, 1, 5)]);
+      obs->set_lateral_vel_rms(LINEAR_RMS[GetField(bytes, 2, 0, 1, 4, 4)]);
+      obs->set_longitude_accel_rms(
+          LINEAR_RMS[GetField(bytes, 3, 0, 4, 7, 1)]);
+      obs->set_lateral_accel_rms(LINEAR_RMS[GetField(bytes, 4, 2, 5)]);
+      obs->set_oritation_angle_rms(ANGLE_RMS[GetField(bytes, 4, 0, 2, 5, 3)]);
+      obs->set_probexist(PROBOFEXIST[GetField(bytes, 6, 5, 3)]);
+      obs->set_meas_state(GetField(bytes, 6, 2, 3));
+      break;
+    }
+  }
+}
+
+void ParseExtendedInfo(const uint8_t* bytes, ContiRadar* conti_radar) {
+  int obj_id = GetField(bytes, 0, 0, 8);
+  for (int i = 0; i < conti_radar->contiobs_size(); ++i) {
+    if (conti_radar->contiobs(i).obstacle_id() == obj_id) {
+      auto obs = conti_radar->mutable_contiobs(i);
+      obs->set_longitude_accel(GetField(bytes, 1, 0, 8, 5, 3) *
+                                   OBJECT_AREL_RES +
+                               OBJECT_AREL_LONG_MIN);
+      obs->set_lateral_accel(GetField(bytes, 2, 0, 5, 4, 4) *
+                                 OBJECT_AREL_RES +
+                             OBJECT_AREL_LAT_MIN);
+      obs->set_oritation_angle(GetField(bytes, 4, 0, 8, 6, 2) *
+                                   OBJECT_ORIENTATION_ANGEL_RES +
+                               OBJECT_ORIENTATION_ANGEL_MIN);
+      obs->set_length(GetField(bytes, 6, 0, 8) * OBJECT_LENGTH_RES);
+      obs->set_width(GetField(bytes, 7, 0, 8) * OBJECT_WIDTH_RES);
+      obs->set_obstacle_class(GetField(bytes, 3, 0, 3));
+      break;
+    }
+  }
+}
+
+}  // namespace legacy
+
+void BM_PerFieldDecoder(benchmark::State &state) {
+  const Cycle cycle = MakeCycle(state.range(0));
+  ObjectListStatus60A list_status;
+  ContiRadar conti_radar;
+  while (state.KeepRunning()) {
+    conti_radar.Clear();
+    list_status.Parse(cycle.list_status.data(), 8, &conti_radar);
+    for (const auto &frame : cycle.general_info) {
+      legacy::ParseGeneralInfo(frame.data(), &conti_radar);
+    }
+    for (size_t i = 0; i < cycle.quality_info.size(); ++i) {
+      legacy::ParseQualityInfo(cycle.quality_info[i].data(), &conti_radar);
+      legacy::ParseExtendedInfo(cycle.extended_info[i].data(), &conti_radar);
+    }
+    benchmark::DoNotOptimize(conti_radar);
+  }
+}
+
+// Replays a cycle through the table decoder, with the object index when
+// range(1) is nonzero and with a linear scan otherwise.
+void BM_TableDecoder(benchmark::State &state) {
+  const Cycle cycle = MakeCycle(state.range(0));
+  ObjectListStatus60A list_status;
+  ObjectGeneralInfo60B general_info;
+  ObjectQualityInfo60C quality_info;
+  ObjectExtendedInfo60D extended_info;
+  ObjectIndex index;
+  if (state.range(1) != 0) {
+    general_info.set_object_index(&index);
+    quality_info.set_object_index(&index);
+    extended_info.set_object_index(&index);
+  }
+  ContiRadar conti_radar;
+  while (state.KeepRunning()) {
+    conti_radar.Clear();
+    list_status.Parse(cycle.list_status.data(), 8, &conti_radar);
+    for (const auto &frame : cycle.general_info) {
+      general_info.Parse(frame.data(), 8, &conti_radar);
+    }
+    for (size_t i = 0; i < cycle.quality_info.size(); ++i) {
+      quality_info.Parse(cycle.quality_info[i].data(), 8, &conti_radar);
+      extended_info.Parse(cycle.extended_info[i].data(), 8, &conti_radar);
+    }
+    benchmark::DoNotOptimize(conti_radar);
+  }
+}
+
+// Objects per cycle.
+BENCHMARK(BM_PerFieldDecoder)->Arg(10)->Arg(50)->Arg(100)->Arg(250);
+// Objects per cycle, and whether to use the object index.
+BENCHMARK(BM_TableDecoder)
+    ->Args({10, 0})
+    ->Args({50, 0})
+    ->Args({100, 0})
+    ->Args({250, 0})
+    ->Args({10, 1})
+    ->Args({50, 1})
+    ->Args({100, 1})
+    ->Args({250, 1});
+
+}  // namespace
+}  // namespace conti_radar
+}  // namespace drivers
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -16,117 +16,48 @@
 
 #include "modules/drivers/conti_radar/protocol/object_extended_info_60d.h"
 
-#include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/conti_radar/protocol/bit_field.h"
 #include "modules/drivers/conti_radar/protocol/const_vars.h"
 
 namespace apollo {
 namespace drivers {
 namespace conti_radar {
 
-using apollo::drivers::canbus::Byte;
+namespace {
+
+constexpr BitField kObjectId = MakeBitField(0, 7, 8);
+constexpr BitField kLongitudeAccel = MakeBitField(1, 7, 11);
+constexpr BitField kLateralAccel = MakeBitField(2, 4, 9);
+constexpr BitField kObstacleClass = MakeBitField(3, 2, 3);
+constexpr BitField kOritationAngle = MakeBitField(4, 7, 10);
+constexpr BitField kObjectLength = MakeBitField(6, 7, 8);
+constexpr BitField kObjectWidth = MakeBitField(7, 7, 8);
+
+}  // namespace
 
 ObjectExtendedInfo60D::ObjectExtendedInfo60D() {}
 const uint32_t ObjectExtendedInfo60D::ID = 0x60D;
 
 void ObjectExtendedInfo60D::Parse(const std::uint8_t* bytes, int32_t length,
                                   ContiRadar* conti_radar) const {
-  int obj_id = object_id(bytes, length);
-  for (int i = 0; i < conti_radar->contiobs_size(); ++i) {
-    if (conti_radar->contiobs(i).obstacle_id() == obj_id) {
-      auto obs = conti_radar->mutable_contiobs(i);
-      obs->set_longitude_accel(longitude_accel(bytes, length));
-      obs->set_lateral_accel(lateral_accel(bytes, length));
-      obs->set_oritation_angle(oritation_angle(bytes, length));
-      obs->set_length(object_length(bytes, length));
-      obs->set_width(object_width(bytes, length));
-      obs->set_obstacle_class(obstacle_class(bytes, length));
-      break;
-    }
+  const uint64_t frame = FrameToWord(bytes, length);
+  auto obs = FindObject(object_index_, ExtractBitField(frame, kObjectId),
+                        conti_radar);
+  if (obs == nullptr) {
+    return;
   }
-  // auto conti_obs = conti_radar->mutable_contiobs(object_id(bytes, length));
-}
-
-int ObjectExtendedInfo60D::object_id(const std::uint8_t* bytes,
-                                     int32_t length) const {
-  Byte t0(bytes);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
-  return ret;
-}
-
-double ObjectExtendedInfo60D::longitude_accel(const std::uint8_t* bytes,
-                                              int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 2);
-  int32_t t = t1.get_byte(5, 3);
-
-  x <<= 3;
-  x |= t;
-
-  double ret = x * OBJECT_AREL_RES + OBJECT_AREL_LONG_MIN;
-  return ret;
-}
-
-double ObjectExtendedInfo60D::lateral_accel(const std::uint8_t* bytes,
-                                            int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 5);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(4, 4);
-
-  x <<= 4;
-  x |= t;
-
-  double ret = x * OBJECT_AREL_RES + OBJECT_AREL_LAT_MIN;
-  return ret;
-}
-
-int ObjectExtendedInfo60D::obstacle_class(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 3);
-
-  int ret = x;
-  return ret;
-}
-
-double ObjectExtendedInfo60D::oritation_angle(const std::uint8_t* bytes,
-                                              int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(6, 2);
-
-  x <<= 2;
-  x |= t;
-
-  double ret = x * OBJECT_ORIENTATION_ANGEL_RES + OBJECT_ORIENTATION_ANGEL_MIN;
-  return ret;
-}
-
-double ObjectExtendedInfo60D::object_length(const std::uint8_t* bytes,
-                                            int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 8);
-
-  double ret = x * OBJECT_LENGTH_RES;
-  return ret;
-}
-
-double ObjectExtendedInfo60D::object_width(const std::uint8_t* bytes,
-                                           int32_t length) const {
-  Byte t0(bytes + 7);
-  int32_t x = t0.get_byte(0, 8);
-
-  double ret = x * OBJECT_WIDTH_RES;
-  return ret;
+  obs->set_longitude_accel(ExtractBitField(frame, kLongitudeAccel) *
+                               OBJECT_AREL_RES +
+                           OBJECT_AREL_LONG_MIN);
+  obs->set_lateral_accel(ExtractBitField(frame, kLateralAccel) *
+                             OBJECT_AREL_RES +
+                         OBJECT_AREL_LAT_MIN);
+  obs->set_oritation_angle(ExtractBitField(frame, kOritationAngle) *
+                               OBJECT_ORIENTATION_ANGEL_RES +
+                           OBJECT_ORIENTATION_ANGEL_MIN);
+  obs->set_length(ExtractBitField(frame, kObjectLength) * OBJECT_LENGTH_RES);
+  obs->set_width(ExtractBitField(frame, kObjectWidth) * OBJECT_WIDTH_RES);
+  obs->set_obstacle_class(ExtractBitField(frame, kObstacleClass));
 }
 
 }  // namespace conti_radar
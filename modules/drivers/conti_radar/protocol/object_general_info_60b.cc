@@ -16,125 +16,60 @@
 
 #include "modules/drivers/conti_radar/protocol/object_general_info_60b.h"
 
-#include "glog/logging.h"
-
 #include "modules/common/time/time.h"
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/conti_radar/protocol/bit_field.h"
 #include "modules/drivers/conti_radar/protocol/const_vars.h"
 
 namespace apollo {
 namespace drivers {
 namespace conti_radar {
 
-using apollo::drivers::canbus::Byte;
+namespace {
+
+constexpr BitField kObjectId = MakeBitField(0, 7, 8);
+constexpr BitField kLongitudeDist = MakeBitField(1, 7, 13);
+constexpr BitField kLateralDist = MakeBitField(2, 2, 11);
+constexpr BitField kLongitudeVel = MakeBitField(4, 7, 10);
+constexpr BitField kLateralVel = MakeBitField(5, 5, 9);
+constexpr BitField kDynprop = MakeBitField(6, 2, 3);
+constexpr BitField kRcs = MakeBitField(7, 7, 8);
+
+}  // namespace
 
 ObjectGeneralInfo60B::ObjectGeneralInfo60B() {}
 const uint32_t ObjectGeneralInfo60B::ID = 0x60B;
 
 void ObjectGeneralInfo60B::Parse(const std::uint8_t* bytes, int32_t length,
                                  ContiRadar* conti_radar) const {
-  int obj_id = object_id(bytes, length);
+  const uint64_t frame = FrameToWord(bytes, length);
+  int obj_id = ExtractBitField(frame, kObjectId);
+  if (object_index_ != nullptr) {
+    object_index_->Set(obj_id, conti_radar->contiobs_size());
+  }
   auto conti_obs = conti_radar->add_contiobs();
   conti_obs->set_clusterortrack(false);
   conti_obs->set_obstacle_id(obj_id);
-  conti_obs->set_longitude_dist(longitude_dist(bytes, length));
-  conti_obs->set_lateral_dist(lateral_dist(bytes, length));
-  conti_obs->set_longitude_vel(longitude_vel(bytes, length));
-  conti_obs->set_lateral_vel(lateral_vel(bytes, length));
-  conti_obs->set_rcs(rcs(bytes, length));
-  conti_obs->set_dynprop(dynprop(bytes, length));
+  conti_obs->set_longitude_dist(ExtractBitField(frame, kLongitudeDist) *
+                                    OBJECT_DIST_RES +
+                                OBJECT_DIST_LONG_MIN);
+  conti_obs->set_lateral_dist(ExtractBitField(frame, kLateralDist) *
+                                  OBJECT_DIST_RES +
+                              OBJECT_DIST_LAT_MIN);
+  conti_obs->set_longitude_vel(ExtractBitField(frame, kLongitudeVel) *
+                                   OBJECT_VREL_RES +
+                               OBJECT_VREL_LONG_MIN);
+  conti_obs->set_lateral_vel(ExtractBitField(frame, kLateralVel) *
+                                 OBJECT_VREL_RES +
+                             OBJECT_VREL_LAT_MIN);
+  conti_obs->set_rcs(ExtractBitField(frame, kRcs) * OBJECT_RCS_RES +
+                     OBJECT_RCS_MIN);
+  conti_obs->set_dynprop(ExtractBitField(frame, kDynprop));
   double timestamp = apollo::common::time::Clock::NowInSeconds();
   auto header = conti_obs->mutable_header();
   header->CopyFrom(conti_radar->header());
   header->set_timestamp_sec(timestamp);
 }
 
-int ObjectGeneralInfo60B::object_id(const std::uint8_t* bytes,
-                                    int32_t length) const {
-  Byte t0(bytes);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
-  return ret;
-}
-
-double ObjectGeneralInfo60B::longitude_dist(const std::uint8_t* bytes,
-                                            int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 2);
-  int32_t t = t1.get_byte(3, 5);
-
-  x <<= 5;
-  x |= t;
-
-  double ret = x * OBJECT_DIST_RES + OBJECT_DIST_LONG_MIN;
-  return ret;
-}
-
-double ObjectGeneralInfo60B::lateral_dist(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 3);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(0, 8);
-
-  x <<= 8;
-  x |= t;
-
-  double ret = x * OBJECT_DIST_RES + OBJECT_DIST_LAT_MIN;
-  return ret;
-}
-
-double ObjectGeneralInfo60B::longitude_vel(const std::uint8_t* bytes,
-                                           int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(6, 2);
-
-  x <<= 2;
-  x |= t;
-  double ret = x * OBJECT_VREL_RES + OBJECT_VREL_LONG_MIN;
-  return ret;
-}
-
-double ObjectGeneralInfo60B::lateral_vel(const std::uint8_t* bytes,
-                                         int32_t length) const {
-  Byte t0(bytes + 5);
-  int32_t x = t0.get_byte(0, 6);
-
-  Byte t1(bytes + 6);
-  int32_t t = t1.get_byte(5, 3);
-
-  x <<= 3;
-  x |= t;
-
-  double ret = x * OBJECT_VREL_RES + OBJECT_VREL_LAT_MIN;
-  return ret;
-}
-
-double ObjectGeneralInfo60B::rcs(const std::uint8_t* bytes,
-                                 int32_t length) const {
-  Byte t0(bytes + 7);
-  int32_t x = t0.get_byte(0, 8);
-
-  double ret = x * OBJECT_RCS_RES + OBJECT_RCS_MIN;
-  return ret;
-}
-
-int ObjectGeneralInfo60B::dynprop(const std::uint8_t* bytes,
-                                  int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 3);
-
-  int ret = x;
-  return ret;
-}
-
 }  // namespace conti_radar
 }  // namespace drivers
 }  // namespace apollo
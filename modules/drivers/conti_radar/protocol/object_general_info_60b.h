@@ -18,6 +18,7 @@
 #define MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_OBJECT_GENERAL_INFO_60B_H_
 
 #include "modules/drivers/canbus/can_comm/protocol_data.h"
+#include "modules/drivers/conti_radar/protocol/object_index.h"
 #include "modules/drivers/proto/conti_radar.pb.h"
 
 namespace apollo {
@@ -34,24 +35,20 @@ class ObjectGeneralInfo60B
   void Parse(const std::uint8_t* bytes, int32_t length,
              ContiRadar* conti_radar) const override;
 
- private:
-  int object_id(const std::uint8_t* bytes, int32_t length) const;
-
-  double longitude_dist(const std::uint8_t* bytes, int32_t length) const;
-
-  double lateral_dist(const std::uint8_t* bytes, int32_t length) const;
-
-  double longitude_vel(const std::uint8_t* bytes, int32_t length) const;
+  /**
+   * @brief Shares the per-cycle object index, which is used instead of a
+   * linear scan over contiobs when set.
+   */
+  void set_object_index(ObjectIndex* object_index) {
+    object_index_ = object_index;
+  }
 
-  double lateral_vel(const std::uint8_t* bytes, int32_t length) const;
-
-  double rcs(const std::uint8_t* bytes, int32_t length) const;
-
-  int dynprop(const std::uint8_t* bytes, int32_t length) const;
+ private:
+  ObjectIndex* object_index_ = nullptr;
 };
 
 }  // namespace conti_radar
 }  // namespace drivers
 }  // namespace apollo
 
-#endif  // MODULES_CANBUS_VEHICL_ESR_PROTOCOL_OBJECT_GENERAL_INFO_60B_H_
+#endif  // MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_OBJECT_GENERAL_INFO_60B_H_
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_OBJECT_INDEX_H_
+#define MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_OBJECT_INDEX_H_
+
+#include <array>
+
+#include "modules/drivers/proto/conti_radar.pb.h"
+
+namespace apollo {
+namespace drivers {
+namespace conti_radar {
+
+using apollo::drivers::ContiRadar;
+using apollo::drivers::ContiRadarObs;
+
+/**
+ * @class ObjectIndex
+ * @brief Maps an 8-bit object id to the position of that object in the
+ * contiobs of the current radar cycle, so that quality and extended info
+ * frames find their object in constant time. Entries are validated against
+ * the message on lookup, so the index never needs to be cleared between
+ * cycles.
+ */
+class ObjectIndex {
+ public:
+  ObjectIndex() { positions_.fill(-1); }
+
+  void Set(const int object_id, const int position) {
+    if (object_id >= 0 && object_id < kMaxObjectNum) {
+      positions_[object_id] = position;
+    }
+  }
+
+  ContiRadarObs* Find(const int object_id, ContiRadar* conti_radar) const {
+    if (object_id < 0 || object_id >= kMaxObjectNum) {
+      return nullptr;
+    }
+    const int position = positions_[object_id];
+    if (position < 0 || position >= conti_radar->contiobs_size() ||
+        conti_radar->contiobs(position).obstacle_id() != object_id) {
+      return nullptr;
+    }
+    return conti_radar->mutable_contiobs(position);
+  }
+
+ private:
+  static constexpr int kMaxObjectNum = 256;
+  std::array<int, kMaxObjectNum> positions_;
+};
+
+/**
+ * @brief Finds the object with the given id through the index when one is
+ * given, otherwise by a linear scan over contiobs.
+ */
+inline ContiRadarObs* FindObject(const ObjectIndex* object_index,
+                                 const int object_id,
+                                 ContiRadar* conti_radar) {
+  if (object_index != nullptr) {
+    return object_index->Find(object_id, conti_radar);
+  }
+  for (int i = 0; i < conti_radar->contiobs_size(); ++i) {
+    if (conti_radar->contiobs(i).obstacle_id() == object_id) {
+      return conti_radar->mutable_contiobs(i);
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace conti_radar
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_CONTI_RADAR_PROTOCOL_OBJECT_INDEX_H_
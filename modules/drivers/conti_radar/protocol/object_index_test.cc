@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/conti_radar/protocol/object_index.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/drivers/conti_radar/protocol/object_extended_info_60d.h"
+#include "modules/drivers/conti_radar/protocol/object_general_info_60b.h"
+#include "modules/drivers/conti_radar/protocol/object_quality_info_60c.h"
+
+namespace apollo {
+namespace drivers {
+namespace conti_radar {
+
+TEST(ObjectIndexTest, Find) {
+  ObjectIndex index;
+  ContiRadar conti_radar;
+  EXPECT_EQ(nullptr, index.Find(3, &conti_radar));
+
+  conti_radar.add_contiobs()->set_obstacle_id(7);
+  conti_radar.add_contiobs()->set_obstacle_id(3);
+  index.Set(7, 0);
+  index.Set(3, 1);
+  EXPECT_EQ(conti_radar.mutable_contiobs(1), index.Find(3, &conti_radar));
+  EXPECT_EQ(conti_radar.mutable_contiobs(0), index.Find(7, &conti_radar));
+  EXPECT_EQ(nullptr, index.Find(256, &conti_radar));
+
+  // stale entries from the previous cycle are rejected
+  conti_radar.Clear();
+  conti_radar.add_contiobs()->set_obstacle_id(3);
+  EXPECT_EQ(nullptr, index.Find(3, &conti_radar));
+  EXPECT_EQ(nullptr, index.Find(7, &conti_radar));
+}
+
+TEST(ObjectIndexTest, MatchesLinearScan) {
+  ObjectGeneralInfo60B general_info;
+  ObjectQualityInfo60C quality_info;
+  ObjectExtendedInfo60D extended_info;
+
+  ObjectIndex index;
+  ObjectGeneralInfo60B indexed_general_info;
+  ObjectQualityInfo60C indexed_quality_info;
+  ObjectExtendedInfo60D indexed_extended_info;
+  indexed_general_info.set_object_index(&index);
+  indexed_quality_info.set_object_index(&index);
+  indexed_extended_info.set_object_index(&index);
+
+  ContiRadar expected;
+  ContiRadar conti_radar;
+  for (int cycle = 0; cycle < 2; ++cycle) {
+    expected.Clear();
+    conti_radar.Clear();
+    const int num_objects = 100 - cycle * 30;
+    for (int id = 0; id < num_objects; ++id) {
+      uint8_t bytes[8] = {static_cast<uint8_t>((id * 7 + cycle) % 256),
+                          static_cast<uint8_t>(id),
+                          static_cast<uint8_t>(id * 3),
+                          static_cast<uint8_t>(id * 5),
+                          static_cast<uint8_t>(id * 11),
+                          static_cast<uint8_t>(id * 13),
+                          static_cast<uint8_t>(id * 17),
+                          static_cast<uint8_t>(id * 19)};
+      general_info.Parse(bytes, 8, &expected);
+      indexed_general_info.Parse(bytes, 8, &conti_radar);
+    }
+    for (int id = num_objects - 1; id >= 0; --id) {
+      uint8_t bytes[8] = {static_cast<uint8_t>((id * 7 + cycle) % 256),
+                          static_cast<uint8_t>(id * 23),
+                          static_cast<uint8_t>(id * 29),
+                          static_cast<uint8_t>(id * 31),
+                          static_cast<uint8_t>(id * 37),
+                          static_cast<uint8_t>(id * 41),
+                          static_cast<uint8_t>(id * 43),
+                          static_cast<uint8_t>(id * 47)};
+      quality_info.Parse(bytes, 8, &expected);
+      indexed_quality_info.Parse(bytes, 8, &conti_radar);
+      extended_info.Parse(bytes, 8, &expected);
+      indexed_extended_info.Parse(bytes, 8, &conti_radar);
+    }
+    ASSERT_EQ(expected.contiobs_size(), conti_radar.contiobs_size());
+    for (int i = 0; i < expected.contiobs_size(); ++i) {
+      expected.mutable_contiobs(i)->clear_header();
+      conti_radar.mutable_contiobs(i)->clear_header();
+    }
+    EXPECT_EQ(expected.DebugString(), conti_radar.DebugString());
+  }
+}
+
+}  // namespace conti_radar
+}  // namespace drivers
+}  // namespace apollo
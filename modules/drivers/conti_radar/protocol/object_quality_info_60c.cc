@@ -15,158 +15,54 @@
  *****************************************************************************/
 
 #include "modules/drivers/conti_radar/protocol/object_quality_info_60c.h"
-#include "modules/drivers/conti_radar/protocol/const_vars.h"
-
-#include "glog/logging.h"
 
-#include "modules/drivers/canbus/common/byte.h"
-#include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/conti_radar/protocol/bit_field.h"
+#include "modules/drivers/conti_radar/protocol/const_vars.h"
 
 namespace apollo {
 namespace drivers {
 namespace conti_radar {
 
-using apollo::drivers::canbus::Byte;
+namespace {
+
+constexpr BitField kObjectId = MakeBitField(0, 7, 8);
+constexpr BitField kLongitudeDistRms = MakeBitField(1, 7, 5);
+constexpr BitField kLateralDistRms = MakeBitField(1, 2, 5);
+constexpr BitField kLongitudeVelRms = MakeBitField(2, 5, 5);
+constexpr BitField kLateralVelRms = MakeBitField(2, 0, 5);
+constexpr BitField kLongitudeAccelRms = MakeBitField(3, 3, 5);
+constexpr BitField kLateralAccelRms = MakeBitField(4, 6, 5);
+constexpr BitField kOritationAngleRms = MakeBitField(4, 1, 5);
+constexpr BitField kProbexist = MakeBitField(6, 7, 3);
+constexpr BitField kMeasState = MakeBitField(6, 4, 3);
+
+}  // namespace
 
 ObjectQualityInfo60C::ObjectQualityInfo60C() {}
 const uint32_t ObjectQualityInfo60C::ID = 0x60C;
 
 void ObjectQualityInfo60C::Parse(const std::uint8_t* bytes, int32_t length,
                                  ContiRadar* conti_radar) const {
-  int obj_id = object_id(bytes, length);
-
-  for (int i = 0; i < conti_radar->contiobs_size(); ++i) {
-    if (conti_radar->contiobs(i).obstacle_id() == obj_id) {
-      auto obs = conti_radar->mutable_contiobs(i);
-      obs->set_longitude_dist_rms(
-          LINEAR_RMS[longitude_dist_rms(bytes, length)]);
-      obs->set_lateral_dist_rms(LINEAR_RMS[lateral_dist_rms(bytes, length)]);
-      obs->set_longitude_vel_rms(LINEAR_RMS[longitude_vel_rms(bytes, length)]);
-      obs->set_lateral_vel_rms(LINEAR_RMS[lateral_vel_rms(bytes, length)]);
-      obs->set_longitude_accel_rms(
-          LINEAR_RMS[longitude_accel_rms(bytes, length)]);
-      obs->set_lateral_accel_rms(LINEAR_RMS[lateral_accel_rms(bytes, length)]);
-      obs->set_oritation_angle_rms(
-          ANGLE_RMS[oritation_angle_rms(bytes, length)]);
-      obs->set_probexist(PROBOFEXIST[probexist(bytes, length)]);
-      obs->set_meas_state(meas_state(bytes, length));
-      break;
-    }
+  const uint64_t frame = FrameToWord(bytes, length);
+  auto obs = FindObject(object_index_, ExtractBitField(frame, kObjectId),
+                        conti_radar);
+  if (obs == nullptr) {
+    return;
   }
-}
-
-int ObjectQualityInfo60C::object_id(const std::uint8_t* bytes,
-                                    int32_t length) const {
-  Byte t0(bytes);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::longitude_dist_rms(const std::uint8_t* bytes,
-                                             int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(3, 5);
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::lateral_dist_rms(const std::uint8_t* bytes,
-                                           int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 3);
-
-  Byte t1(bytes + 2);
-  int32_t t = t1.get_byte(6, 2);
-
-  x <<= 2;
-  x |= t;
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::longitude_vel_rms(const std::uint8_t* bytes,
-                                            int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(1, 5);
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::lateral_vel_rms(const std::uint8_t* bytes,
-                                          int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 1);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(4, 4);
-
-  x <<= 4;
-  x |= t;
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::longitude_accel_rms(const std::uint8_t* bytes,
-                                              int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 4);
-
-  Byte t1(bytes + 4);
-  int32_t t = t1.get_byte(7, 1);
-
-  x <<= 1;
-  x |= t;
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::lateral_accel_rms(const std::uint8_t* bytes,
-                                            int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(2, 5);
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::oritation_angle_rms(const std::uint8_t* bytes,
-                                              int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 2);
-
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(5, 3);
-
-  x <<= 3;
-  x |= t;
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::probexist(const std::uint8_t* bytes,
-                                    int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(5, 3);
-
-  int ret = x;
-  return ret;
-}
-
-int ObjectQualityInfo60C::meas_state(const std::uint8_t* bytes,
-                                     int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(2, 3);
-
-  int ret = x;
-  return ret;
+  obs->set_longitude_dist_rms(
+      LINEAR_RMS[ExtractBitField(frame, kLongitudeDistRms)]);
+  obs->set_lateral_dist_rms(LINEAR_RMS[ExtractBitField(frame, kLateralDistRms)]);
+  obs->set_longitude_vel_rms(
+      LINEAR_RMS[ExtractBitField(frame, kLongitudeVelRms)]);
+  obs->set_lateral_vel_rms(LINEAR_RMS[ExtractBitField(frame, kLateralVelRms)]);
+  obs->set_longitude_accel_rms(
+      LINEAR_RMS[ExtractBitField(frame, kLongitudeAccelRms)]);
+  obs->set_lateral_accel_rms(
+      LINEAR_RMS[ExtractBitField(frame, kLateralAccelRms)]);
+  obs->set_oritation_angle_rms(
+      ANGLE_RMS[ExtractBitField(frame, kOritationAngleRms)]);
+  obs->set_probexist(PROBOFEXIST[ExtractBitField(frame, kProbexist)]);
+  obs->set_meas_state(ExtractBitField(frame, kMeasState));
 }
 
 }  // namespace conti_radar
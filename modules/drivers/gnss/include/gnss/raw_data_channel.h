@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// An in-process channel that moves raw stream bytes from the stream nodelet
+// to the parser nodelet through a ring buffer, bypassing the ROS raw data
+// topic. Both nodelets must be loaded into the same nodelet manager.
+
+#ifndef MODULES_DRIVERS_GNSS_RAW_DATA_CHANNEL_H_
+#define MODULES_DRIVERS_GNSS_RAW_DATA_CHANNEL_H_
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include "util/macros.h"
+#include "util/ring_buffer.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+class RawDataChannel {
+ public:
+  // Returns the channel registered under name, creating it on first use.
+  // The channel lives until the process exits.
+  static RawDataChannel *get(const std::string &name);
+
+  // Called by the producer. Returns the number of bytes accepted; the rest
+  // is dropped when the consumer falls behind by more than the capacity.
+  size_t write(const uint8_t *data, size_t length);
+
+  // Called by the consumer. Blocks until data is available or the timeout
+  // expires, then reads as many bytes as are available up to max_length.
+  size_t read(uint8_t *data, size_t max_length, uint32_t timeout_ms);
+
+  size_t dropped_bytes() const {
+    return _dropped_bytes;
+  }
+
+ private:
+  static constexpr size_t CAPACITY = 1 << 20;
+
+  RawDataChannel() : _ring(CAPACITY) {}
+
+  RingBuffer _ring;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  size_t _dropped_bytes = 0;
+
+  DISABLE_COPY_AND_ASSIGN(RawDataChannel);
+};
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_GNSS_RAW_DATA_CHANNEL_H_
@@ -90,6 +90,12 @@ class Stream {
   // Returns how many bytes it was successful to write.
   virtual size_t write(const uint8_t *buffer, size_t length) = 0;
 
+  // Returns the descriptor that becomes readable when read() has data, or -1
+  // if there is none, e.g. while disconnected.
+  virtual int fd() const {
+    return -1;
+  }
+
   size_t write(const std::string &buffer) {
     return write(reinterpret_cast<const uint8_t *>(buffer.data()),
                  buffer.size());
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Serves several streams from one thread with epoll. A stream is read only
+// when its descriptor is readable, and everything available is read in one
+// batch into a large buffer, instead of one thread per stream polling it
+// with short timeouts.
+//
+// Streams reconnect and detect timeouts inside read(). So a stream that has
+// had no data for a while is read anyway, on the reactor thread, with the
+// epoll_wait timeout set to the earliest of those reads. A reconnect inside
+// such a read may block for up to the connect timeout of the stream, while
+// the data of the other streams waits in their kernel buffers.
+
+#ifndef MODULES_DRIVERS_GNSS_STREAM_REACTOR_H_
+#define MODULES_DRIVERS_GNSS_STREAM_REACTOR_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gnss/stream.h"
+#include "util/macros.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+class StreamReactor {
+ public:
+  // Called on the reactor thread after each read of the stream with the
+  // bytes read. length may be 0, e.g. for the periodic read of an idle or
+  // disconnected stream.
+  typedef std::function<void(const uint8_t *data, size_t length)> Callback;
+
+  StreamReactor();
+  ~StreamReactor();
+
+  // Streams must be added before start() and outlive the reactor.
+  void add(Stream *stream, Callback callback);
+
+  bool start();
+  void stop();
+
+  // Number of times the reactor thread woke up, for diagnostics.
+  uint64_t wakeups() const {
+    return _wakeups;
+  }
+
+ private:
+  struct Handle {
+    Stream *stream = nullptr;
+    Callback callback;
+    // The descriptor currently registered with epoll, or -1.
+    int fd = -1;
+    std::chrono::steady_clock::time_point last_read;
+    std::vector<uint8_t> buffer;
+  };
+
+  void spin();
+  // Returns the epoll_wait timeout until the next read of an idle stream.
+  int idle_read_timeout_ms() const;
+  void read_idle_streams();
+  size_t read(Handle *handle);
+  void wake_up();
+  void update_registration(Handle *handle);
+  void unregister(Handle *handle);
+
+  // Big enough to drain a serial port at 921600 baud or a socket in one read.
+  static constexpr size_t BUFFER_SIZE = 64 * 1024;
+  // Streams without data for this long are read anyway, which lets the
+  // streams reconnect and run their own timeout checks.
+  static constexpr int IDLE_READ_INTERVAL_MS = 1000;
+  // Idle streams due within this long of each other are read together.
+  static constexpr int IDLE_READ_SLACK_MS = 100;
+
+  int _epoll_fd = -1;
+  int _wakeup_fd = -1;
+  std::vector<std::unique_ptr<Handle>> _handles;
+  std::atomic<bool> _running{false};
+  std::atomic<uint64_t> _wakeups{0};
+  std::unique_ptr<std::thread> _thread;
+
+  DISABLE_COPY_AND_ASSIGN(StreamReactor);
+};
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_GNSS_STREAM_REACTOR_H_
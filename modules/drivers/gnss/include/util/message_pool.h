@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// A pool of preallocated messages to publish through ROS without a heap
+// allocation per message. A message is handed out again only once every
+// subscriber has released it, i.e. the pool holds the only reference.
+
+#ifndef MODULES_DRIVERS_GNSS_INCLUDE_UTIL_MESSAGE_POOL_H_
+#define MODULES_DRIVERS_GNSS_INCLUDE_UTIL_MESSAGE_POOL_H_
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "util/macros.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+template <class T>
+class MessagePool {
+ public:
+  explicit MessagePool(size_t size) : _messages(size) {
+    for (auto &message : _messages) {
+      message.reset(new T());
+    }
+  }
+
+  // Returns a message no one else references. Falls back to a fresh
+  // allocation when all pooled messages are still in flight.
+  boost::shared_ptr<T> acquire() {
+    for (size_t i = 0; i < _messages.size(); ++i) {
+      auto &message = _messages[_next];
+      _next = (_next + 1) % _messages.size();
+      if (message.unique()) {
+        message->Clear();
+        return message;
+      }
+    }
+    return boost::shared_ptr<T>(new T());
+  }
+
+ private:
+  std::vector<boost::shared_ptr<T>> _messages;
+  size_t _next = 0;
+
+  DISABLE_COPY_AND_ASSIGN(MessagePool);
+};
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_GNSS_INCLUDE_UTIL_MESSAGE_POOL_H_
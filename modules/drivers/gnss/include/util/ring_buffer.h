@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// A lock-free byte ring buffer for one producer thread and one consumer
+// thread.
+
+#ifndef MODULES_DRIVERS_GNSS_INCLUDE_UTIL_RING_BUFFER_H_
+#define MODULES_DRIVERS_GNSS_INCLUDE_UTIL_RING_BUFFER_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "util/macros.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+class RingBuffer {
+ public:
+  // The capacity is rounded up to a power of two.
+  explicit RingBuffer(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    _data.resize(size);
+    _mask = size - 1;
+  }
+
+  size_t capacity() const {
+    return _data.size();
+  }
+
+  // Number of bytes available to read.
+  size_t size() const {
+    return _write_index.load(std::memory_order_acquire) -
+           _read_index.load(std::memory_order_acquire);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  // Called by the producer only. Writes up to length bytes and returns the
+  // number of bytes actually written, which is less than length if the
+  // buffer is full.
+  size_t write(const uint8_t *data, size_t length) {
+    const size_t write_index = _write_index.load(std::memory_order_relaxed);
+    const size_t read_index = _read_index.load(std::memory_order_acquire);
+    length = std::min(length, capacity() - (write_index - read_index));
+    const size_t offset = write_index & _mask;
+    const size_t first = std::min(length, capacity() - offset);
+    memcpy(_data.data() + offset, data, first);
+    memcpy(_data.data(), data + first, length - first);
+    _write_index.store(write_index + length, std::memory_order_release);
+    return length;
+  }
+
+  // Called by the consumer only. Reads up to max_length bytes and returns the
+  // number of bytes actually read.
+  size_t read(uint8_t *data, size_t max_length) {
+    const size_t read_index = _read_index.load(std::memory_order_relaxed);
+    const size_t write_index = _write_index.load(std::memory_order_acquire);
+    const size_t length = std::min(max_length, write_index - read_index);
+    const size_t offset = read_index & _mask;
+    const size_t first = std::min(length, capacity() - offset);
+    memcpy(data, _data.data() + offset, first);
+    memcpy(data + first, _data.data(), length - first);
+    _read_index.store(read_index + length, std::memory_order_release);
+    return length;
+  }
+
+ private:
+  std::vector<uint8_t> _data;
+  size_t _mask = 0;
+  // Monotonically increasing indices, wrapped with _mask on access.
+  std::atomic<size_t> _write_index{0};
+  std::atomic<size_t> _read_index{0};
+
+  DISABLE_COPY_AND_ASSIGN(RingBuffer);
+};
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
+
+#endif  // MODULES_DRIVERS_GNSS_INCLUDE_UTIL_RING_BUFFER_H_
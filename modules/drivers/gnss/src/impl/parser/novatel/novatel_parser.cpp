@@ -18,6 +18,7 @@
 // messages must be
 // logged in order for this parser to work properly.
 //
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -111,6 +112,14 @@ class NovatelParser : public Parser {
  private:
   bool check_crc();
 
+  // Copies as many bytes as available, up to the given total buffer size.
+  void append_data(size_t target_size) {
+    size_t length = std::min(target_size - _buffer.size(),
+                             static_cast<size_t>(_data_end - _data));
+    _buffer.insert(_buffer.end(), _data, _data + length);
+    _data += length;
+  }
+
   Parser::MessageType prepare_message(MessagePtr& message_ptr);
 
   // The handle_xxx functions return whether a message is ready.
@@ -230,7 +239,7 @@ Parser::MessageType NovatelParser::get_message(MessagePtr& message_ptr) {
       }
     } else if (_header_length > 0) {  // Working on header.
       if (_buffer.size() < _header_length) {
-        _buffer.push_back(*_data++);
+        append_data(_header_length);
       } else {
         if (_header_length == sizeof(novatel::LongHeader)) {
           _total_length = _header_length + novatel::CRC_LENGTH +
@@ -249,8 +258,10 @@ Parser::MessageType NovatelParser::get_message(MessagePtr& message_ptr) {
       }
     } else if (_total_length > 0) {
       if (_buffer.size() < _total_length) {  // Working on body.
-        _buffer.push_back(*_data++);
-        continue;
+        append_data(_total_length);
+        if (_buffer.size() < _total_length) {
+          continue;
+        }
       }
       MessageType type = prepare_message(message_ptr);
       _buffer.clear();
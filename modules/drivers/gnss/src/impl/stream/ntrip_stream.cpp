@@ -48,6 +48,9 @@ class NtripStream : public Stream {
   virtual size_t write(const uint8_t* data, size_t length);
   virtual bool connect();
   virtual bool disconnect();
+  virtual int fd() const {
+    return _is_login ? _tcp_stream->fd() : -1;
+  }
 
  private:
   void reconnect();
@@ -34,6 +34,9 @@ class TcpStream : public Stream {
   virtual bool disconnect();
   virtual size_t read(uint8_t *buffer, size_t max_length);
   virtual size_t write(const uint8_t *data, size_t length);
+  virtual int fd() const {
+    return _status == Stream::Status::CONNECTED ? _sockfd : -1;
+  }
 
  private:
   bool reconnect();
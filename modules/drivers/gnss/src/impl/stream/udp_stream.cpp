@@ -42,6 +42,9 @@ class UdpStream : public Stream {
   virtual bool disconnect();
   virtual size_t read(uint8_t* buffer, size_t max_length);
   virtual size_t write(const uint8_t* data, size_t length);
+  virtual int fd() const {
+    return _sockfd;
+  }
 
  private:
   UdpStream() {}
@@ -82,9 +82,11 @@ DataParser::DataParser(
     const std::string &corr_imu_topic, const std::string &odometry_topic,
     const std::string &gnss_status_topic, const std::string &ins_status_topic,
     const std::string &bestpos_topic, const std::string &eph_topic,
-    const std::string &observation_topic)
-    : _raw_data_sub(nh.subscribe(raw_data_topic, 256,
-                                 &DataParser::raw_data_callback, this)),
+    const std::string &observation_topic, bool inprocess_raw_data)
+    : _raw_data_sub(inprocess_raw_data
+                        ? ros::Subscriber()
+                        : nh.subscribe(raw_data_topic, 256,
+                                       &DataParser::raw_data_callback, this)),
       _ins_stat_publisher(
           nh.advertise<::apollo::drivers::gnss::InsStat>(ins_stat_topic, 64)),
       _raw_imu_publisher(
@@ -122,6 +124,18 @@ DataParser::DataParser(
   if (_ins_status) {
     _ins_status->set_type(apollo::common::gnss_status::InsStatus::INVALID);
   }
+
+  if (inprocess_raw_data) {
+    _raw_data_channel = RawDataChannel::get(raw_data_topic);
+    _raw_data_chunk.resize(RAW_DATA_CHUNK_SIZE);
+  }
+}
+
+DataParser::~DataParser() {
+  _running = false;
+  if (_raw_data_thread_ptr && _raw_data_thread_ptr->joinable()) {
+    _raw_data_thread_ptr->join();
+  }
 }
 
 bool DataParser::init(const std::string &cfg_file) {
@@ -147,6 +161,12 @@ bool DataParser::init(const std::string &cfg_file) {
   }
 
   _inited_flag = true;
+
+  if (_raw_data_channel) {
+    _running = true;
+    _raw_data_thread_ptr.reset(
+        new std::thread(&DataParser::raw_data_spin, this));
+  }
   return true;
 }
 
@@ -155,7 +175,24 @@ void DataParser::raw_data_callback(const std_msgs::String::ConstPtr &msg) {
     return;
   }
 
-  _data_parser->update(msg->data);
+  parse_raw_data(reinterpret_cast<const uint8_t *>(msg->data.data()),
+                 msg->data.size());
+}
+
+void DataParser::raw_data_spin() {
+  while (_running && ros::ok()) {
+    // Drain everything received since the last wakeup, so that several
+    // frames are decoded per wakeup under load.
+    size_t length = _raw_data_channel->read(_raw_data_chunk.data(),
+                                            _raw_data_chunk.size(), 100);
+    if (length > 0) {
+      parse_raw_data(_raw_data_chunk.data(), length);
+    }
+  }
+}
+
+void DataParser::parse_raw_data(const uint8_t *data, size_t length) {
+  _data_parser->update(data, length);
   Parser::MessageType type;
   MessagePtr msg_ptr;
 
@@ -262,11 +299,10 @@ void DataParser::publish_bestpos_message(const MessagePtr message) {
 }
 
 void DataParser::publish_imu_message(const MessagePtr message) {
-  boost::shared_ptr<::apollo::drivers::gnss::Imu> raw_imu(
-      new ::apollo::drivers::gnss::Imu(
-          *As<::apollo::drivers::gnss::Imu>(message)));
-
   ::apollo::drivers::gnss::Imu *imu = As<::apollo::drivers::gnss::Imu>(message);
+  boost::shared_ptr<::apollo::drivers::gnss::Imu> raw_imu =
+      _raw_imu_pool.acquire();
+  raw_imu->CopyFrom(*imu);
 
   raw_imu->mutable_linear_acceleration()->set_x(-imu->linear_acceleration().y());
   raw_imu->mutable_linear_acceleration()->set_y(imu->linear_acceleration().x());
@@ -282,12 +318,7 @@ void DataParser::publish_imu_message(const MessagePtr message) {
 
 void DataParser::publish_odometry_message(const MessagePtr message) {
   ::apollo::drivers::gnss::Ins *ins = As<::apollo::drivers::gnss::Ins>(message);
-  boost::shared_ptr<::apollo::localization::Gps> gps(
-      new ::apollo::localization::Gps());
-  if (!gps) {
-    ROS_ERROR("New gps failed.");
-    return;
-  }
+  boost::shared_ptr<::apollo::localization::Gps> gps = _gps_pool.acquire();
 
   double unix_sec = apollo::drivers::util::gps2unix(ins->measurement_time());
   gps->mutable_header()->set_timestamp_sec(unix_sec);
@@ -326,12 +357,7 @@ void DataParser::publish_odometry_message(const MessagePtr message) {
 
 void DataParser::publish_corrimu_message(const MessagePtr message) {
   ::apollo::drivers::gnss::Ins *ins = As<::apollo::drivers::gnss::Ins>(message);
-  boost::shared_ptr<::apollo::localization::Imu> imu(
-      new ::apollo::localization::Imu());
-  if (!imu) {
-    ROS_ERROR("New imu failed.");
-    return;
-  }
+  boost::shared_ptr<::apollo::localization::Imu> imu = _corr_imu_pool.acquire();
   double unix_sec = apollo::drivers::util::gps2unix(ins->measurement_time());
   imu->mutable_header()->set_timestamp_sec(unix_sec);
 
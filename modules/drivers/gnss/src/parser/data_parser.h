@@ -17,14 +17,18 @@
 #ifndef MODULES_DRIVERS_GNSS_DATA_PARSER_H_
 #define MODULES_DRIVERS_GNSS_DATA_PARSER_H_
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #include <proj_api.h>
 #include <ros/ros.h>
 #include <std_msgs/String.h>
 
 #include "gnss/parser.h"
+#include "gnss/raw_data_channel.h"
 #include "proto/config.pb.h"
+#include "util/message_pool.h"
 
 #include "proto/gnss.pb.h"
 #include "proto/imu.pb.h"
@@ -32,6 +36,9 @@
 
 #include "proto/gnss_status.pb.h"
 
+#include "modules/localization/proto/gps.pb.h"
+#include "modules/localization/proto/imu.pb.h"
+
 namespace apollo {
 namespace drivers {
 namespace gnss {
@@ -45,12 +52,17 @@ class DataParser {
              const std::string &gnss_status_topic,
              const std::string &ins_status_topic,
              const std::string &bestpos_topic, const std::string &eph_topic,
-             const std::string &observation_topic);
-  ~DataParser() {}
+             const std::string &observation_topic,
+             bool inprocess_raw_data = false);
+  ~DataParser();
   bool init(const std::string &cfg_file);
 
+  // Parses a chunk of raw stream bytes and publishes every complete message.
+  void parse_raw_data(const uint8_t *data, size_t length);
+
  private:
   void raw_data_callback(const std_msgs::String::ConstPtr &msg);
+  void raw_data_spin();
   void dispatch_message(Parser::MessageType type, MessagePtr message);
   void publish_ins_stat(const MessagePtr message);
   void publish_odometry_message(const MessagePtr message);
@@ -65,6 +77,20 @@ class DataParser {
   bool _inited_flag = false;
   std::unique_ptr<Parser> _data_parser;
 
+  static constexpr size_t RAW_DATA_CHUNK_SIZE = 64 * 1024;
+  RawDataChannel *_raw_data_channel = nullptr;
+  std::vector<uint8_t> _raw_data_chunk;
+  std::atomic<bool> _running{false};
+  std::unique_ptr<std::thread> _raw_data_thread_ptr;
+
+  // Pools for the full-rate messages, the rest are published rarely.
+  MessagePool<apollo::drivers::gnss::Imu> _raw_imu_pool{16};
+  MessagePool<apollo::localization::Imu> _corr_imu_pool{16};
+  MessagePool<apollo::localization::Gps> _gps_pool{16};
+
+  // Empty when raw data is passed in-process. _data_parser is not
+  // thread-safe, so it is fed either by raw_data_callback on the ROS spinner
+  // or by raw_data_spin, never both.
   const ros::Subscriber _raw_data_sub;
   const ros::Publisher _ins_stat_publisher;
   const ros::Publisher _raw_imu_publisher;
@@ -50,6 +50,7 @@ void ParserNodelet::onInit() {
   std::string bestpos_topic;
   std::string eph_topic;
   std::string observation_topic;
+  bool inprocess_raw_data = false;
 
   nh.param("gnss_conf", gnss_conf, std::string("./conf/gnss_conf.txt"));
   nh.param("raw_data_topic", raw_data_topic,
@@ -70,11 +71,12 @@ void ParserNodelet::onInit() {
   nh.param("eph", eph_topic, std::string("/apollo/sensor/gnss/rtk_eph"));
   nh.param("observation", observation_topic,
            std::string("/apollo/sensor/gnss/rtk_obs"));
+  nh.param("inprocess_raw_data", inprocess_raw_data, false);
 
   _data_parser.reset(new DataParser(
       nh, raw_data_topic, imu_topic, ins_stat_topic, corr_imu_topic,
       odometry_topic, gnss_status_topic, ins_status_topic, bestpos_topic,
-      eph_topic, observation_topic));
+      eph_topic, observation_topic, inprocess_raw_data));
   if (!_data_parser->init(gnss_conf)) {
     ROS_ERROR("Init parser nodelet failed.");
     ROS_ERROR_STREAM("Init parser nodelet failed.");
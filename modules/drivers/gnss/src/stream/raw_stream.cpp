@@ -14,8 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
 #include <memory>
-#include <thread>
 
 #include <ros/ros.h>
 #include <std_msgs/String.h>
@@ -122,7 +122,8 @@ Stream *create_stream(const config::Stream &sd) {
 RawStream::RawStream(ros::NodeHandle &nh, const std::string &name,
                      const std::string &raw_data_topic,
                      const std::string &rtcm_data_topic,
-                     const std::string &stream_status_topic)
+                     const std::string &stream_status_topic,
+                     bool inprocess_raw_data)
     : _raw_data_topic(raw_data_topic),
       _rtcm_data_topic(rtcm_data_topic),
       _raw_data_publisher(nh.advertise<std_msgs::String>(_raw_data_topic, 256)),
@@ -132,9 +133,13 @@ RawStream::RawStream(ros::NodeHandle &nh, const std::string &name,
           nh.advertise<apollo::common::gnss_status::StreamStatus>(
               stream_status_topic, 256, true)) {
   _stream_status.reset(new apollo::common::gnss_status::StreamStatus());
+  if (inprocess_raw_data) {
+    _raw_data_channel = RawDataChannel::get(_raw_data_topic);
+  }
 }
 
 RawStream::~RawStream() {
+  _reactor.stop();
   this->logout();
   this->disconnect();
 }
@@ -262,8 +267,22 @@ bool RawStream::init(const std::string &cfg_file) {
     return false;
   }
 
-  _data_thread_ptr.reset(new std::thread(&RawStream::data_spin, this));
-  _rtk_thread_ptr.reset(new std::thread(&RawStream::rtk_spin, this));
+  _stream_status->mutable_header()->set_timestamp_sec(ros::Time::now().toSec());
+  _stream_status_publisher.publish(_stream_status);
+  _reactor.add(_data_stream.get(),
+               [this](const uint8_t *data, size_t length) {
+                 handle_data(data, length);
+               });
+  if (_in_rtk_stream) {
+    _reactor.add(_in_rtk_stream.get(),
+                 [this](const uint8_t *data, size_t length) {
+                   handle_rtk_data(data, length);
+                 });
+  }
+  if (!_reactor.start()) {
+    ROS_ERROR("Failed to start stream reactor.");
+    return false;
+  }
 
   return true;
 }
@@ -417,79 +436,75 @@ void RawStream::stream_status_check() {
   }
 }
 
-void RawStream::data_spin() {
-  _stream_status->mutable_header()->set_timestamp_sec(ros::Time::now().toSec());
-  _stream_status_publisher.publish(_stream_status);
-  while (ros::ok()) {
-    size_t length = _data_stream->read(_buffer, BUFFER_SIZE);
-    if (length > 0) {
+void RawStream::handle_data(const uint8_t *data, size_t length) {
+  if (length > 0) {
+    if (_raw_data_channel) {
+      if (_raw_data_channel->write(data, length) != length) {
+        ROS_ERROR_STREAM_THROTTLE(1, "Raw data channel overflow, dropped "
+                                         << _raw_data_channel->dropped_bytes()
+                                         << " bytes in total.");
+      }
+    } else {
       std_msgs::StringPtr msg_pub(new std_msgs::String);
       if (!msg_pub) {
         ROS_ERROR("New data sting msg failed.");
-        continue;
+        return;
       }
-      msg_pub->data.assign(reinterpret_cast<const char *>(_buffer), length);
+      msg_pub->data.assign(reinterpret_cast<const char *>(data), length);
       _raw_data_publisher.publish(msg_pub);
+    }
 
-      if (_push_location) {
-        push_gpgga(length);
-      }
+    if (_push_location) {
+      push_gpgga(data, length);
     }
-    stream_status_check();
   }
+  stream_status_check();
 }
 
-void RawStream::rtk_spin() {
-  if (_in_rtk_stream == nullptr) {
+void RawStream::handle_rtk_data(const uint8_t *data, size_t length) {
+  if (length == 0) {
     return;
   }
-  while (ros::ok()) {
-    size_t length = _in_rtk_stream->read(_buffer_rtk, BUFFER_SIZE);
-    if (length > 0) {
-      if (_rtk_software_solution) {
-        publish_rtk_data(length);
-      } else {
-        publish_rtk_data(length);
-        if (_out_rtk_stream == nullptr) {
-          continue;
-        }
-        size_t ret = _out_rtk_stream->write(_buffer_rtk, length);
-        if (ret != length) {
-          ROS_ERROR_STREAM("Expect write out rtk stream bytes "
-                           << length << " but got " << ret);
-        }
-      }
-    }
+  publish_rtk_data(data, length);
+  if (_rtk_software_solution || _out_rtk_stream == nullptr) {
+    return;
+  }
+  size_t ret = _out_rtk_stream->write(data, length);
+  if (ret != length) {
+    ROS_ERROR_STREAM("Expect write out rtk stream bytes " << length
+                                                         << " but got " << ret);
   }
 }
 
-void RawStream::publish_rtk_data(size_t length) {
+void RawStream::publish_rtk_data(const uint8_t *data, size_t length) {
   std_msgs::StringPtr rtkmsg_pub(new std_msgs::String);
   if (!rtkmsg_pub) {
     ROS_ERROR("New rtkmsg failed.");
     return;
   }
 
-  rtkmsg_pub->data.assign(reinterpret_cast<const char *>(_buffer_rtk), length);
+  rtkmsg_pub->data.assign(reinterpret_cast<const char *>(data), length);
   _rtk_data_publisher.publish(rtkmsg_pub);
 }
 
-void RawStream::push_gpgga(size_t length) {
+void RawStream::push_gpgga(const uint8_t *data, size_t length) {
   if (!_in_rtk_stream) {
     return;
   }
 
-  char *gpgga = strstr(reinterpret_cast<char *>(_buffer), "$GPGGA");
-  if (gpgga) {
-    char *p = strchr(gpgga, '*');
-    if (p) {
-      p += 5;
-      if ((p - reinterpret_cast<char *>(_buffer)) <= length) {
-        ROS_INFO_THROTTLE(5, "Push gpgga.");
-        _in_rtk_stream->write(reinterpret_cast<uint8_t *>(gpgga),
-                              reinterpret_cast<uint8_t *>(p) - _buffer);
-      }
-    }
+  // The read buffer is not null terminated, so search within length.
+  static const char GPGGA[] = "$GPGGA";
+  const uint8_t *end = data + length;
+  const uint8_t *gpgga =
+      std::search(data, end, GPGGA, GPGGA + sizeof(GPGGA) - 1);
+  if (gpgga == end) {
+    return;
+  }
+  const uint8_t *p = std::find(gpgga, end, '*');
+  // The sentence ends with "*hh\r\n".
+  if (p != end && end - p >= 5) {
+    ROS_INFO_THROTTLE(5, "Push gpgga.");
+    _in_rtk_stream->write(gpgga, p + 5 - gpgga);
   }
 }
 
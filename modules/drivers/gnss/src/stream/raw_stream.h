@@ -18,12 +18,13 @@
 #define MODULES_DRIVERS_GNSS_RAW_STREAM_H_
 
 #include <memory>
-#include <thread>
 
 #include <ros/ros.h>
 #include <std_msgs/String.h>
 
+#include "gnss/raw_data_channel.h"
 #include "gnss/stream.h"
+#include "gnss/stream_reactor.h"
 #include "proto/config.pb.h"
 #include "proto/gnss_status.pb.h"
 
@@ -35,7 +36,8 @@ class RawStream {
  public:
   RawStream(ros::NodeHandle &nh, const std::string &name,
             const std::string &raw_topic, const std::string &rtcm_topic,
-            const std::string &stream_status_topic);
+            const std::string &stream_status_topic,
+            bool inprocess_raw_data = false);
   ~RawStream();
   bool init(const std::string &cfg_file);
 
@@ -45,19 +47,15 @@ class RawStream {
   };
 
  private:
-  void data_spin();
-  void rtk_spin();
+  void handle_data(const uint8_t *data, size_t length);
+  void handle_rtk_data(const uint8_t *data, size_t length);
   bool connect();
   bool disconnect();
   bool login();
   bool logout();
   void stream_status_check();
-  void publish_rtk_data(size_t length);
-  void push_gpgga(size_t length);
-
-  static constexpr size_t BUFFER_SIZE = 2048;
-  uint8_t _buffer[BUFFER_SIZE] = {0};
-  uint8_t _buffer_rtk[BUFFER_SIZE] = {0};
+  void publish_rtk_data(const uint8_t *data, size_t length);
+  void push_gpgga(const uint8_t *data, size_t length);
 
   std::shared_ptr<Stream> _data_stream;
   std::shared_ptr<Stream> _command_stream;
@@ -80,9 +78,12 @@ class RawStream {
   const ros::Publisher _rtk_data_publisher;
   const ros::Publisher _stream_status_publisher;
 
+  // Set when raw data goes to an in-process parser instead of the ROS topic.
+  RawDataChannel *_raw_data_channel = nullptr;
+
   boost::shared_ptr<apollo::common::gnss_status::StreamStatus> _stream_status;
-  std::unique_ptr<std::thread> _data_thread_ptr;
-  std::unique_ptr<std::thread> _rtk_thread_ptr;
+  // Reads the data stream and the rtk_from stream on one thread.
+  StreamReactor _reactor;
 };
 
 }  // namespace apollo
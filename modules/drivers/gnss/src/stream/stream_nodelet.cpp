@@ -51,6 +51,7 @@ void StreamNodelet::onInit() {
   std::string raw_data_topic;
   std::string rtcm_data_topic;
   std::string stream_status_topic;
+  bool inprocess_raw_data = false;
 
   nh.param("gnss_conf", gnss_conf, std::string("./conf/gnss_conf.txt"));
   nh.param("raw_data_topic", raw_data_topic,
@@ -59,13 +60,15 @@ void StreamNodelet::onInit() {
            std::string("/apollo/sensor/gnss/rtcm_data"));
   nh.param("stream_status_topic", stream_status_topic,
            std::string("/apollo/sensor/gnss/stream_status"));
+  nh.param("inprocess_raw_data", inprocess_raw_data, false);
 
   ROS_INFO_STREAM("gnss conf: " << gnss_conf);
   ROS_INFO_STREAM("raw data topic: " << raw_data_topic);
 
   init_signal();
   _raw_stream.reset(new RawStream(nh, getName(), raw_data_topic,
-                                  rtcm_data_topic, stream_status_topic));
+                                  rtcm_data_topic, stream_status_topic,
+                                  inprocess_raw_data));
   if (!_raw_stream->init(gnss_conf)) {
     ROS_ERROR("Init stream nodelet failed.");
     ROS_ERROR_STREAM("Init stream nodelet failed.");
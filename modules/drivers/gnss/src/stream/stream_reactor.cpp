@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <ros/ros.h>
+
+#include "gnss/stream_reactor.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+constexpr size_t StreamReactor::BUFFER_SIZE;
+constexpr int StreamReactor::IDLE_READ_INTERVAL_MS;
+constexpr int StreamReactor::IDLE_READ_SLACK_MS;
+
+StreamReactor::StreamReactor() {}
+
+StreamReactor::~StreamReactor() {
+  stop();
+  if (_wakeup_fd >= 0) {
+    ::close(_wakeup_fd);
+  }
+  if (_epoll_fd >= 0) {
+    ::close(_epoll_fd);
+  }
+}
+
+void StreamReactor::add(Stream *stream, Callback callback) {
+  std::unique_ptr<Handle> handle(new Handle());
+  handle->stream = stream;
+  handle->callback = callback;
+  handle->buffer.resize(BUFFER_SIZE);
+  _handles.emplace_back(std::move(handle));
+}
+
+bool StreamReactor::start() {
+  _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (_epoll_fd < 0) {
+    ROS_ERROR_STREAM("Create epoll failed, error: " << strerror(errno));
+    return false;
+  }
+
+  // Registered with a null handle to wake the thread up in stop().
+  _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  if (_wakeup_fd < 0 ||
+      epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &event) < 0) {
+    ROS_ERROR_STREAM("Create wakeup event failed, error: " << strerror(errno));
+    return false;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  for (auto &handle : _handles) {
+    handle->last_read = now;
+    update_registration(handle.get());
+  }
+
+  _running = true;
+  _thread.reset(new std::thread(&StreamReactor::spin, this));
+  return true;
+}
+
+void StreamReactor::stop() {
+  if (!_thread) {
+    return;
+  }
+  _running = false;
+  wake_up();
+  _thread->join();
+  _thread.reset();
+}
+
+void StreamReactor::wake_up() {
+  uint64_t one = 1;
+  if (::write(_wakeup_fd, &one, sizeof(one)) < 0) {
+    ROS_ERROR_STREAM("Wake up reactor failed, error: " << strerror(errno));
+  }
+}
+
+void StreamReactor::spin() {
+  static constexpr int MAX_EVENTS = 16;
+  epoll_event events[MAX_EVENTS];
+
+  while (_running) {
+    int n = epoll_wait(_epoll_fd, events, MAX_EVENTS, idle_read_timeout_ms());
+    ++_wakeups;
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ROS_ERROR_STREAM("Epoll wait failed, error: " << strerror(errno));
+      return;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      Handle *handle = static_cast<Handle *>(events[i].data.ptr);
+      if (handle == nullptr) {
+        uint64_t count = 0;
+        if (::read(_wakeup_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+          ROS_ERROR_STREAM("Read wakeup event failed, error: "
+                           << strerror(errno));
+        }
+        continue;
+      }
+      const size_t length = read(handle);
+      // The stream may have reconnected inside read(). A closed descriptor
+      // leaves epoll by itself and a new one may reuse the same number, so
+      // register again whenever the read came back empty.
+      if (length == 0 || handle->stream->fd() != handle->fd) {
+        update_registration(handle);
+      }
+      if (length == 0 && (events[i].events & (EPOLLHUP | EPOLLERR))) {
+        // The stream did not recover by itself. Stop listening so a hung up
+        // descriptor does not spin the loop; the idle read retries it.
+        unregister(handle);
+      }
+    }
+
+    read_idle_streams();
+  }
+}
+
+int StreamReactor::idle_read_timeout_ms() const {
+  const auto now = std::chrono::steady_clock::now();
+  auto next_read = now + std::chrono::milliseconds(IDLE_READ_INTERVAL_MS);
+  for (const auto &handle : _handles) {
+    next_read = std::min(
+        next_read,
+        handle->last_read + std::chrono::milliseconds(IDLE_READ_INTERVAL_MS));
+  }
+  // Rounded up, so that the reactor does not wake up just before the read.
+  const auto timeout =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          next_read - now + std::chrono::milliseconds(1) -
+          std::chrono::nanoseconds(1));
+  return std::max(0, static_cast<int>(timeout.count()));
+}
+
+void StreamReactor::read_idle_streams() {
+  // Streams due soon are read as well, so that idle streams share wakeups.
+  const auto now = std::chrono::steady_clock::now() +
+                   std::chrono::milliseconds(IDLE_READ_SLACK_MS);
+  for (auto &handle : _handles) {
+    if (now - handle->last_read <
+        std::chrono::milliseconds(IDLE_READ_INTERVAL_MS)) {
+      continue;
+    }
+    // Lets the stream reconnect, and registers its new descriptor if any.
+    read(handle.get());
+    update_registration(handle.get());
+  }
+}
+
+size_t StreamReactor::read(Handle *handle) {
+  const size_t length =
+      handle->stream->read(handle->buffer.data(), handle->buffer.size());
+  handle->last_read = std::chrono::steady_clock::now();
+  handle->callback(handle->buffer.data(), length);
+  return length;
+}
+
+void StreamReactor::update_registration(Handle *handle) {
+  const int fd = handle->stream->fd();
+  if (fd != handle->fd) {
+    unregister(handle);
+  }
+  if (fd < 0) {
+    return;
+  }
+
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = handle;
+  if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0 &&
+      errno != EEXIST) {
+    ROS_ERROR_STREAM("Epoll add fd " << fd
+                                     << " failed, error: " << strerror(errno));
+    return;
+  }
+  handle->fd = fd;
+}
+
+void StreamReactor::unregister(Handle *handle) {
+  if (handle->fd < 0) {
+    return;
+  }
+  // The old number may already belong to another stream after a reconnect.
+  bool shared = false;
+  for (const auto &other : _handles) {
+    if (other.get() != handle && other->fd == handle->fd) {
+      shared = true;
+    }
+  }
+  if (!shared) {
+    // Fails harmlessly if the descriptor is already closed.
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, handle->fd, nullptr);
+  }
+  handle->fd = -1;
+}
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
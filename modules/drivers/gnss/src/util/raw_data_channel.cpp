@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <chrono>
+#include <map>
+#include <memory>
+
+#include "gnss/raw_data_channel.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+RawDataChannel *RawDataChannel::get(const std::string &name) {
+  static std::mutex registry_mutex;
+  static std::map<std::string, std::unique_ptr<RawDataChannel>> registry;
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto &channel = registry[name];
+  if (!channel) {
+    channel.reset(new RawDataChannel());
+  }
+  return channel.get();
+}
+
+size_t RawDataChannel::write(const uint8_t *data, size_t length) {
+  size_t written = _ring.write(data, length);
+  _dropped_bytes += length - written;
+  {
+    // Take the lock so the wakeup cannot slip in between the consumer's
+    // emptiness check and its wait.
+    std::lock_guard<std::mutex> lock(_mutex);
+  }
+  _cv.notify_one();
+  return written;
+}
+
+size_t RawDataChannel::read(uint8_t *data, size_t max_length,
+                            uint32_t timeout_ms) {
+  if (_ring.empty()) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                 [this] { return !_ring.empty(); });
+  }
+  return _ring.read(data, max_length);
+}
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
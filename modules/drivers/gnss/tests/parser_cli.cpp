@@ -16,12 +16,18 @@
 
 // A command-line interface (CLI) tool of parser. It parses a binary log file.
 // It is supposed to be
-// used for verifying if the parser works properly.
+// used for verifying if the parser works properly. With a third argument it
+// also serves as a throughput benchmark, e.g. on test_data/novatel.bin.
 
 #include <ros/ros.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <vector>
 
 #include "gnss/parser.h"
 #include "gnss/stream.h"
@@ -32,18 +38,23 @@ namespace gnss {
 
 constexpr size_t BUFFER_SIZE = 128;
 
-void Parse(const char* filename, char parser_type) {
-  std::ios::sync_with_stdio(false);
-  std::ifstream f(filename, std::ifstream::binary);
-  char b[BUFFER_SIZE];
-  std::unique_ptr<Parser> p;
+Parser* CreateParser(char parser_type) {
   switch (parser_type) {
     case 'n':
-      p.reset(Parser::create_novatel());
-      break;
+      return Parser::create_novatel();
     default:
       std::cout << "Log type should be either 'n' or 'u'" << std::endl;
-      return;
+      return nullptr;
+  }
+}
+
+void Parse(const char* filename, char parser_type) {
+  std::ios::sync_with_stdio(false);
+  std::ifstream f(filename, std::ifstream::binary);
+  char b[BUFFER_SIZE];
+  std::unique_ptr<Parser> p(CreateParser(parser_type));
+  if (!p) {
+    return;
   }
   while (f) {
     f.read(b, BUFFER_SIZE);
@@ -58,17 +69,68 @@ void Parse(const char* filename, char parser_type) {
   }
 }
 
+// Parses the whole file in chunks of chunk_size bytes, repeat times, and
+// reports the decoding throughput.
+void Benchmark(const char* filename, char parser_type, size_t chunk_size,
+               int repeat) {
+  std::ifstream f(filename, std::ifstream::binary);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(f)),
+                            std::istreambuf_iterator<char>());
+  std::unique_ptr<Parser> p(CreateParser(parser_type));
+  if (!p || data.empty() || chunk_size == 0) {
+    return;
+  }
+
+  size_t message_count = 0;
+  size_t imu_count = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+      size_t length = std::min(chunk_size, data.size() - offset);
+      p->update(data.data() + offset, length);
+      for (;;) {
+        MessagePtr msg_ptr;
+        Parser::MessageType type = p->get_message(msg_ptr);
+        if (type == Parser::MessageType::NONE) {
+          break;
+        }
+        ++message_count;
+        if (type == Parser::MessageType::IMU) {
+          ++imu_count;
+        }
+      }
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::cout << "chunk size: " << chunk_size << " bytes, "
+            << "messages: " << message_count << " (imu: " << imu_count
+            << "), " << data.size() * repeat / seconds / 1e6 << " MB/s, "
+            << message_count / seconds << " messages/s" << std::endl;
+}
+
 }  // namespace gnss
 }  // namespace drivers
 }  // namespace apollo
 
 int main(int argc, char** argv) {
-  if (argc != 3) {
-    std::cout << "Usage: " << argv[0] << " filename [n|u]" << std::endl;
+  if (argc != 3 && argc != 4) {
+    std::cout << "Usage: " << argv[0] << " filename [n|u] [repeat]"
+              << std::endl;
     return 0;
   }
 
   ros::Time::init();
+  if (argc == 4) {
+    int repeat = std::atoi(argv[3]);
+    for (size_t chunk_size : {128, 2048, 65536}) {
+      ::apollo::drivers::gnss::Benchmark(argv[1], argv[2][0], chunk_size,
+                                         repeat);
+    }
+    return 0;
+  }
   ::apollo::drivers::gnss::Parse(argv[1], argv[2][0]);
   return 0;
 }
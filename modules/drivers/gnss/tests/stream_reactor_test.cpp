@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Feeds a serial stream through a pseudo terminal and a tcp stream through a
+// loopback socket into one StreamReactor, checks that every byte arrives in
+// order and reports reads and wakeups per second while busy and while idle.
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include "gnss/stream.h"
+#include "gnss/stream_reactor.h"
+
+using apollo::drivers::gnss::Stream;
+using apollo::drivers::gnss::StreamReactor;
+
+namespace {
+
+struct Sink {
+  std::mutex mutex;
+  std::vector<uint8_t> data;
+  size_t reads = 0;
+
+  void append(const uint8_t *bytes, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (length > 0) {
+      data.insert(data.end(), bytes, bytes + length);
+      ++reads;
+    }
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return data.size();
+  }
+};
+
+int open_pty(std::string *slave_name) {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) {
+    return -1;
+  }
+  // Raw mode on the master side too, so no byte is translated.
+  termios options;
+  tcgetattr(master, &options);
+  cfmakeraw(&options);
+  tcsetattr(master, TCSANOW, &options);
+  *slave_name = ptsname(master);
+  return master;
+}
+
+int listen_loopback(uint16_t *port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  if (fd < 0 || bind(fd, reinterpret_cast<sockaddr *>(&addr), addr_len) < 0 ||
+      listen(fd, 1) < 0 ||
+      getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addr_len) < 0) {
+    return -1;
+  }
+  *port = ntohs(addr.sin_port);
+  return fd;
+}
+
+bool write_all(int fd, const uint8_t *data, size_t length) {
+  while (length > 0) {
+    ssize_t n = ::write(fd, data, length);
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    length -= n;
+  }
+  return true;
+}
+
+bool wait_for_size(Sink *sink, size_t size) {
+  for (int i = 0; i < 500 && sink->size() < size; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return sink->size() == size;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  ros::Time::init();
+  const int seconds = argc > 1 ? atoi(argv[1]) : 2;
+
+  std::string pty_name;
+  const int pty_master = open_pty(&pty_name);
+  uint16_t port = 0;
+  const int listen_fd = listen_loopback(&port);
+  if (pty_master < 0 || listen_fd < 0) {
+    fprintf(stderr, "Failed to create the pty or the loopback socket.\n");
+    return 1;
+  }
+
+  std::unique_ptr<Stream> serial(
+      Stream::create_serial(pty_name.c_str(), 115200));
+  std::unique_ptr<Stream> tcp(Stream::create_tcp("127.0.0.1", port, 0));
+  if (!serial->connect() || !tcp->connect()) {
+    fprintf(stderr, "Failed to connect the streams.\n");
+    return 1;
+  }
+  const int peer_fd = accept(listen_fd, nullptr, nullptr);
+
+  Sink serial_sink;
+  Sink tcp_sink;
+  StreamReactor reactor;
+  reactor.add(serial.get(), [&serial_sink](const uint8_t *data,
+                                           size_t length) {
+    serial_sink.append(data, length);
+  });
+  reactor.add(tcp.get(), [&tcp_sink](const uint8_t *data, size_t length) {
+    tcp_sink.append(data, length);
+  });
+  if (!reactor.start()) {
+    return 1;
+  }
+
+  // About 100 kB/s per stream in 100 byte chunks, i.e. a busy receiver.
+  std::vector<uint8_t> sent;
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t wakeups = reactor.wakeups();
+  for (int i = 0; i < seconds * 1000; ++i) {
+    uint8_t chunk[100];
+    for (auto &byte : chunk) {
+      byte = static_cast<uint8_t>(rand());
+    }
+    if (!write_all(pty_master, chunk, sizeof(chunk)) ||
+        !write_all(peer_fd, chunk, sizeof(chunk))) {
+      fprintf(stderr, "Write failed.\n");
+      return 1;
+    }
+    sent.insert(sent.end(), chunk, chunk + sizeof(chunk));
+    std::this_thread::sleep_until(start + std::chrono::milliseconds(i + 1));
+  }
+  if (!wait_for_size(&serial_sink, sent.size()) ||
+      !wait_for_size(&tcp_sink, sent.size())) {
+    fprintf(stderr, "Lost data: sent %zu, serial got %zu, tcp got %zu.\n",
+            sent.size(), serial_sink.size(), tcp_sink.size());
+    return 1;
+  }
+  if (serial_sink.data != sent || tcp_sink.data != sent) {
+    fprintf(stderr, "Received data differs from sent data.\n");
+    return 1;
+  }
+  printf("busy: %zu bytes per stream, %.0f serial reads/s, %.0f tcp reads/s, "
+         "%.0f wakeups/s\n",
+         sent.size(), static_cast<double>(serial_sink.reads) / seconds,
+         static_cast<double>(tcp_sink.reads) / seconds,
+         static_cast<double>(reactor.wakeups() - wakeups) / seconds);
+
+  wakeups = reactor.wakeups();
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  printf("idle: %.1f wakeups/s\n",
+         static_cast<double>(reactor.wakeups() - wakeups) / seconds);
+
+  reactor.stop();
+  close(peer_fd);
+  close(listen_fd);
+  close(pty_master);
+  printf("PASS\n");
+  return 0;
+}
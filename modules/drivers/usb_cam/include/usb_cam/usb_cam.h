@@ -76,9 +76,13 @@ class UsbCam {
     UsbCam();
     ~UsbCam();
 
-    // start camera
+    // start camera. output_rgb converts YUYV/UYVY frames to rgb8 before
+    // publishing; MJPEG and RGB24 are always published as rgb8. zero_copy
+    // (mmap io only) processes each frame straight from the driver buffer
+    // into the message instead of staging it in an intermediate image.
     void start(const std::string& dev, io_method io, pixel_format pf,
-            int image_width, int image_height, int framerate);
+            int image_width, int image_height, int framerate,
+            bool output_rgb = false, bool zero_copy = false);
     // shutdown camera
     void shutdown(void);
 
@@ -119,7 +123,7 @@ private:
 
     int init_mjpeg_decoder(int image_width, int image_height);
     void mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels);
-    bool process_image(const void * src, int len, boost::shared_ptr<CameraImage> dest);
+    bool process_image(const void * src, int len, char *dest);
     int read_frame();
     void uninit_device(void);
     void init_read(unsigned int buffer_size);
@@ -131,6 +135,8 @@ private:
     // TODO
     //void reset_device(void);
     bool grab_image(int timeout);
+    // Returns the zero copy buffer to the driver if one is still dequeued.
+    void requeue_mapped_buffer();
 
     bool is_capturing_;
     std::string camera_dev_;
@@ -149,6 +155,12 @@ private:
     int avframe_rgb_size_;
     struct SwsContext *video_sws_;
     boost::shared_ptr<CameraImage> image_;
+    bool output_rgb_;
+    bool zero_copy_;
+    // In zero copy mode, the buffer dequeued by read_frame() that
+    // grab_image() still has to process and requeue.
+    struct v4l2_buffer mapped_buffer_;
+    bool mapped_buffer_pending_;
 };
 
 }
@@ -0,0 +1,36 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Packed YUV 4:2:2 to RGB24 conversion. The vectorized versions produce
+// exactly the same bytes as the per-pixel ones.
+
+#ifndef USB_CAM_YUV2RGB_H
+#define USB_CAM_YUV2RGB_H
+
+namespace usb_cam {
+
+// Converts NumPixels pixels of YUYV (resp. UYVY) to RGB24. NumPixels must be
+// even. Uses AVX2 when the library is built with it.
+void yuyv2rgb(const char *YUV, char *RGB, int NumPixels);
+void uyvy2rgb(const char *YUV, char *RGB, int NumPixels);
+
+// Per-pixel reference implementations.
+void yuyv2rgb_scalar(const char *YUV, char *RGB, int NumPixels);
+void uyvy2rgb_scalar(const char *YUV, char *RGB, int NumPixels);
+
+}
+
+#endif
@@ -23,6 +23,10 @@ UsbCamWrapper::UsbCamWrapper(ros::NodeHandle node, ros::NodeHandle private_nh) :
   priv_node_.param("frame_rate", framerate_, 30);
   // possible values: yuyv, uyvy, mjpeg, yuvmono10, rgb24
   priv_node_.param("pixel_format", pixel_format_name_, std::string("mjpeg"));
+  // publish yuyv/uyvy frames as rgb8 instead of the raw camera format
+  priv_node_.param("output_rgb", output_rgb_, false);
+  // process mmap frames straight into the message without staging them
+  priv_node_.param("zero_copy", zero_copy_, false);
   // enable/disable autofocus
   priv_node_.param("autofocus", autofocus_, false);
   priv_node_.param("focus", focus_, -1); //0-255, -1 "leave alone"
@@ -117,7 +121,7 @@ UsbCamWrapper::UsbCamWrapper(ros::NodeHandle node, ros::NodeHandle private_nh) :
 
   // start the camera
   cam_.start(video_device_name_.c_str(), io_method, pixel_format, image_width_, image_height_,
-         framerate_);
+         framerate_, output_rgb_, zero_copy_);
 
   // set camera parameters
   if (brightness_ >= 0)
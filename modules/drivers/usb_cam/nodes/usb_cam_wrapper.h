@@ -63,6 +63,8 @@ class UsbCamWrapper {
   bool autofocus_;
   bool autoexposure_;
   bool auto_white_balance_;
+  bool output_rgb_;
+  bool zero_copy_;
 
   // usb will be reset when camera timeout
   int cam_timeout_;
@@ -51,10 +51,10 @@
 #include <sstream>
 
 #include <ros/ros.h>
-#include <sensor_msgs/fill_image.h>
 #include <boost/lexical_cast.hpp>
 
 #include <usb_cam/usb_cam.h>
+#include <usb_cam/yuv2rgb.h>
 
 #define CLEAR(x) memset(&(x), 0, sizeof(x))
 
@@ -75,154 +75,7 @@ static int xioctl(int fd, int request, void *arg) {
   return r;
 }
 
-const unsigned char uchar_clipping_table[] = {
-    0,   0,   0,   0,   0,   0,   0,
-    0,  // -128 - -121
-    0,   0,   0,   0,   0,   0,   0,
-    0,  // -120 - -113
-    0,   0,   0,   0,   0,   0,   0,
-    0,  // -112 - -105
-    0,   0,   0,   0,   0,   0,   0,
-    0,  // -104 -  -97
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -96 -  -89
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -88 -  -81
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -80 -  -73
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -72 -  -65
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -64 -  -57
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -56 -  -49
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -48 -  -41
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -40 -  -33
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -32 -  -25
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -24 -  -17
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //  -16 -   -9
-    0,   0,   0,   0,   0,   0,   0,
-    0,  //   -8 -   -1
-    0,   1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
-    15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,
-    30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,
-    45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,
-    60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,
-    75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,
-    90,  91,  92,  93,  94,  95,  96,  97,  98,  99,  100, 101, 102, 103, 104,
-    105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119,
-    120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134,
-    135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149,
-    150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164,
-    165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179,
-    180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
-    195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209,
-    210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224,
-    225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
-    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254,
-    255, 255, 255, 255, 255, 255, 255, 255, 255,  // 256-263
-    255, 255, 255, 255, 255, 255, 255, 255,       // 264-271
-    255, 255, 255, 255, 255, 255, 255, 255,       // 272-279
-    255, 255, 255, 255, 255, 255, 255, 255,       // 280-287
-    255, 255, 255, 255, 255, 255, 255, 255,       // 288-295
-    255, 255, 255, 255, 255, 255, 255, 255,       // 296-303
-    255, 255, 255, 255, 255, 255, 255, 255,       // 304-311
-    255, 255, 255, 255, 255, 255, 255, 255,       // 312-319
-    255, 255, 255, 255, 255, 255, 255, 255,       // 320-327
-    255, 255, 255, 255, 255, 255, 255, 255,       // 328-335
-    255, 255, 255, 255, 255, 255, 255, 255,       // 336-343
-    255, 255, 255, 255, 255, 255, 255, 255,       // 344-351
-    255, 255, 255, 255, 255, 255, 255, 255,       // 352-359
-    255, 255, 255, 255, 255, 255, 255, 255,       // 360-367
-    255, 255, 255, 255, 255, 255, 255, 255,       // 368-375
-    255, 255, 255, 255, 255, 255, 255, 255,       // 376-383
-};
-const int clipping_table_offset = 128;
-
-/** Clip a value to the range 0<val<255. For speed this is done using an
- * array, so can only cope with numbers in the range -128<val<383.
- */
-static unsigned char CLIPVALUE(int val) {
-  // Old method (if)
-  /*   val = val < 0 ? 0 : val; */
-  /*   return val > 255 ? 255 : val; */
-
-  // New method (array)
-  return uchar_clipping_table[val + clipping_table_offset];
-}
-
-/**
- * Conversion from YUV to RGB.
- * The normal conversion matrix is due to Julien (surname unknown):
- *
- * [ R ]   [  1.0   0.0     1.403 ] [ Y ]
- * [ G ] = [  1.0  -0.344  -0.714 ] [ U ]
- * [ B ]   [  1.0   1.770   0.0   ] [ V ]
- *
- * and the firewire one is similar:
- *
- * [ R ]   [  1.0   0.0     0.700 ] [ Y ]
- * [ G ] = [  1.0  -0.198  -0.291 ] [ U ]
- * [ B ]   [  1.0   1.015   0.0   ] [ V ]
- *
- * Corrected by BJT (coriander's transforms RGB->YUV and YUV->RGB
- *                   do not get you back to the same RGB!)
- * [ R ]   [  1.0   0.0     1.136 ] [ Y ]
- * [ G ] = [  1.0  -0.396  -0.578 ] [ U ]
- * [ B ]   [  1.0   2.041   0.002 ] [ V ]
- *
- */
-static void YUV2RGB(const unsigned char y, const unsigned char u,
-                    const unsigned char v, unsigned char *r, unsigned char *g,
-                    unsigned char *b) {
-  const int y2 = (int)y;
-  const int u2 = (int)u - 128;
-  const int v2 = (int)v - 128;
-  // std::cerr << "YUV=("<<y2<<","<<u2<<","<<v2<<")"<<std::endl;
-
-  // This is the normal YUV conversion, but
-  // appears to be incorrect for the firewire cameras
-  //   int r2 = y2 + ( (v2*91947) >> 16);
-  //   int g2 = y2 - ( ((u2*22544) + (v2*46793)) >> 16 );
-  //   int b2 = y2 + ( (u2*115999) >> 16);
-  // This is an adjusted version (UV spread out a bit)
-  int r2 = y2 + ((v2 * 37221) >> 15);
-  int g2 = y2 - (((u2 * 12975) + (v2 * 18949)) >> 15);
-  int b2 = y2 + ((u2 * 66883) >> 15);
-  // std::cerr << "   RGB=("<<r2<<","<<g2<<","<<b2<<")"<<std::endl;
-
-  // Cap the values.
-  *r = CLIPVALUE(r2);
-  *g = CLIPVALUE(g2);
-  *b = CLIPVALUE(b2);
-}
-
-void uyvy2rgb(char *YUV, char *RGB, int NumPixels) {
-  int i, j;
-  unsigned char y0, y1, u, v;
-  unsigned char r, g, b;
-  for (i = 0, j = 0; i < (NumPixels << 1); i += 4, j += 6) {
-    u = (unsigned char)YUV[i + 0];
-    y0 = (unsigned char)YUV[i + 1];
-    v = (unsigned char)YUV[i + 2];
-    y1 = (unsigned char)YUV[i + 3];
-    YUV2RGB(y0, u, v, &r, &g, &b);
-    RGB[j + 0] = r;
-    RGB[j + 1] = g;
-    RGB[j + 2] = b;
-    YUV2RGB(y1, u, v, &r, &g, &b);
-    RGB[j + 3] = r;
-    RGB[j + 4] = g;
-    RGB[j + 5] = b;
-  }
-}
-
-static void mono102mono8(char *RAW, char *MONO, int NumPixels) {
+static void mono102mono8(const char *RAW, char *MONO, int NumPixels) {
   int i, j;
   for (i = 0, j = 0; i < (NumPixels << 1); i += 2, j += 1) {
     // first byte is low byte, second byte is high byte; smash together and
@@ -232,30 +85,10 @@ static void mono102mono8(char *RAW, char *MONO, int NumPixels) {
   }
 }
 
-static void yuyv2rgb(char *YUV, char *RGB, int NumPixels) {
-  int i, j;
-  unsigned char y0, y1, u, v;
-  unsigned char r, g, b;
-
-  for (i = 0, j = 0; i < (NumPixels << 1); i += 4, j += 6) {
-    y0 = (unsigned char)YUV[i + 0];
-    u = (unsigned char)YUV[i + 1];
-    y1 = (unsigned char)YUV[i + 2];
-    v = (unsigned char)YUV[i + 3];
-    YUV2RGB(y0, u, v, &r, &g, &b);
-    RGB[j + 0] = r;
-    RGB[j + 1] = g;
-    RGB[j + 2] = b;
-    YUV2RGB(y1, u, v, &r, &g, &b);
-    RGB[j + 3] = r;
-    RGB[j + 4] = g;
-    RGB[j + 5] = b;
-  }
-}
-
-void rgb242rgb(char *YUV, char *RGB, int NumPixels) {
+static void rgb242rgb(const char *YUV, char *RGB, int NumPixels) {
   memcpy(RGB, YUV, NumPixels * 3);
 }
+
 UsbCam::UsbCam()
     : io_(IO_METHOD_MMAP),
       fd_(-1),
@@ -269,6 +102,9 @@ UsbCam::UsbCam()
       avframe_rgb_size_(0),
       video_sws_(NULL),
       image_(NULL),
+      output_rgb_(false),
+      zero_copy_(false),
+      mapped_buffer_pending_(false),
       is_capturing_(false) {}
 UsbCam::~UsbCam() {
   shutdown();
@@ -315,8 +151,6 @@ int UsbCam::init_mjpeg_decoder(int image_width, int image_height) {
 void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
   int got_picture;
 
-  memset(RGB, 0, avframe_rgb_size_);
-
 #if LIBAVCODEC_VERSION_MAJOR > 52
   int decoded_len;
   AVPacket avpkt;
@@ -329,6 +163,7 @@ void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
 
   if (decoded_len < 0) {
     ROS_ERROR("Error while decoding frame.");
+    memset(RGB, 0, avframe_rgb_size_);
     return;
   }
 #else
@@ -338,6 +173,7 @@ void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
 
   if (!got_picture) {
     ROS_ERROR("Webcam: expected picture but didn't get it...");
+    memset(RGB, 0, avframe_rgb_size_);
     return;
   }
 
@@ -347,33 +183,51 @@ void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
   if (pic_size != avframe_camera_size_) {
     ROS_ERROR("outbuf size mismatch.  pic_size: %d bufsize: %d", pic_size,
               avframe_camera_size_);
+    memset(RGB, 0, avframe_rgb_size_);
     return;
   }
 
-  video_sws_ =
-      sws_getContext(xsize, ysize, avcodec_context_->pix_fmt, xsize, ysize,
-                     PIX_FMT_RGB24, SWS_BILINEAR, NULL, NULL, NULL);
-  sws_scale(video_sws_, avframe_camera_->data, avframe_camera_->linesize, 0,
-            ysize, avframe_rgb_->data, avframe_rgb_->linesize);
-  sws_freeContext(video_sws_);
-
-  int size = avpicture_layout((AVPicture *)avframe_rgb_, PIX_FMT_RGB24, xsize,
-                              ysize, (uint8_t *)RGB, avframe_rgb_size_);
-  if (size != avframe_rgb_size_) {
-    ROS_ERROR("webcam: avpicture_layout error: %d", size);
+  // The scaler is created on the first frame and only rebuilt if the decoded
+  // format changes.
+  video_sws_ = sws_getCachedContext(video_sws_, xsize, ysize,
+                                    avcodec_context_->pix_fmt, xsize, ysize,
+                                    PIX_FMT_RGB24, SWS_BILINEAR, NULL, NULL,
+                                    NULL);
+  if (!video_sws_) {
+    ROS_ERROR("Could not create the scaling context.");
+    memset(RGB, 0, avframe_rgb_size_);
     return;
   }
+
+  // Scale straight into the output buffer instead of through avframe_rgb_.
+  AVPicture rgb_picture;
+  avpicture_fill(&rgb_picture, (uint8_t *)RGB, PIX_FMT_RGB24, xsize, ysize);
+  sws_scale(video_sws_, avframe_camera_->data, avframe_camera_->linesize, 0,
+            ysize, rgb_picture.data, rgb_picture.linesize);
 }
 
-bool UsbCam::process_image(const void *src, int len,
-                           boost::shared_ptr<CameraImage> dest) {
+bool UsbCam::process_image(const void *src, int len, char *dest) {
   if (src == NULL || dest == NULL) {
     ROS_ERROR("process image error. len: %d, width: %d, height: %d", len,
-              dest->width, dest->height);
+              image_->width, image_->height);
     return false;
   }
-  if (pixelformat_ == V4L2_PIX_FMT_YUYV || pixelformat_ == V4L2_PIX_FMT_UYVY) {
-    memcpy(dest->image, src, dest->width * dest->height * 2);
+  const int pixels = image_->width * image_->height;
+  if (monochrome_) {
+    mono102mono8((const char *)src, dest, pixels);
+  } else if (pixelformat_ == V4L2_PIX_FMT_YUYV ||
+             pixelformat_ == V4L2_PIX_FMT_UYVY) {
+    if (!output_rgb_) {
+      memcpy(dest, src, pixels * 2);
+    } else if (pixelformat_ == V4L2_PIX_FMT_YUYV) {
+      yuyv2rgb((const char *)src, dest, pixels);
+    } else {
+      uyvy2rgb((const char *)src, dest, pixels);
+    }
+  } else if (pixelformat_ == V4L2_PIX_FMT_MJPEG) {
+    mjpeg2rgb((char *)src, len, dest, pixels);
+  } else if (pixelformat_ == V4L2_PIX_FMT_RGB24) {
+    rgb242rgb((const char *)src, dest, pixels);
   } else {
     ROS_ERROR("unsupported pixel format: %d", pixelformat_);
     return false;
@@ -405,7 +259,7 @@ int UsbCam::read_frame() {
         }
       }
 
-      result = process_image(buffers_[0].start, len, image_);
+      result = process_image(buffers_[0].start, len, image_->image);
       if (!result) {
         return 0;
       }
@@ -413,6 +267,10 @@ int UsbCam::read_frame() {
       break;
 
     case IO_METHOD_MMAP:
+      // A frame left dequeued by a previous call that nobody processed would
+      // be lost to the driver once mapped_buffer_ is overwritten below.
+      requeue_mapped_buffer();
+
       CLEAR(buf);
 
       buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -439,7 +297,15 @@ int UsbCam::read_frame() {
       image_->tv_usec = buf.timestamp.tv_usec;
       ROS_DEBUG("new image timestamp: %d.%d", image_->tv_sec, image_->tv_usec);
 
-      result = process_image(buffers_[buf.index].start, len, image_);
+      if (zero_copy_) {
+        // Leave the buffer dequeued; grab_image() processes the frame
+        // straight out of it into the message and requeues it.
+        mapped_buffer_ = buf;
+        mapped_buffer_pending_ = true;
+        break;
+      }
+
+      result = process_image(buffers_[buf.index].start, len, image_->image);
       if (!result) {
         return 0;
       }
@@ -476,7 +342,7 @@ int UsbCam::read_frame() {
 
       assert(i < n_buffers_);
       len = buf.bytesused;
-      result = process_image((void *)buf.m.userptr, len, image_);
+      result = process_image((void *)buf.m.userptr, len, image_->image);
       if (!result) {
         return 0;
       }
@@ -499,6 +365,8 @@ void UsbCam::stop_capturing(void) {
   }
 
   is_capturing_ = false;
+  // Streaming off returns every buffer to the driver.
+  mapped_buffer_pending_ = false;
   enum v4l2_buf_type type;
 
   switch (io_) {
@@ -854,17 +722,23 @@ void UsbCam::open_device(void) {
 
 void UsbCam::start(const std::string &dev, io_method io_method,
                    pixel_format pixel_format, int image_width, int image_height,
-                   int framerate) {
+                   int framerate, bool output_rgb, bool zero_copy) {
   camera_dev_ = dev;
 
   io_ = io_method;
   monochrome_ = false;
+  output_rgb_ = output_rgb;
+  zero_copy_ = zero_copy && io_method == IO_METHOD_MMAP;
+  if (zero_copy && !zero_copy_) {
+    ROS_WARN("zero copy is only supported with the mmap io method.");
+  }
   if (pixel_format == PIXEL_FORMAT_YUYV)
     pixelformat_ = V4L2_PIX_FMT_YUYV;
   else if (pixel_format == PIXEL_FORMAT_UYVY)
     pixelformat_ = V4L2_PIX_FMT_UYVY;
   else if (pixel_format == PIXEL_FORMAT_MJPEG) {
     pixelformat_ = V4L2_PIX_FMT_MJPEG;
+    output_rgb_ = true;
     init_mjpeg_decoder(image_width, image_height);
   } else if (pixel_format == PIXEL_FORMAT_YUVMONO10) {
     // actually format V4L2_PIX_FMT_Y16 (10-bit mono expresed as 16-bit pixels),
@@ -873,6 +747,7 @@ void UsbCam::start(const std::string &dev, io_method io_method,
     monochrome_ = true;
   } else if (pixel_format == PIXEL_FORMAT_RGB24) {
     pixelformat_ = V4L2_PIX_FMT_RGB24;
+    output_rgb_ = true;
   } else {
     ROS_ERROR("Unknown pixel format.");
     exit(EXIT_FAILURE);
@@ -887,7 +762,14 @@ void UsbCam::start(const std::string &dev, io_method io_method,
 
   image_->width = image_width;
   image_->height = image_height;
-  image_->bytes_per_pixel = 2;  // corrected 11/10/15 (BYTES not BITS per pixel)
+  // BYTES not BITS per pixel of the published image
+  if (monochrome_) {
+    image_->bytes_per_pixel = 1;
+  } else if (output_rgb_) {
+    image_->bytes_per_pixel = 3;
+  } else {
+    image_->bytes_per_pixel = 2;
+  }
 
   image_->image_size = image_->width * image_->height * image_->bytes_per_pixel;
   image_->is_new = 0;
@@ -912,6 +794,8 @@ void UsbCam::shutdown(void) {
   avframe_camera_ = NULL;
   if (avframe_rgb_) av_free(avframe_rgb_);
   avframe_rgb_ = NULL;
+  if (video_sws_) sws_freeContext(video_sws_);
+  video_sws_ = NULL;
 }
 
 bool UsbCam::grab_image(sensor_msgs::Image *msg, int timeout) {
@@ -925,23 +809,39 @@ bool UsbCam::grab_image(sensor_msgs::Image *msg, int timeout) {
   msg->header.stamp.nsec = 1000 * image_->tv_usec;
   // fill the info
   if (monochrome_) {
-    fillImage(*msg, "mono8", image_->height, image_->width, image_->width,
-              image_->image);
+    msg->encoding = "mono8";
+  } else if (output_rgb_) {
+    msg->encoding = "rgb8";
   } else {
-    // fillImage(*msg, "rgb8", image_->height, image_->width, 3 * image_->width,
-    //           image_->image);
     msg->encoding = "yuyv";
-    msg->height = image_->height;
-    msg->width = image_->width;
-    msg->step = 2 * image_->width;
-    size_t len = image_->width * image_->height * 2;
-    msg->data.resize(len);
-    memcpy(&msg->data[0], image_->image, len);
-    msg->is_bigendian = 0;
   }
+  msg->height = image_->height;
+  msg->width = image_->width;
+  msg->step = image_->bytes_per_pixel * image_->width;
+  msg->is_bigendian = 0;
+  // A no-op after the first frame when the caller reuses the message.
+  msg->data.resize(image_->image_size);
+
+  if (mapped_buffer_pending_) {
+    bool result =
+        process_image(buffers_[mapped_buffer_.index].start,
+                      mapped_buffer_.bytesused, (char *)&msg->data[0]);
+    requeue_mapped_buffer();
+    return result;
+  }
+  memcpy(&msg->data[0], image_->image, image_->image_size);
   return true;
 }
 
+void UsbCam::requeue_mapped_buffer() {
+  if (!mapped_buffer_pending_) {
+    return;
+  }
+  mapped_buffer_pending_ = false;
+  if (-1 == xioctl(fd_, VIDIOC_QBUF, &mapped_buffer_))
+    errno_exit("VIDIOC_QBUF");
+}
+
 bool UsbCam::grab_image(int timeout) {
   fd_set fds;
   struct timeval tv;
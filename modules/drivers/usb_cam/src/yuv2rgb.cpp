@@ -0,0 +1,243 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014, Robert Bosch LLC.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Robert Bosch nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************/
+#include <usb_cam/yuv2rgb.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace usb_cam {
+
+/** Clip a value to the range 0<val<255. The lookup table used before could
+ * only cope with -128<val<383, which saturated colors exceed.
+ */
+static unsigned char CLIPVALUE(int val) {
+  return val < 0 ? 0 : (val > 255 ? 255 : val);
+}
+
+/**
+ * Conversion from YUV to RGB.
+ * The normal conversion matrix is due to Julien (surname unknown):
+ *
+ * [ R ]   [  1.0   0.0     1.403 ] [ Y ]
+ * [ G ] = [  1.0  -0.344  -0.714 ] [ U ]
+ * [ B ]   [  1.0   1.770   0.0   ] [ V ]
+ *
+ * and the firewire one is similar:
+ *
+ * [ R ]   [  1.0   0.0     0.700 ] [ Y ]
+ * [ G ] = [  1.0  -0.198  -0.291 ] [ U ]
+ * [ B ]   [  1.0   1.015   0.0   ] [ V ]
+ *
+ * Corrected by BJT (coriander's transforms RGB->YUV and YUV->RGB
+ *                   do not get you back to the same RGB!)
+ * [ R ]   [  1.0   0.0     1.136 ] [ Y ]
+ * [ G ] = [  1.0  -0.396  -0.578 ] [ U ]
+ * [ B ]   [  1.0   2.041   0.002 ] [ V ]
+ *
+ */
+static void YUV2RGB(const unsigned char y, const unsigned char u,
+                    const unsigned char v, unsigned char *r, unsigned char *g,
+                    unsigned char *b) {
+  const int y2 = (int)y;
+  const int u2 = (int)u - 128;
+  const int v2 = (int)v - 128;
+  // std::cerr << "YUV=("<<y2<<","<<u2<<","<<v2<<")"<<std::endl;
+
+  // This is the normal YUV conversion, but
+  // appears to be incorrect for the firewire cameras
+  //   int r2 = y2 + ( (v2*91947) >> 16);
+  //   int g2 = y2 - ( ((u2*22544) + (v2*46793)) >> 16 );
+  //   int b2 = y2 + ( (u2*115999) >> 16);
+  // This is an adjusted version (UV spread out a bit)
+  int r2 = y2 + ((v2 * 37221) >> 15);
+  int g2 = y2 - (((u2 * 12975) + (v2 * 18949)) >> 15);
+  int b2 = y2 + ((u2 * 66883) >> 15);
+  // std::cerr << "   RGB=("<<r2<<","<<g2<<","<<b2<<")"<<std::endl;
+
+  // Cap the values.
+  *r = CLIPVALUE(r2);
+  *g = CLIPVALUE(g2);
+  *b = CLIPVALUE(b2);
+}
+
+// Converts packed 4:2:2 macropixels whose bytes are laid out as given by the
+// byte offsets Y0, U, Y1 and V.
+template <int Y0, int U, int Y1, int V>
+static void yuv422_to_rgb_scalar(const char *YUV, char *RGB, int NumPixels) {
+  int i, j;
+  unsigned char y0, y1, u, v;
+  unsigned char r, g, b;
+
+  for (i = 0, j = 0; i < (NumPixels << 1); i += 4, j += 6) {
+    y0 = (unsigned char)YUV[i + Y0];
+    u = (unsigned char)YUV[i + U];
+    y1 = (unsigned char)YUV[i + Y1];
+    v = (unsigned char)YUV[i + V];
+    YUV2RGB(y0, u, v, &r, &g, &b);
+    RGB[j + 0] = r;
+    RGB[j + 1] = g;
+    RGB[j + 2] = b;
+    YUV2RGB(y1, u, v, &r, &g, &b);
+    RGB[j + 3] = r;
+    RGB[j + 4] = g;
+    RGB[j + 5] = b;
+  }
+}
+
+#ifdef __AVX2__
+namespace {
+
+// pshufb masks that interleave 16 R, 16 G and 16 B bytes into 48 bytes of
+// RGB24. mask[block][channel] moves the bytes of one channel into output
+// bytes [16 * block, 16 * block + 16).
+struct RgbShuffleMasks {
+  RgbShuffleMasks() {
+    for (int block = 0; block < 3; ++block) {
+      for (int channel = 0; channel < 3; ++channel) {
+        for (int i = 0; i < 16; ++i) {
+          const int byte = 16 * block + i;
+          mask[block][channel][i] = byte % 3 == channel ? byte / 3 : 0x80;
+        }
+      }
+    }
+  }
+
+  alignas(16) unsigned char mask[3][3][16];
+};
+
+const RgbShuffleMasks rgb_shuffle_masks;
+
+// Clamps the even and odd pixel values of 8 macropixels to [0, 255] and
+// packs them into 16 bytes in pixel order.
+inline __m128i pack_pixels(__m256i even, __m256i odd) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max = _mm256_set1_epi32(255);
+  even = _mm256_min_epi32(_mm256_max_epi32(even, zero), max);
+  odd = _mm256_min_epi32(_mm256_max_epi32(odd, zero), max);
+  const __m256i words = _mm256_or_si256(even, _mm256_slli_epi32(odd, 16));
+  const __m256i bytes = _mm256_packus_epi16(words, words);
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(bytes, 0x08));
+}
+
+inline __m128i interleave_rgb(__m128i r, __m128i g, __m128i b, int block) {
+  const __m128i *mask =
+      reinterpret_cast<const __m128i *>(rgb_shuffle_masks.mask[block]);
+  return _mm_or_si128(
+      _mm_or_si128(_mm_shuffle_epi8(r, _mm_load_si128(mask + 0)),
+                   _mm_shuffle_epi8(g, _mm_load_si128(mask + 1))),
+      _mm_shuffle_epi8(b, _mm_load_si128(mask + 2)));
+}
+
+}  // namespace
+
+// Converts 16 pixels per iteration with the same fixed point arithmetic as
+// YUV2RGB, one macropixel per 32-bit lane. Returns the number of pixels
+// converted; the caller handles the rest.
+template <int Y0, int U, int Y1, int V>
+static int yuv422_to_rgb_avx2(const char *YUV, char *RGB, int NumPixels) {
+  const __m256i byte_mask = _mm256_set1_epi32(0xff);
+  const __m256i chroma_offset = _mm256_set1_epi32(128);
+  const __m256i v_to_r = _mm256_set1_epi32(37221);
+  const __m256i u_to_g = _mm256_set1_epi32(12975);
+  const __m256i v_to_g = _mm256_set1_epi32(18949);
+  const __m256i u_to_b = _mm256_set1_epi32(66883);
+
+  int i = 0;
+  for (; i + 16 <= NumPixels; i += 16) {
+    const __m256i pixels =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(YUV + 2 * i));
+    const __m256i y0 =
+        _mm256_and_si256(_mm256_srli_epi32(pixels, 8 * Y0), byte_mask);
+    const __m256i y1 =
+        _mm256_and_si256(_mm256_srli_epi32(pixels, 8 * Y1), byte_mask);
+    const __m256i u = _mm256_sub_epi32(
+        _mm256_and_si256(_mm256_srli_epi32(pixels, 8 * U), byte_mask),
+        chroma_offset);
+    const __m256i v = _mm256_sub_epi32(
+        _mm256_and_si256(_mm256_srli_epi32(pixels, 8 * V), byte_mask),
+        chroma_offset);
+
+    const __m256i dr = _mm256_srai_epi32(_mm256_mullo_epi32(v, v_to_r), 15);
+    const __m256i dg =
+        _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(u, u_to_g),
+                                           _mm256_mullo_epi32(v, v_to_g)),
+                          15);
+    const __m256i db = _mm256_srai_epi32(_mm256_mullo_epi32(u, u_to_b), 15);
+
+    const __m128i r =
+        pack_pixels(_mm256_add_epi32(y0, dr), _mm256_add_epi32(y1, dr));
+    const __m128i g =
+        pack_pixels(_mm256_sub_epi32(y0, dg), _mm256_sub_epi32(y1, dg));
+    const __m128i b =
+        pack_pixels(_mm256_add_epi32(y0, db), _mm256_add_epi32(y1, db));
+
+    __m128i *out = reinterpret_cast<__m128i *>(RGB + 3 * i);
+    _mm_storeu_si128(out + 0, interleave_rgb(r, g, b, 0));
+    _mm_storeu_si128(out + 1, interleave_rgb(r, g, b, 1));
+    _mm_storeu_si128(out + 2, interleave_rgb(r, g, b, 2));
+  }
+  return i;
+}
+#endif
+
+template <int Y0, int U, int Y1, int V>
+static void yuv422_to_rgb(const char *YUV, char *RGB, int NumPixels) {
+  int done = 0;
+#ifdef __AVX2__
+  done = yuv422_to_rgb_avx2<Y0, U, Y1, V>(YUV, RGB, NumPixels);
+#endif
+  yuv422_to_rgb_scalar<Y0, U, Y1, V>(YUV + 2 * done, RGB + 3 * done,
+                                     NumPixels - done);
+}
+
+void yuyv2rgb(const char *YUV, char *RGB, int NumPixels) {
+  yuv422_to_rgb<0, 1, 2, 3>(YUV, RGB, NumPixels);
+}
+
+void uyvy2rgb(const char *YUV, char *RGB, int NumPixels) {
+  yuv422_to_rgb<1, 0, 3, 2>(YUV, RGB, NumPixels);
+}
+
+void yuyv2rgb_scalar(const char *YUV, char *RGB, int NumPixels) {
+  yuv422_to_rgb_scalar<0, 1, 2, 3>(YUV, RGB, NumPixels);
+}
+
+void uyvy2rgb_scalar(const char *YUV, char *RGB, int NumPixels) {
+  yuv422_to_rgb_scalar<1, 0, 3, 2>(YUV, RGB, NumPixels);
+}
+
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Replays raw YUYV or UYVY frames recorded from a camera, e.g. with
+//   v4l2-ctl --stream-mmap --stream-count=100 --stream-to=frames.raw
+// through the frame paths of the driver and reports the time per frame:
+// the staged copy used by default, the single copy of the zero copy mode and
+// the scalar and vectorized rgb conversions. The two conversions are also
+// checked to produce identical output.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <usb_cam/yuv2rgb.h>
+
+namespace {
+
+typedef void (*ConvertFunc)(const char *, char *, int);
+
+template <class Func>
+double time_per_frame_ms(const std::vector<char> &frames, size_t frame_size,
+                         int repeat, Func func) {
+  const size_t num_frames = frames.size() / frame_size;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    for (size_t f = 0; f < num_frames; ++f) {
+      func(&frames[f * frame_size]);
+    }
+  }
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (repeat * num_frames);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 5) {
+    fprintf(stderr,
+            "Usage: %s <frames.raw> <width> <height> <yuyv|uyvy> [repeat]\n",
+            argv[0]);
+    return 1;
+  }
+  const int width = atoi(argv[2]);
+  const int height = atoi(argv[3]);
+  const std::string format = argv[4];
+  const int repeat = argc > 5 ? atoi(argv[5]) : 10;
+  if (width <= 0 || height <= 0 || width % 2 != 0 || repeat <= 0 ||
+      (format != "yuyv" && format != "uyvy")) {
+    fprintf(stderr, "Invalid arguments.\n");
+    return 1;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  std::vector<char> frames((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+  const int pixels = width * height;
+  const size_t frame_size = pixels * 2;
+  const size_t num_frames = frames.size() / frame_size;
+  if (num_frames == 0) {
+    fprintf(stderr, "%s holds no complete %dx%d frame.\n", argv[1], width,
+            height);
+    return 1;
+  }
+  frames.resize(num_frames * frame_size);
+
+  ConvertFunc convert = usb_cam::yuyv2rgb;
+  ConvertFunc convert_scalar = usb_cam::yuyv2rgb_scalar;
+  if (format == "uyvy") {
+    convert = usb_cam::uyvy2rgb;
+    convert_scalar = usb_cam::uyvy2rgb_scalar;
+  }
+
+  std::vector<char> staged(frame_size);
+  std::vector<char> message(pixels * 3);
+  std::vector<char> reference(pixels * 3);
+  for (size_t f = 0; f < num_frames; ++f) {
+    convert(&frames[f * frame_size], &message[0], pixels);
+    convert_scalar(&frames[f * frame_size], &reference[0], pixels);
+    if (message != reference) {
+      fprintf(stderr, "Conversions differ on frame %zu.\n", f);
+      return 1;
+    }
+  }
+
+  printf("%zu frames of %dx%d %s, %d passes\n", num_frames, width, height,
+         format.c_str(), repeat);
+  printf("staged copy:        %8.3f ms/frame\n",
+         time_per_frame_ms(frames, frame_size, repeat, [&](const char *src) {
+           memcpy(&staged[0], src, frame_size);
+           memcpy(&message[0], &staged[0], frame_size);
+         }));
+  printf("zero copy:          %8.3f ms/frame\n",
+         time_per_frame_ms(frames, frame_size, repeat, [&](const char *src) {
+           memcpy(&message[0], src, frame_size);
+         }));
+  printf("rgb8 (scalar):      %8.3f ms/frame\n",
+         time_per_frame_ms(frames, frame_size, repeat, [&](const char *src) {
+           convert_scalar(src, &message[0], pixels);
+         }));
+  printf("rgb8 (vectorized):  %8.3f ms/frame\n",
+         time_per_frame_ms(frames, frame_size, repeat, [&](const char *src) {
+           convert(src, &message[0], pixels);
+         }));
+  return 0;
+}
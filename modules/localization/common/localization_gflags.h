@@ -40,6 +40,7 @@ DECLARE_bool(enable_watchdog);
 DECLARE_double(gps_time_delay_tolerance);
 DECLARE_double(gps_imu_timestamp_sec_diff_tolerance);
 DECLARE_double(timestamp_sec_tolerance);
+DECLARE_int32(rtk_imu_buffer_size);
 
 DECLARE_double(map_offset_x);
 DECLARE_double(map_offset_y);
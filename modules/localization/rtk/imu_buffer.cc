@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/rtk/imu_buffer.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace localization {
+
+ImuBuffer::ImuBuffer(const size_t capacity) : slots_(capacity) {
+  CHECK_GT(capacity, 0);
+}
+
+void ImuBuffer::Push(const Imu &imu) {
+  size_t index = 0;
+  if (size_ < slots_.size()) {
+    index = size_;
+    ++size_;
+  } else {
+    // Overwrite the oldest slot, which becomes the newest.
+    head_ = SlotIndex(1);
+    index = size_ - 1;
+  }
+  slots_[SlotIndex(index)].CopyFrom(imu);
+
+  // IMU messages normally arrive in order, so this loop rarely runs.
+  const double timestamp_sec = TimestampOf(imu);
+  while (index > 0 &&
+         TimestampOf(slots_[SlotIndex(index - 1)]) > timestamp_sec) {
+    slots_[SlotIndex(index - 1)].Swap(&slots_[SlotIndex(index)]);
+    --index;
+  }
+}
+
+void ImuBuffer::Clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+const Imu &ImuBuffer::At(const size_t index) const {
+  DCHECK_LT(index, size_);
+  return slots_[SlotIndex(index)];
+}
+
+size_t ImuBuffer::UpperBound(const double timestamp_sec,
+                             const double tolerance) const {
+  size_t low = 0;
+  size_t high = size_;
+  while (low < high) {
+    const size_t mid = low + (high - low) / 2;
+    if (TimestampOf(At(mid)) - timestamp_sec > tolerance) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file imu_buffer.h
+ * @brief The class of ImuBuffer
+ */
+
+#ifndef MODULES_LOCALIZATION_RTK_IMU_BUFFER_H_
+#define MODULES_LOCALIZATION_RTK_IMU_BUFFER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/localization/proto/imu.pb.h"
+
+/**
+ * @namespace apollo::localization
+ * @brief apollo::localization
+ */
+namespace apollo {
+namespace localization {
+
+/**
+ * @class ImuBuffer
+ *
+ * @brief A fixed-capacity ring buffer of IMU messages kept sorted by
+ * header timestamp. Slots are preallocated and reused, so once the buffer
+ * has wrapped around, pushing a message does not allocate. The class is
+ * not thread-safe; the owner is expected to guard it.
+ */
+class ImuBuffer {
+ public:
+  /**
+   * @brief Construct a buffer holding at most capacity messages.
+   * @param capacity the maximum number of messages, must be positive.
+   */
+  explicit ImuBuffer(const size_t capacity);
+
+  /**
+   * @brief Insert a copy of the message, evicting the oldest one if the
+   * buffer is full. Out-of-order messages are inserted at their sorted
+   * position.
+   */
+  void Push(const Imu &imu);
+
+  /**
+   * @brief Remove all messages, keeping the allocated slots.
+   */
+  void Clear();
+
+  bool Empty() const { return size_ == 0; }
+  size_t Size() const { return size_; }
+  size_t Capacity() const { return slots_.size(); }
+
+  /**
+   * @brief Access the index-th oldest message.
+   * @param index 0 is the oldest, Size() - 1 is the newest.
+   */
+  const Imu &At(const size_t index) const;
+  const Imu &Oldest() const { return At(0); }
+  const Imu &Newest() const { return At(size_ - 1); }
+
+  /**
+   * @brief Binary search for the first message whose timestamp is newer
+   * than timestamp_sec by more than tolerance.
+   * @return the index of that message, or Size() if there is none.
+   */
+  size_t UpperBound(const double timestamp_sec, const double tolerance) const;
+
+ private:
+  static double TimestampOf(const Imu &imu) {
+    return imu.header().timestamp_sec();
+  }
+  size_t SlotIndex(const size_t index) const {
+    return (head_ + index) % slots_.size();
+  }
+
+  std::vector<Imu> slots_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace localization
+}  // namespace apollo
+
+#endif  // MODULES_LOCALIZATION_RTK_IMU_BUFFER_H_
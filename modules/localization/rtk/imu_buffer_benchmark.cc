@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/localization/rtk/imu_buffer.h"
+
+namespace apollo {
+namespace localization {
+namespace {
+
+constexpr double kTolerance = 10e-7;
+constexpr double kStartTimestampSec = 1000.0;
+// GPS messages arrive at 100 Hz, a few ms behind the newest IMU message.
+constexpr double kGpsRate = 100.0;
+constexpr double kGpsLatencySec = 0.0123;
+
+double ImuRate(const benchmark::State &state) {
+  return static_cast<double>(state.range(0));
+}
+
+// One second of IMU history at the given rate, oldest first.
+std::vector<Imu> MakeHistory(const double imu_rate) {
+  std::vector<Imu> history(static_cast<size_t>(imu_rate));
+  for (size_t i = 0; i < history.size(); ++i) {
+    history[i].mutable_header()->set_timestamp_sec(kStartTimestampSec +
+                                                   i / imu_rate);
+  }
+  return history;
+}
+
+// The GPS timestamps seen while the history was recorded.
+std::vector<double> MakeGpsTimestamps(const double imu_rate) {
+  std::vector<double> timestamps;
+  for (double t = kStartTimestampSec; t < kStartTimestampSec + 1.0;
+       t += 1.0 / kGpsRate) {
+    timestamps.push_back(t + 1.0 - 1.0 / imu_rate - kGpsLatencySec);
+  }
+  return timestamps;
+}
+
+// The scan FindMatchingIMU used to run over the adapter's observed queue: a
+// list of shared pointers walked from the oldest message until one is newer
+// than the GPS timestamp.
+size_t AdapterUpperBound(const std::list<std::shared_ptr<Imu>> &queue,
+                         const double timestamp_sec, const double tolerance) {
+  size_t index = 0;
+  for (auto it = queue.begin(); it != queue.end(); ++it, ++index) {
+    if ((*it)->header().timestamp_sec() - timestamp_sec > tolerance) {
+      break;
+    }
+  }
+  return index;
+}
+
+void BM_AdapterLinearScan(benchmark::State &state) {
+  const double imu_rate = ImuRate(state);
+  std::list<std::shared_ptr<Imu>> queue;
+  for (const auto &imu : MakeHistory(imu_rate)) {
+    queue.push_back(std::make_shared<Imu>(imu));
+  }
+  const auto gps_timestamps = MakeGpsTimestamps(imu_rate);
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        AdapterUpperBound(queue, gps_timestamps[i], kTolerance));
+    i = (i + 1) % gps_timestamps.size();
+  }
+}
+
+void BM_ImuBufferUpperBound(benchmark::State &state) {
+  const double imu_rate = ImuRate(state);
+  const auto history = MakeHistory(imu_rate);
+  ImuBuffer buffer(history.size());
+  for (const auto &imu : history) {
+    buffer.Push(imu);
+  }
+  const auto gps_timestamps = MakeGpsTimestamps(imu_rate);
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(buffer.UpperBound(gps_timestamps[i], kTolerance));
+    i = (i + 1) % gps_timestamps.size();
+  }
+}
+
+// IMU rates in Hz.
+BENCHMARK(BM_AdapterLinearScan)->Arg(200)->Arg(1000);
+BENCHMARK(BM_ImuBufferUpperBound)->Arg(200)->Arg(1000);
+
+}  // namespace
+}  // namespace localization
+}  // namespace apollo
+
+BENCHMARK_MAIN();
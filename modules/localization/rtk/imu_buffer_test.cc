@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/rtk/imu_buffer.h"
+
+#include <list>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+
+namespace {
+
+Imu MakeImu(const double timestamp_sec) {
+  Imu imu;
+  imu.mutable_header()->set_timestamp_sec(timestamp_sec);
+  imu.mutable_imu()->mutable_linear_acceleration()->set_x(timestamp_sec);
+  return imu;
+}
+
+// Linear scan over a newest-first history, as done on the adapter queue.
+size_t LinearUpperBound(const std::list<Imu> &history,
+                        const double timestamp_sec, const double tolerance) {
+  size_t index = history.size();
+  for (auto it = history.begin(); it != history.end(); ++it) {
+    if (it->header().timestamp_sec() - timestamp_sec <= tolerance) {
+      break;
+    }
+    --index;
+  }
+  return index;
+}
+
+}  // namespace
+
+TEST(ImuBufferTest, PushAndEvict) {
+  ImuBuffer buffer(3);
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(3, buffer.Capacity());
+
+  buffer.Push(MakeImu(1.0));
+  buffer.Push(MakeImu(2.0));
+  EXPECT_EQ(2, buffer.Size());
+  EXPECT_DOUBLE_EQ(1.0, buffer.Oldest().header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(2.0, buffer.Newest().header().timestamp_sec());
+
+  buffer.Push(MakeImu(3.0));
+  buffer.Push(MakeImu(4.0));
+  EXPECT_EQ(3, buffer.Size());
+  EXPECT_DOUBLE_EQ(2.0, buffer.Oldest().header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(3.0, buffer.At(1).header().timestamp_sec());
+  EXPECT_DOUBLE_EQ(4.0, buffer.Newest().header().timestamp_sec());
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.Empty());
+}
+
+TEST(ImuBufferTest, OutOfOrderPush) {
+  ImuBuffer buffer(4);
+  buffer.Push(MakeImu(1.0));
+  buffer.Push(MakeImu(3.0));
+  buffer.Push(MakeImu(4.0));
+  buffer.Push(MakeImu(2.0));
+  for (size_t i = 0; i < buffer.Size(); ++i) {
+    EXPECT_DOUBLE_EQ(1.0 + i, buffer.At(i).header().timestamp_sec());
+    EXPECT_DOUBLE_EQ(1.0 + i,
+                     buffer.At(i).imu().linear_acceleration().x());
+  }
+
+  // wrap around, then insert in the middle again
+  buffer.Push(MakeImu(6.0));
+  buffer.Push(MakeImu(5.0));
+  for (size_t i = 0; i < buffer.Size(); ++i) {
+    EXPECT_DOUBLE_EQ(3.0 + i, buffer.At(i).header().timestamp_sec());
+  }
+}
+
+TEST(ImuBufferTest, UpperBound) {
+  ImuBuffer buffer(10);
+  for (int i = 0; i < 5; ++i) {
+    buffer.Push(MakeImu(static_cast<double>(i)));
+  }
+  EXPECT_EQ(0, buffer.UpperBound(-1.0, 1e-6));
+  EXPECT_EQ(1, buffer.UpperBound(0.0, 1e-6));
+  EXPECT_EQ(2, buffer.UpperBound(1.5, 1e-6));
+  EXPECT_EQ(5, buffer.UpperBound(4.0, 1e-6));
+  EXPECT_EQ(5, buffer.UpperBound(10.0, 1e-6));
+}
+
+TEST(ImuBufferTest, MatchesLinearScan) {
+  const double tolerance = 10e-7;
+  for (const double imu_rate : {200.0, 1000.0}) {
+    const size_t capacity = static_cast<size_t>(imu_rate);
+    ImuBuffer buffer(capacity);
+    std::list<Imu> history;
+    for (int i = 0; i < 3 * static_cast<int>(capacity); ++i) {
+      const double timestamp_sec = 1000.0 + i / imu_rate;
+      buffer.Push(MakeImu(timestamp_sec));
+      history.push_front(MakeImu(timestamp_sec));
+      if (history.size() > capacity) {
+        history.pop_back();
+      }
+      // query at a 100 Hz gps rate with a few ms of latency
+      if (i % static_cast<int>(imu_rate / 100.0) == 0) {
+        const double gps_timestamp_sec = timestamp_sec - 0.0123;
+        EXPECT_EQ(LinearUpperBound(history, gps_timestamp_sec, tolerance),
+                  buffer.UpperBound(gps_timestamp_sec, tolerance));
+      }
+    }
+  }
+}
+
+}  // namespace localization
+}  // namespace apollo
@@ -26,14 +26,14 @@ namespace localization {
 
 using ::Eigen::Vector3d;
 using apollo::common::adapter::AdapterManager;
-using apollo::common::adapter::ImuAdapter;
 using apollo::common::monitor::MonitorMessageItem;
 using apollo::common::Status;
 using apollo::common::time::Clock;
 
 RTKLocalization::RTKLocalization()
     : monitor_logger_(MonitorMessageItem::LOCALIZATION),
-      map_offset_{FLAGS_map_offset_x, FLAGS_map_offset_y, FLAGS_map_offset_z} {}
+      map_offset_{FLAGS_map_offset_x, FLAGS_map_offset_y, FLAGS_map_offset_z},
+      imu_buffer_(FLAGS_rtk_imu_buffer_size) {}
 
 RTKLocalization::~RTKLocalization() {
 }
@@ -57,6 +57,7 @@ Status RTKLocalization::Start() {
     buffer.PrintLog();
     return Status(common::LOCALIZATION_ERROR, "no IMU adapter");
   }
+  AdapterManager::AddImuCallback(&RTKLocalization::OnImu, this);
 
   tf2_broadcaster_.reset(new tf2_ros::TransformBroadcaster);
 
@@ -106,6 +107,11 @@ void RTKLocalization::OnTimer(const ros::TimerEvent &event) {
   last_received_timestamp_sec_ = common::time::ToSecond(Clock::Now());
 }
 
+void RTKLocalization::OnImu(const localization::Imu &imu) {
+  std::lock_guard<std::mutex> lock(imu_buffer_mutex_);
+  imu_buffer_.Push(imu);
+}
+
 template <class T>
 T RTKLocalization::InterpolateXYZ(const T &p1, const T &p2,
                                   const double &frac1) {
@@ -129,42 +135,36 @@ bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
     AERROR << "imu_msg should NOT be nullptr.";
     return false;
   }
-  auto *imu_adapter = AdapterManager::GetImu();
-  if (imu_adapter->Empty()) {
+  std::lock_guard<std::mutex> lock(imu_buffer_mutex_);
+  if (imu_buffer_.Empty()) {
     AERROR << "[FindMatchingIMU]: Cannot find Matching IMU. "
            << "IMU message Queue is empty! GPS timestamp[" << gps_timestamp_sec
            << "]";
     return false;
   }
 
-  // scan imu buffer, find first imu message that is newer than the given
+  // binary search for the first imu message that is newer than the given
   // timestamp
-  ImuAdapter::Iterator imu_it = imu_adapter->begin();
-  for (; imu_it != imu_adapter->end(); ++imu_it) {
-    if ((*imu_it)->header().timestamp_sec() - gps_timestamp_sec >
-        FLAGS_timestamp_sec_tolerance) {
-      break;
-    }
-  }
+  const size_t index =
+      imu_buffer_.UpperBound(gps_timestamp_sec, FLAGS_timestamp_sec_tolerance);
 
-  if (imu_it != imu_adapter->end()) {  // found one
-    if (imu_it == imu_adapter->begin()) {
+  if (index < imu_buffer_.Size()) {  // found one
+    if (index == 0) {
       AERROR << "[FindMatchingIMU]: IMU queue too short or request too old. "
              << "Oldest timestamp["
-             << imu_adapter->GetOldestObserved().header().timestamp_sec()
+             << imu_buffer_.Oldest().header().timestamp_sec()
              << "], Newest timestamp["
-             << imu_adapter->GetLatestObserved().header().timestamp_sec()
+             << imu_buffer_.Newest().header().timestamp_sec()
              << "], GPS timestamp[" << gps_timestamp_sec << "]";
-      *imu_msg = imu_adapter->GetOldestObserved();  // the oldest imu
+      imu_msg->CopyFrom(imu_buffer_.Oldest());  // the oldest imu
     } else {
       // here is the normal case
-      auto imu_it_1 = imu_it;
-      imu_it_1--;
-      InterpolateIMU(**imu_it_1, **imu_it, gps_timestamp_sec, imu_msg);
+      InterpolateIMU(imu_buffer_.At(index - 1), imu_buffer_.At(index),
+                     gps_timestamp_sec, imu_msg);
     }
   } else {
     // give the newest imu, without extrapolation
-    *imu_msg = imu_adapter->GetLatestObserved();
+    imu_msg->CopyFrom(imu_buffer_.Newest());
 
     if (fabs(imu_msg->header().timestamp_sec() - gps_timestamp_sec) >
         FLAGS_report_gps_imu_time_diff_threshold) {
@@ -172,7 +172,7 @@ bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
       AERROR << "[FindMatchingIMU]: Cannot find Matching IMU. "
              << "IMU messages too old"
              << "Newest timestamp["
-             << imu_adapter->GetLatestObserved().header().timestamp_sec()
+             << imu_buffer_.Newest().header().timestamp_sec()
              << "], GPS timestamp[" << gps_timestamp_sec << "]";
     }
   }
@@ -22,6 +22,7 @@
 #ifndef MODULES_LOCALIZATION_RTK_RTK_LOCALIZATION_H_
 #define MODULES_LOCALIZATION_RTK_RTK_LOCALIZATION_H_
 
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -39,6 +40,7 @@
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
 #include "modules/localization/localization_base.h"
+#include "modules/localization/rtk/imu_buffer.h"
 
 /**
  * @namespace apollo::localization
@@ -71,6 +73,7 @@ class RTKLocalization : public LocalizationBase {
 
  private:
   void OnTimer(const ros::TimerEvent &event);
+  void OnImu(const localization::Imu &imu);
   void PublishLocalization();
   void RunWatchDog();
 
@@ -92,7 +95,13 @@ class RTKLocalization : public LocalizationBase {
   double last_reported_timestamp_sec_ = 0.0;
   bool service_started_ = false;
 
+  // time-sorted IMU history fed from the IMU callback, used to find the IMU
+  // messages bracketing a GPS timestamp.
+  ImuBuffer imu_buffer_;
+  std::mutex imu_buffer_mutex_;
+
   FRIEND_TEST(RTKLocalizationTest, InterpolateIMU);
+  FRIEND_TEST(RTKLocalizationTest, FindMatchingIMU);
   FRIEND_TEST(RTKLocalizationTest, ComposeLocalizationMsg);
 };
 
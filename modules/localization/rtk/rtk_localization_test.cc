@@ -135,6 +135,41 @@ TEST_F(RTKLocalizationTest, InterpolateIMU) {
   }
 }
 
+TEST_F(RTKLocalizationTest, FindMatchingIMU) {
+  apollo::localization::Imu imu;
+  EXPECT_FALSE(rtk_localizatoin_->FindMatchingIMU(1173545122.69, &imu));
+
+  apollo::localization::Imu imu1;
+  load_data("modules/localization/testdata/1_imu_1.pb.txt", &imu1);
+  apollo::localization::Imu imu2;
+  load_data("modules/localization/testdata/1_imu_2.pb.txt", &imu2);
+
+  // feed out of order, the buffer keeps them sorted by timestamp
+  rtk_localizatoin_->OnImu(imu2);
+  rtk_localizatoin_->OnImu(imu1);
+
+  // timestamp inbetween, interpolate
+  {
+    apollo::localization::Imu expected_result;
+    rtk_localizatoin_->InterpolateIMU(imu1, imu2, 1173545122.5,
+                                      &expected_result);
+    EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(1173545122.5, &imu));
+    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
+  }
+
+  // timestamp older than all messages, give the oldest
+  {
+    EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(1173545122, &imu));
+    EXPECT_EQ(imu1.DebugString(), imu.DebugString());
+  }
+
+  // timestamp newer than all messages, give the newest
+  {
+    EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(1173545123, &imu));
+    EXPECT_EQ(imu2.DebugString(), imu.DebugString());
+  }
+}
+
 TEST_F(RTKLocalizationTest, ComposeLocalizationMsg) {
   // FLAGS_enable_map_reference_unify: false
   {
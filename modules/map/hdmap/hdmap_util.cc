@@ -28,7 +28,7 @@ std::string FindFirstExist(const std::string& dir, const std::string& files) {
       apollo::common::util::StringTokenizer::Split(files, "|");
   for (const auto& filename : candidates) {
     const std::string file_path =
-        apollo::common::util::StrCat(FLAGS_map_dir, "/", filename);
+        apollo::common::util::StrCat(dir, "/", filename);
     if (apollo::common::util::PathExists(file_path)) {
       return file_path;
     }
@@ -36,19 +36,23 @@ std::string FindFirstExist(const std::string& dir, const std::string& files) {
   AERROR << "No existing file found in " << dir << "/" << files
          << ". Fallback to first candidate as default result.";
   CHECK(!candidates.empty()) << "Please specify at least one map.";
-  return apollo::common::util::StrCat(FLAGS_map_dir, "/", candidates[0]);
+  return apollo::common::util::StrCat(dir, "/", candidates[0]);
 }
 
 }  // namespace
 
-std::string BaseMapFile() {
+std::string BaseMapFile() { return BaseMapFile(FLAGS_map_dir); }
+
+std::string BaseMapFile(const std::string& map_dir) {
   return FLAGS_test_base_map_filename.empty()
-             ? FindFirstExist(FLAGS_map_dir, FLAGS_base_map_filename)
-             : FindFirstExist(FLAGS_map_dir, FLAGS_test_base_map_filename);
+             ? FindFirstExist(map_dir, FLAGS_base_map_filename)
+             : FindFirstExist(map_dir, FLAGS_test_base_map_filename);
 }
 
-std::string SimMapFile() {
-  return FindFirstExist(FLAGS_map_dir, FLAGS_sim_map_filename);
+std::string SimMapFile() { return SimMapFile(FLAGS_map_dir); }
+
+std::string SimMapFile(const std::string& map_dir) {
+  return FindFirstExist(map_dir, FLAGS_sim_map_filename);
 }
 
 std::string RoutingMapFile() {
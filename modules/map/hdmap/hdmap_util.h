@@ -38,12 +38,26 @@ namespace hdmap {
  */
 std::string BaseMapFile();
 
+/**
+ * @brief get base map file path in the given map directory.
+ * @param map_dir map directory
+ * @return base map path
+ */
+std::string BaseMapFile(const std::string& map_dir);
+
 /**
  * @brief get simulation map file path from flags.
  * @return simulation map path
  */
 std::string SimMapFile();
 
+/**
+ * @brief get simulation map file path in the given map directory.
+ * @param map_dir map directory
+ * @return simulation map path
+ */
+std::string SimMapFile(const std::string& map_dir);
+
 /**
  * @brief get routing map file path from flags.
  * @return routing map path
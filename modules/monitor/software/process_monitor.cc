@@ -18,7 +18,6 @@
 
 #include "gflags/gflags.h"
 #include "modules/common/log.h"
-#include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
 #include "modules/monitor/common/monitor_manager.h"
 
@@ -30,65 +29,50 @@ DEFINE_double(process_monitor_interval, 1.5,
 
 namespace apollo {
 namespace monitor {
-namespace {
-
-template <class Iterable>
-bool ContainsAll(const std::string &full, const Iterable &parts) {
-  for (const auto &part : parts) {
-    if (full.find(part) == std::string::npos) {
-      return false;
-    }
-  }
-  return true;
-}
-
-}  // namespace
 
 ProcessMonitor::ProcessMonitor()
     : RecurrentRunner(FLAGS_process_monitor_name,
                       FLAGS_process_monitor_interval) {
-}
-
-void ProcessMonitor::RunOnce(const double current_time) {
-  // Get running processes.
-  std::map<std::string, std::string> running_processes;
-  const auto procs = common::util::ListSubDirectories("/proc");
-  for (const auto &proc : procs) {
-    // Get process command string.
-    std::string cmd_string;
-    const auto cmd_file = common::util::StrCat("/proc/", proc, "/cmdline");
-    if (common::util::GetContent(cmd_file, &cmd_string)) {
-      running_processes.emplace(proc, cmd_string);
+  for (const auto &module : MonitorManager::GetConfig().modules()) {
+    if (module.has_process_conf()) {
+      const auto &keywords = module.process_conf().process_cmd_keywords();
+      tracker_.AddModule(module.name(), {keywords.begin(), keywords.end()});
     }
   }
+}
 
+void ProcessMonitor::RunOnce(const double current_time) {
+  tracker_.Update(current_time);
   for (const auto &module : MonitorManager::GetConfig().modules()) {
     if (module.has_process_conf()) {
-      UpdateModule(module.name(), module.process_conf(), running_processes);
+      UpdateModule(module.name(), *tracker_.GetModuleUsage(module.name()));
     }
   }
 }
 
-void ProcessMonitor::UpdateModule(
-    const std::string &module_name, const ProcessConf &config,
-    const std::map<std::string, std::string> &running_processes) {
+void ProcessMonitor::UpdateModule(const std::string &module_name,
+                                  const ProcessTracker::ModuleUsage &usage) {
   auto *status = MonitorManager::GetModuleStatus(module_name);
-  for (const auto &proc : running_processes) {
-    if (ContainsAll(proc.second, config.process_cmd_keywords())) {
-      status->mutable_process_status()->set_running(true);
-      ADEBUG << "Module " << module_name
-             << " is running on process " << proc.first;
-      return;
-    }
+  auto *process_status = status->mutable_process_status();
+  if (usage.num_processes > 0) {
+    ADEBUG << "Module " << module_name << " is running on "
+           << usage.num_processes << " processes";
+    process_status->set_running(true);
+    process_status->set_cpu_usage(usage.cpu_usage);
+    process_status->set_memory_rss(usage.memory_rss);
+    process_status->set_context_switches_per_sec(
+        usage.context_switches_per_sec);
+    return;
   }
 
-  if (status->process_status().running()) {
+  if (process_status->running()) {
     // The process stopped. Send monitor log.
     MonitorManager::LogBuffer().ERROR(
         apollo::common::util::StrCat(module_name, " process stopped!"));
   }
 
-  status->mutable_process_status()->set_running(false);
+  process_status->Clear();
+  process_status->set_running(false);
 }
 
 }  // namespace monitor
@@ -0,0 +1,265 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/process_tracker.h"
+
+#include <unistd.h>
+
+#include <cctype>
+#include <cstdlib>
+
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+using apollo::common::util::GetContent;
+using apollo::common::util::StrCat;
+
+// Processes first seen less than this many seconds ago are matched again on
+// every update, in case they were caught between fork and exec.
+constexpr double kRematchPeriod = 5.0;
+
+template <class Iterable>
+bool ContainsAll(const std::string &full, const Iterable &parts) {
+  for (const auto &part : parts) {
+    if (full.find(part) == std::string::npos) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsPid(const std::string &name) {
+  for (const char c : name) {
+    if (!std::isdigit(c)) {
+      return false;
+    }
+  }
+  return !name.empty();
+}
+
+// Adds up the "voluntary_ctxt_switches" and "nonvoluntary_ctxt_switches"
+// lines of a status file.
+uint64_t SumContextSwitches(const std::string &status) {
+  static const std::string kVoluntary = "voluntary_ctxt_switches:";
+  static const std::string kNonvoluntary = "nonvoluntary_ctxt_switches:";
+  uint64_t sum = 0;
+  size_t line_begin = 0;
+  while (line_begin < status.size()) {
+    size_t line_end = status.find('\n', line_begin);
+    if (line_end == std::string::npos) {
+      line_end = status.size();
+    }
+    for (const auto *key : {&kVoluntary, &kNonvoluntary}) {
+      if (status.compare(line_begin, key->size(), *key) == 0) {
+        sum += std::strtoull(status.c_str() + line_begin + key->size(),
+                             nullptr, 10);
+      }
+    }
+    line_begin = line_end + 1;
+  }
+  return sum;
+}
+
+}  // namespace
+
+ProcessTracker::ProcessTracker(const std::string &proc_dir)
+    : proc_dir_(proc_dir),
+      ticks_per_sec_(sysconf(_SC_CLK_TCK)),
+      page_size_(sysconf(_SC_PAGESIZE)) {}
+
+void ProcessTracker::AddModule(const std::string &name,
+                               const std::vector<std::string> &cmd_keywords) {
+  const auto iter = module_index_.find(name);
+  if (iter != module_index_.end()) {
+    modules_[iter->second].cmd_keywords = cmd_keywords;
+  } else {
+    module_index_.emplace(name, modules_.size());
+    modules_.emplace_back();
+    modules_.back().cmd_keywords = cmd_keywords;
+  }
+  // Existing bindings may be stale now.
+  processes_.clear();
+}
+
+const ProcessTracker::ModuleUsage *ProcessTracker::GetModuleUsage(
+    const std::string &name) const {
+  const auto iter = module_index_.find(name);
+  return iter == module_index_.end() ? nullptr
+                                     : &modules_[iter->second].usage;
+}
+
+void ProcessTracker::Update(const double current_time) {
+  ++generation_;
+  for (auto &module : modules_) {
+    module.usage = ModuleUsage();
+  }
+
+  for (const auto &pid : common::util::ListSubDirectories(proc_dir_)) {
+    if (!IsPid(pid)) {
+      continue;
+    }
+    auto iter = processes_.find(pid);
+    Process *process = iter == processes_.end() ? nullptr : &iter->second;
+    // The stat of every process is read to detect reused pids by their
+    // start times, which is cheaper than reading their command lines.
+    ProcessStat stat;
+    if (!ReadStat(pid, &stat)) {
+      // The process just exited; its entry goes away below.
+      continue;
+    }
+    if (process == nullptr || stat.start_time != process->start_time) {
+      // A new process, or a new one reusing the pid.
+      process = &processes_[pid];
+      *process = Process();
+      process->start_time = stat.start_time;
+      process->first_seen_time = current_time;
+      Bind(pid, process);
+    } else if (current_time - process->first_seen_time < kRematchPeriod) {
+      Bind(pid, process);
+    }
+    // Settled processes of no interest are not matched again.
+    process->generation = generation_;
+    if (!process->modules.empty()) {
+      Sample(pid, stat, current_time, process);
+    }
+  }
+
+  for (auto iter = processes_.begin(); iter != processes_.end();) {
+    if (iter->second.generation != generation_) {
+      iter = processes_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+bool ProcessTracker::ReadStat(const std::string &pid,
+                              ProcessStat *stat) const {
+  std::string content;
+  if (!GetContent(StrCat(proc_dir_, "/", pid, "/stat"), &content)) {
+    return false;
+  }
+  // The command name in field 2 may contain spaces and parentheses, so start
+  // after its last ')'. See proc(5) for the field numbers.
+  const size_t comm_end = content.rfind(')');
+  if (comm_end == std::string::npos) {
+    return false;
+  }
+  const char *p = content.c_str() + comm_end + 1;
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+  for (int field = 3; field <= 24; ++field) {
+    while (*p == ' ') {
+      ++p;
+    }
+    if (*p == '\0') {
+      return false;
+    }
+    char *end = nullptr;
+    const uint64_t value = std::strtoull(p, &end, 10);
+    switch (field) {
+      case 14:
+        utime = value;
+        break;
+      case 15:
+        stime = value;
+        break;
+      case 22:
+        stat->start_time = value;
+        break;
+      case 24:
+        stat->rss_pages = value;
+        break;
+      default:
+        break;
+    }
+    // Skip the rest of the field, e.g. the state letter in field 3.
+    p = end;
+    while (*p != ' ' && *p != '\0') {
+      ++p;
+    }
+  }
+  stat->cpu_ticks = utime + stime;
+  return true;
+}
+
+bool ProcessTracker::ReadContextSwitches(const std::string &pid,
+                                         uint64_t *count) const {
+  // The status of the process only counts its main thread.
+  const std::string task_dir = StrCat(proc_dir_, "/", pid, "/task");
+  *count = 0;
+  bool found = false;
+  for (const auto &tid : common::util::ListSubDirectories(task_dir)) {
+    std::string status;
+    if (GetContent(StrCat(task_dir, "/", tid, "/status"), &status)) {
+      *count += SumContextSwitches(status);
+      found = true;
+    }
+  }
+  return found;
+}
+
+void ProcessTracker::Bind(const std::string &pid, Process *process) {
+  process->modules.clear();
+  std::string cmdline;
+  ++num_cmdline_reads_;
+  if (!GetContent(StrCat(proc_dir_, "/", pid, "/cmdline"), &cmdline)) {
+    return;
+  }
+  for (size_t i = 0; i < modules_.size(); ++i) {
+    if (ContainsAll(cmdline, modules_[i].cmd_keywords)) {
+      process->modules.push_back(i);
+    }
+  }
+}
+
+void ProcessTracker::Sample(const std::string &pid, const ProcessStat &stat,
+                            const double current_time, Process *process) {
+  uint64_t context_switches = 0;
+  const bool has_context_switches =
+      ReadContextSwitches(pid, &context_switches);
+  const double duration = current_time - process->sample_time;
+  const bool has_rates = process->sample_time >= 0.0 && duration > 0.0;
+
+  for (const int index : process->modules) {
+    ModuleUsage *usage = &modules_[index].usage;
+    ++usage->num_processes;
+    usage->memory_rss += stat.rss_pages * page_size_;
+    if (!has_rates) {
+      continue;
+    }
+    if (stat.cpu_ticks >= process->cpu_ticks) {
+      usage->cpu_usage +=
+          (stat.cpu_ticks - process->cpu_ticks) / ticks_per_sec_ / duration;
+    }
+    // The sum drops when threads exit, skip the rate then.
+    if (has_context_switches && context_switches >= process->context_switches) {
+      usage->context_switches_per_sec +=
+          (context_switches - process->context_switches) / duration;
+    }
+  }
+
+  process->sample_time = current_time;
+  process->cpu_ticks = stat.cpu_ticks;
+  process->context_switches = context_switches;
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef MODULES_MONITOR_SOFTWARE_PROCESS_TRACKER_H_
+#define MODULES_MONITOR_SOFTWARE_PROCESS_TRACKER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @namespace apollo::monitor
+ * @brief apollo::monitor
+ */
+namespace apollo {
+namespace monitor {
+
+/**
+ * @class ProcessTracker
+ * @brief Finds the processes of each module by their command line keywords
+ * and sums up their resource usage.
+ *
+ * Process to module bindings are cached by pid and start time, so an update
+ * only lists the proc directory, reads the stat of every process to detect
+ * reused pids, reads the cmdline of new processes and samples the processes
+ * bound to a module. Processes are matched again
+ * while they are young, as they may not have exec'ed their final command yet.
+ */
+class ProcessTracker {
+ public:
+  struct ModuleUsage {
+    int num_processes = 0;
+    // In cores, e.g. 1.5 means one and a half cores are busy.
+    double cpu_usage = 0.0;
+    // Resident memory in bytes.
+    uint64_t memory_rss = 0;
+    // Voluntary and involuntary context switches of all threads.
+    double context_switches_per_sec = 0.0;
+  };
+
+  explicit ProcessTracker(const std::string &proc_dir = "/proc");
+
+  void AddModule(const std::string &name,
+                 const std::vector<std::string> &cmd_keywords);
+
+  /**
+   * @brief Rescans the processes.
+   * @param current_time Time in seconds. Rates are computed over the time
+   * since the previous update, so the first update reports zero rates.
+   */
+  void Update(const double current_time);
+
+  /**
+   * @brief Returns the usage of a module as of the last update, or nullptr if
+   * the module was not added.
+   */
+  const ModuleUsage *GetModuleUsage(const std::string &name) const;
+
+  /**
+   * @brief Number of cmdline files read so far.
+   */
+  int num_cmdline_reads() const {
+    return num_cmdline_reads_;
+  }
+
+ private:
+  struct Module {
+    std::vector<std::string> cmd_keywords;
+    ModuleUsage usage;
+  };
+
+  struct ProcessStat {
+    uint64_t start_time = 0;
+    uint64_t cpu_ticks = 0;
+    uint64_t rss_pages = 0;
+  };
+
+  struct Process {
+    uint64_t start_time = 0;
+    double first_seen_time = 0.0;
+    // Indices into modules_ of the modules this process belongs to.
+    std::vector<int> modules;
+    // The previous sample, valid if sample_time >= 0.
+    double sample_time = -1.0;
+    uint64_t cpu_ticks = 0;
+    uint64_t context_switches = 0;
+    uint64_t generation = 0;
+  };
+
+  bool ReadStat(const std::string &pid, ProcessStat *stat) const;
+  bool ReadContextSwitches(const std::string &pid, uint64_t *count) const;
+  void Bind(const std::string &pid, Process *process);
+  void Sample(const std::string &pid, const ProcessStat &stat,
+              const double current_time, Process *process);
+
+  const std::string proc_dir_;
+  const double ticks_per_sec_;
+  const uint64_t page_size_;
+  std::vector<Module> modules_;
+  std::unordered_map<std::string, int> module_index_;
+  std::unordered_map<std::string, Process> processes_;
+  uint64_t generation_ = 0;
+  int num_cmdline_reads_ = 0;
+};
+
+}  // namespace monitor
+}  // namespace apollo
+
+#endif  // MODULES_MONITOR_SOFTWARE_PROCESS_TRACKER_H_
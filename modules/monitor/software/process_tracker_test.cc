@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/process_tracker.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+
+namespace apollo {
+namespace monitor {
+
+using apollo::common::util::StrAppend;
+using apollo::common::util::StrCat;
+
+// Builds a fake proc directory in the test temp dir.
+class ProcessTrackerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    system("exec rm -rf ${TEST_TMPDIR}/*");
+    proc_dir_ = StrCat(std::getenv("TEST_TMPDIR"), "/proc");
+    common::util::EnsureDirectory(proc_dir_);
+    ticks_per_sec_ = sysconf(_SC_CLK_TCK);
+    page_size_ = sysconf(_SC_PAGESIZE);
+  }
+
+  void WriteFile(const std::string &path, const std::string &content) {
+    std::ofstream(path) << content;
+  }
+
+  // cmdline arguments are separated by '\0'.
+  void AddProcess(int pid, const std::string &cmdline, uint64_t start_time) {
+    const std::string dir = StrCat(proc_dir_, "/", pid);
+    common::util::EnsureDirectory(StrCat(dir, "/task"));
+    std::string content = cmdline;
+    for (auto &c : content) {
+      if (c == ' ') {
+        c = '\0';
+      }
+    }
+    WriteFile(StrCat(dir, "/cmdline"), content);
+    SetStat(pid, start_time, 0, 0, 0);
+  }
+
+  void SetStat(int pid, uint64_t start_time, uint64_t utime, uint64_t stime,
+               uint64_t rss_pages) {
+    // The command name has a space and a ')' to exercise the parsing.
+    std::string stat =
+        StrCat(pid, " (my) proc) S 1 1 1 0 -1 4194560 100 0 0 0 ", utime, " ",
+               stime, " 0 0 20 0 1 0 ");
+    StrAppend(&stat, start_time, " 123456 ", rss_pages,
+              " 18446744073709551615\n");
+    WriteFile(StrCat(proc_dir_, "/", pid, "/stat"), stat);
+  }
+
+  void SetThread(int pid, int tid, uint64_t voluntary,
+                 uint64_t nonvoluntary) {
+    const std::string dir = StrCat(proc_dir_, "/", pid, "/task/", tid);
+    common::util::EnsureDirectory(dir);
+    WriteFile(StrCat(dir, "/status"),
+              StrCat("Name:\tmy\nState:\tS (sleeping)\n",
+                     "voluntary_ctxt_switches:\t", voluntary, "\n",
+                     "nonvoluntary_ctxt_switches:\t", nonvoluntary, "\n"));
+  }
+
+  void RemoveProcess(int pid) {
+    system(StrCat("exec rm -rf ", proc_dir_, "/", pid).c_str());
+  }
+
+  std::string proc_dir_;
+  double ticks_per_sec_ = 100.0;
+  uint64_t page_size_ = 4096;
+};
+
+TEST_F(ProcessTrackerTest, BindsProcessesToModules) {
+  AddProcess(100, "mainboard -d planning", 10);
+  AddProcess(101, "mainboard -d control", 10);
+  AddProcess(102, "bash", 10);
+  SetStat(101, 10, 0, 0, 50);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"mainboard", "planning"});
+  tracker.AddModule("control", {"mainboard", "control"});
+  tracker.AddModule("mainboard", {"mainboard"});
+
+  tracker.Update(0.0);
+  EXPECT_EQ(1, tracker.GetModuleUsage("planning")->num_processes);
+  EXPECT_EQ(1, tracker.GetModuleUsage("control")->num_processes);
+  EXPECT_EQ(50 * page_size_, tracker.GetModuleUsage("control")->memory_rss);
+  EXPECT_EQ(2, tracker.GetModuleUsage("mainboard")->num_processes);
+  EXPECT_EQ(nullptr, tracker.GetModuleUsage("routing"));
+}
+
+TEST_F(ProcessTrackerTest, ReadsCmdlineOnceForSettledProcesses) {
+  AddProcess(100, "mainboard -d planning", 10);
+  AddProcess(102, "bash", 10);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"planning"});
+
+  tracker.Update(0.0);
+  EXPECT_EQ(2, tracker.num_cmdline_reads());
+  // Young processes are matched again.
+  tracker.Update(1.0);
+  EXPECT_EQ(4, tracker.num_cmdline_reads());
+  tracker.Update(10.0);
+  tracker.Update(11.0);
+  EXPECT_EQ(4, tracker.num_cmdline_reads());
+  EXPECT_EQ(1, tracker.GetModuleUsage("planning")->num_processes);
+}
+
+TEST_F(ProcessTrackerTest, RematchesYoungProcesses) {
+  // Caught between fork and exec.
+  AddProcess(100, "bash", 10);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"planning"});
+  tracker.Update(0.0);
+  EXPECT_EQ(0, tracker.GetModuleUsage("planning")->num_processes);
+
+  WriteFile(StrCat(proc_dir_, "/100/cmdline"), "planning");
+  tracker.Update(1.0);
+  EXPECT_EQ(1, tracker.GetModuleUsage("planning")->num_processes);
+}
+
+TEST_F(ProcessTrackerTest, DetectsReusedPids) {
+  AddProcess(100, "planning", 10);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"planning"});
+  tracker.Update(0.0);
+  tracker.Update(10.0);
+  EXPECT_EQ(1, tracker.GetModuleUsage("planning")->num_processes);
+
+  // The process exited and the pid went to another one.
+  RemoveProcess(100);
+  AddProcess(100, "bash", 2000);
+  tracker.Update(20.0);
+  EXPECT_EQ(0, tracker.GetModuleUsage("planning")->num_processes);
+}
+
+TEST_F(ProcessTrackerTest, DetectsReusedPidsOfSettledProcesses) {
+  AddProcess(100, "bash", 10);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"planning"});
+  tracker.Update(0.0);
+  tracker.Update(10.0);
+  EXPECT_EQ(0, tracker.GetModuleUsage("planning")->num_processes);
+  EXPECT_EQ(1, tracker.num_cmdline_reads());
+
+  // The settled process exited and the pid went to a module process.
+  RemoveProcess(100);
+  AddProcess(100, "planning", 2000);
+  tracker.Update(20.0);
+  EXPECT_EQ(1, tracker.GetModuleUsage("planning")->num_processes);
+  EXPECT_EQ(2, tracker.num_cmdline_reads());
+}
+
+TEST_F(ProcessTrackerTest, ForgetsExitedProcesses) {
+  AddProcess(100, "planning", 10);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"planning"});
+  tracker.Update(0.0);
+  EXPECT_EQ(1, tracker.GetModuleUsage("planning")->num_processes);
+
+  RemoveProcess(100);
+  tracker.Update(10.0);
+  EXPECT_EQ(0, tracker.GetModuleUsage("planning")->num_processes);
+  EXPECT_DOUBLE_EQ(0.0, tracker.GetModuleUsage("planning")->cpu_usage);
+}
+
+TEST_F(ProcessTrackerTest, ComputesRates) {
+  AddProcess(100, "planning", 10);
+  AddProcess(101, "planning", 10);
+  SetThread(100, 100, 10, 1);
+  SetThread(100, 110, 20, 2);
+  SetThread(101, 101, 0, 0);
+  ProcessTracker tracker(proc_dir_);
+  tracker.AddModule("planning", {"planning"});
+
+  tracker.Update(0.0);
+  const auto *usage = tracker.GetModuleUsage("planning");
+  EXPECT_EQ(2, usage->num_processes);
+  EXPECT_DOUBLE_EQ(0.0, usage->cpu_usage);
+  EXPECT_DOUBLE_EQ(0.0, usage->context_switches_per_sec);
+
+  // In 2 seconds, process 100 is busy for 3 seconds on two threads and process
+  // 101 for 1 second.
+  SetStat(100, 10, 2 * ticks_per_sec_, 1 * ticks_per_sec_, 0);
+  SetStat(101, 10, 1 * ticks_per_sec_, 0, 0);
+  SetThread(100, 100, 30, 1);
+  SetThread(100, 110, 40, 2);
+  SetThread(101, 101, 50, 10);
+  tracker.Update(2.0);
+  EXPECT_NEAR(2.0, usage->cpu_usage, 1e-9);
+  EXPECT_NEAR((40 + 60) / 2.0, usage->context_switches_per_sec, 1e-9);
+
+  // A thread exited, which lowers the sum of process 100.
+  system(StrCat("exec rm -rf ", proc_dir_, "/100/task/110").c_str());
+  SetThread(101, 101, 70, 10);
+  tracker.Update(3.0);
+  EXPECT_NEAR(0.0, usage->cpu_usage, 1e-9);
+  EXPECT_NEAR(20.0, usage->context_switches_per_sec, 1e-9);
+}
+
+}  // namespace monitor
+}  // namespace apollo
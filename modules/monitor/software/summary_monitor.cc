@@ -58,7 +58,11 @@ void UpdateStatusSummary(const Summary new_summary, const std::string &new_msg,
 template <class Status>
 void SummarizeOnTopicStatus(const TopicStatus &topic_status, Status *status) {
   if (!topic_status.has_message_delay()) {
-    UpdateStatusSummary(Summary::OK, "", status);
+    if (topic_status.has_abnormal_stats()) {
+      UpdateStatusSummary(Summary::WARN, topic_status.abnormal_stats(), status);
+    } else {
+      UpdateStatusSummary(Summary::OK, "", status);
+    }
     return;
   }
 
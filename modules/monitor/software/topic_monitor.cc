@@ -16,8 +16,11 @@
 
 #include "modules/monitor/software/topic_monitor.h"
 
+#include <vector>
+
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
+#include "modules/common/time/time.h"
 #include "modules/common/util/string_util.h"
 #include "modules/monitor/common/monitor_manager.h"
 
@@ -32,29 +35,56 @@ namespace {
 using apollo::common::adapter::AdapterBase;
 using apollo::common::adapter::AdapterConfig;
 using apollo::common::adapter::AdapterManager;
+using apollo::common::time::Clock;
+using apollo::common::util::PrintIter;
 using apollo::common::util::StrCat;
 using apollo::common::util::StringPrintf;
 
-AdapterBase *GetAdapterByMessageType(const AdapterConfig::MessageType type) {
+template <class MessageType>
+double GetHeaderTime(const MessageType &message) {
+  return message.header().timestamp_sec();
+}
+
+double GetHeaderTime(const sensor_msgs::PointCloud2 &message) {
+  return message.header.stamp.toSec();
+}
+
+double GetHeaderTime(const sensor_msgs::Image &message) {
+  return message.header.stamp.toSec();
+}
+
+// Records every message of the adapter into the stats.
+template <class AdapterType>
+AdapterBase *Subscribe(AdapterType *adapter, TopicStats *stats) {
+  CHECK_NOTNULL(adapter);
+  adapter->AddCallback(
+      [stats](const typename AdapterType::DataType &message) {
+        stats->Record(Clock::NowInSeconds(), GetHeaderTime(message));
+      });
+  return adapter;
+}
+
+AdapterBase *SubscribeByMessageType(const AdapterConfig::MessageType type,
+                                    TopicStats *stats) {
   switch (type) {
     case AdapterConfig::POINT_CLOUD:
-      return CHECK_NOTNULL(AdapterManager::GetPointCloud());
+      return Subscribe(AdapterManager::GetPointCloud(), stats);
     case AdapterConfig::IMAGE_LONG:
-      return CHECK_NOTNULL(AdapterManager::GetImageLong());
+      return Subscribe(AdapterManager::GetImageLong(), stats);
     case AdapterConfig::IMAGE_SHORT:
-      return CHECK_NOTNULL(AdapterManager::GetImageShort());
+      return Subscribe(AdapterManager::GetImageShort(), stats);
     case AdapterConfig::LOCALIZATION:
-      return CHECK_NOTNULL(AdapterManager::GetLocalization());
+      return Subscribe(AdapterManager::GetLocalization(), stats);
     case AdapterConfig::PERCEPTION_OBSTACLES:
-      return CHECK_NOTNULL(AdapterManager::GetPerceptionObstacles());
+      return Subscribe(AdapterManager::GetPerceptionObstacles(), stats);
     case AdapterConfig::PREDICTION:
-      return CHECK_NOTNULL(AdapterManager::GetPrediction());
+      return Subscribe(AdapterManager::GetPrediction(), stats);
     case AdapterConfig::PLANNING_TRAJECTORY:
-      return CHECK_NOTNULL(AdapterManager::GetPlanning());
+      return Subscribe(AdapterManager::GetPlanning(), stats);
     case AdapterConfig::CONTROL_COMMAND:
-      return CHECK_NOTNULL(AdapterManager::GetControlCommand());
+      return Subscribe(AdapterManager::GetControlCommand(), stats);
     case AdapterConfig::CONTI_RADAR:
-      return CHECK_NOTNULL(AdapterManager::GetContiRadar());
+      return Subscribe(AdapterManager::GetContiRadar(), stats);
     default:
       break;
   }
@@ -67,20 +97,55 @@ AdapterBase *GetAdapterByMessageType(const AdapterConfig::MessageType type) {
 TopicMonitor::TopicMonitor(const TopicConf &config, TopicStatus *status)
     : RecurrentRunner(FLAGS_topic_monitor_name, FLAGS_topic_monitor_interval)
     , config_(config), status_(status) {
+  adapter_ = SubscribeByMessageType(config_.type(), &stats_);
 }
 
 void TopicMonitor::RunOnce(const double current_time) {
-  auto *adapter = GetAdapterByMessageType(config_.type());
-  if (!adapter->HasReceived()) {
+  const auto window = stats_.Collect(current_time);
+  if (!adapter_->HasReceived()) {
     status_->set_message_delay(-1);
     return;
   }
-  const double delay = adapter->GetDelaySec();
+  const double delay = adapter_->GetDelaySec();
   if (delay > config_.acceptable_delay()) {
     status_->set_message_delay(delay);
   } else {
     status_->clear_message_delay();
   }
+  UpdateStats(window);
+}
+
+void TopicMonitor::UpdateStats(const TopicStats::Window &window) {
+  status_->set_rate(window.rate);
+  status_->set_jitter_p50(window.jitter_p50);
+  status_->set_jitter_p95(window.jitter_p95);
+  status_->set_jitter_p99(window.jitter_p99);
+  status_->set_max_gap(window.max_gap);
+  status_->set_latency_mean(window.latency_mean);
+  status_->set_latency_max(window.latency_max);
+  if (window.num_dropped > 0) {
+    AWARN << "Topic stats dropped " << window.num_dropped << " arrivals of "
+          << adapter_->topic_name();
+  }
+
+  std::vector<std::string> abnormal;
+  if (config_.has_min_rate() && window.rate < config_.min_rate()) {
+    abnormal.push_back(StringPrintf("Low rate %.1fHz", window.rate));
+  }
+  if (config_.has_max_jitter() && window.jitter_p95 > config_.max_jitter()) {
+    abnormal.push_back(StringPrintf("Jitter %.3fs", window.jitter_p95));
+  }
+  if (config_.has_max_gap() && window.max_gap > config_.max_gap()) {
+    abnormal.push_back(StringPrintf("Gap %.3fs", window.max_gap));
+  }
+  if (config_.has_max_latency() && window.latency_max > config_.max_latency()) {
+    abnormal.push_back(StringPrintf("Latency %.3fs", window.latency_max));
+  }
+  if (abnormal.empty()) {
+    status_->clear_abnormal_stats();
+  } else {
+    status_->set_abnormal_stats(PrintIter(abnormal, ", "));
+  }
 }
 
 }  // namespace monitor
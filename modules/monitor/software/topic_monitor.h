@@ -21,6 +21,7 @@
 #include "modules/common/adapters/adapter.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/monitor_conf.pb.h"
+#include "modules/monitor/software/topic_stats.h"
 
 namespace apollo {
 namespace monitor {
@@ -31,8 +32,13 @@ class TopicMonitor : public RecurrentRunner {
   void RunOnce(const double current_time) override;
 
  private:
+  void UpdateStats(const TopicStats::Window &window);
+
   const TopicConf &config_;
   TopicStatus *status_;
+  apollo::common::adapter::AdapterBase *adapter_;
+  // Fed by the adapter callback.
+  TopicStats stats_;
 };
 
 }  // namespace monitor
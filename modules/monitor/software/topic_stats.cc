@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/topic_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+// The value at the given fraction of the sorted values, which are reordered.
+double Percentile(const double fraction, std::vector<double> *values) {
+  const auto nth = values->begin() + static_cast<size_t>(
+                                         fraction * (values->size() - 1));
+  std::nth_element(values->begin(), nth, values->end());
+  return *nth;
+}
+
+}  // namespace
+
+TopicStats::TopicStats(const size_t capacity) {
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  slots_.reset(new Slot[size]);
+  mask_ = size - 1;
+  arrivals_.reserve(size);
+  deviations_.reserve(size);
+}
+
+void TopicStats::Record(const double receive_time, const double header_time) {
+  const uint64_t index = num_recorded_.load(std::memory_order_relaxed);
+  Slot &slot = slots_[index & mask_];
+  slot.receive_time.store(receive_time, std::memory_order_relaxed);
+  slot.header_time.store(header_time, std::memory_order_relaxed);
+  num_recorded_.store(index + 1, std::memory_order_release);
+}
+
+TopicStats::Window TopicStats::Collect(const double current_time) {
+  const uint64_t capacity = mask_ + 1;
+  const uint64_t end = num_recorded_.load(std::memory_order_acquire);
+  uint64_t begin =
+      std::max(num_collected_, end > capacity ? end - capacity : 0);
+  arrivals_.clear();
+  for (uint64_t i = begin; i < end; ++i) {
+    const Slot &slot = slots_[i & mask_];
+    arrivals_.push_back({slot.receive_time.load(std::memory_order_relaxed),
+                         slot.header_time.load(std::memory_order_relaxed)});
+  }
+  // Slots the recorder went on to overwrite while they were copied may be
+  // torn, drop them.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t recorded = num_recorded_.load(std::memory_order_relaxed);
+  if (recorded > capacity && recorded - capacity > begin) {
+    const uint64_t torn = std::min(recorded - capacity, end) - begin;
+    arrivals_.erase(arrivals_.begin(), arrivals_.begin() + torn);
+    begin += torn;
+  }
+
+  Window window;
+  window.num_messages = arrivals_.size();
+  window.num_dropped = begin - num_collected_;
+  num_collected_ = end;
+
+  if (window_start_ < 0.0) {
+    window_start_ = arrivals_.empty() ? current_time
+                                      : arrivals_.front().receive_time;
+  }
+  const double duration = current_time - window_start_;
+  if (duration > 0.0) {
+    window.rate = (window.num_messages + window.num_dropped) / duration;
+  }
+  window_start_ = current_time;
+
+  // The gap before the first arrival is unknown if arrivals were dropped.
+  double previous = last_receive_time_;
+  if (previous < 0.0 || window.num_dropped > 0) {
+    previous =
+        arrivals_.empty() ? current_time : arrivals_.front().receive_time;
+  }
+  const bool continued = has_received_ && window.num_dropped == 0;
+  deviations_.clear();
+  double latency_sum = 0.0;
+  int num_latencies = 0;
+  for (size_t i = 0; i < arrivals_.size(); ++i) {
+    const Arrival &arrival = arrivals_[i];
+    const double interval = arrival.receive_time - previous;
+    window.max_gap = std::max(window.max_gap, interval);
+    if (i > 0 || continued) {
+      deviations_.push_back(interval);
+    }
+    previous = arrival.receive_time;
+    if (arrival.header_time > 0.0) {
+      const double latency = arrival.receive_time - arrival.header_time;
+      latency_sum += latency;
+      window.latency_max =
+          num_latencies == 0 ? latency : std::max(window.latency_max, latency);
+      ++num_latencies;
+    }
+  }
+  window.max_gap = std::max(window.max_gap, current_time - previous);
+  if (!arrivals_.empty()) {
+    last_receive_time_ = arrivals_.back().receive_time;
+    has_received_ = true;
+  } else if (last_receive_time_ < 0.0) {
+    // Nothing received yet, count the silence from now on.
+    last_receive_time_ = current_time;
+  }
+  if (num_latencies > 0) {
+    window.latency_mean = latency_sum / num_latencies;
+  }
+
+  if (deviations_.size() >= 2) {
+    double mean = 0.0;
+    for (const double interval : deviations_) {
+      mean += interval;
+    }
+    mean /= deviations_.size();
+    for (double &deviation : deviations_) {
+      deviation = std::fabs(deviation - mean);
+    }
+    window.jitter_p50 = Percentile(0.5, &deviations_);
+    window.jitter_p95 = Percentile(0.95, &deviations_);
+    window.jitter_p99 = Percentile(0.99, &deviations_);
+  }
+  return window;
+}
+
+}  // namespace monitor
+}  // namespace apollo
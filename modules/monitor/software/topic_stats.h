@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef MODULES_MONITOR_SOFTWARE_TOPIC_STATS_H_
+#define MODULES_MONITOR_SOFTWARE_TOPIC_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @namespace apollo::monitor
+ * @brief apollo::monitor
+ */
+namespace apollo {
+namespace monitor {
+
+/**
+ * @class TopicStats
+ * @brief Collects message arrivals of a topic and summarizes them in windows.
+ *
+ * One thread records arrivals, usually the adapter callback, and another one
+ * collects them. Recording only writes to a ring buffer and never blocks. If
+ * the collector falls more than a full ring behind, the oldest arrivals are
+ * dropped and counted.
+ */
+class TopicStats {
+ public:
+  struct Window {
+    int num_messages = 0;
+    // Arrivals that were overwritten before being collected.
+    int num_dropped = 0;
+    // Messages per second over the window.
+    double rate = 0.0;
+    // Percentiles of the deviation of the inter-arrival intervals from their
+    // mean, in seconds. Need at least two intervals.
+    double jitter_p50 = 0.0;
+    double jitter_p95 = 0.0;
+    double jitter_p99 = 0.0;
+    // The longest time without a message, including the time since the last
+    // message.
+    double max_gap = 0.0;
+    // Time from the header timestamp to the arrival, over the messages with a
+    // header timestamp.
+    double latency_mean = 0.0;
+    double latency_max = 0.0;
+  };
+
+  /**
+   * @param capacity Number of arrivals kept between collections, rounded up to
+   * a power of two.
+   */
+  explicit TopicStats(const size_t capacity = 1024);
+
+  /**
+   * @brief Records a message arrival. Only one thread may call it.
+   * @param header_time Header timestamp of the message, or 0 if it has none.
+   */
+  void Record(const double receive_time, const double header_time);
+
+  /**
+   * @brief Summarizes the arrivals since the previous collection, or since
+   * the first arrival for the first collection. Only one thread may call it.
+   */
+  Window Collect(const double current_time);
+
+ private:
+  struct Slot {
+    std::atomic<double> receive_time{0.0};
+    std::atomic<double> header_time{0.0};
+  };
+
+  struct Arrival {
+    double receive_time;
+    double header_time;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  uint64_t mask_ = 0;
+  std::atomic<uint64_t> num_recorded_{0};
+
+  // Collector state.
+  uint64_t num_collected_ = 0;
+  double window_start_ = -1.0;
+  // The last arrival, or the first collection until something arrives.
+  double last_receive_time_ = -1.0;
+  bool has_received_ = false;
+  std::vector<Arrival> arrivals_;
+  std::vector<double> deviations_;
+};
+
+}  // namespace monitor
+}  // namespace apollo
+
+#endif  // MODULES_MONITOR_SOFTWARE_TOPIC_STATS_H_
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/topic_stats.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+
+TEST(TopicStatsTest, RegularArrivals) {
+  TopicStats stats;
+  // 10Hz, each message 20ms old on arrival.
+  for (int i = 0; i <= 10; ++i) {
+    stats.Record(100.0 + 0.1 * i, 100.0 + 0.1 * i - 0.02);
+  }
+  auto window = stats.Collect(101.0);
+  EXPECT_EQ(11, window.num_messages);
+  EXPECT_EQ(0, window.num_dropped);
+  EXPECT_NEAR(11.0, window.rate, 1e-9);
+  EXPECT_NEAR(0.0, window.jitter_p99, 1e-9);
+  EXPECT_NEAR(0.1, window.max_gap, 1e-9);
+  EXPECT_NEAR(0.02, window.latency_mean, 1e-9);
+  EXPECT_NEAR(0.02, window.latency_max, 1e-9);
+
+  // The next window continues from the last arrival.
+  for (int i = 1; i <= 10; ++i) {
+    stats.Record(101.0 + 0.1 * i, 0.0);
+  }
+  window = stats.Collect(102.0);
+  EXPECT_EQ(10, window.num_messages);
+  EXPECT_NEAR(10.0, window.rate, 1e-9);
+  EXPECT_NEAR(0.0, window.jitter_p99, 1e-9);
+  EXPECT_NEAR(0.1, window.max_gap, 1e-9);
+  // No header timestamps.
+  EXPECT_DOUBLE_EQ(0.0, window.latency_max);
+}
+
+TEST(TopicStatsTest, JitterAndGaps) {
+  TopicStats stats;
+  // Intervals of 0.1s, except one of 0.5s and one of 0.02s.
+  double time = 10.0;
+  for (int i = 0; i < 101; ++i) {
+    if (i == 50) {
+      time += 0.5;
+    } else if (i == 70) {
+      time += 0.02;
+    } else if (i > 0) {
+      time += 0.1;
+    }
+    stats.Record(time, 0.0);
+  }
+  const auto window = stats.Collect(time + 1.0);
+  EXPECT_EQ(101, window.num_messages);
+  // Silence since the last message counts as a gap.
+  EXPECT_NEAR(1.0, window.max_gap, 1e-9);
+  const double mean = (98 * 0.1 + 0.5 + 0.02) / 100;
+  EXPECT_NEAR(mean - 0.1, window.jitter_p50, 1e-9);
+  EXPECT_NEAR(mean - 0.1, window.jitter_p95, 1e-9);
+  EXPECT_NEAR(mean - 0.02, window.jitter_p99, 1e-9);
+}
+
+TEST(TopicStatsTest, NoMessages) {
+  TopicStats stats;
+  auto window = stats.Collect(5.0);
+  EXPECT_EQ(0, window.num_messages);
+  EXPECT_DOUBLE_EQ(0.0, window.rate);
+  EXPECT_DOUBLE_EQ(0.0, window.max_gap);
+
+  window = stats.Collect(8.0);
+  EXPECT_DOUBLE_EQ(0.0, window.rate);
+  EXPECT_DOUBLE_EQ(3.0, window.max_gap);
+}
+
+TEST(TopicStatsTest, DropsOverwrittenArrivals) {
+  TopicStats stats(16);
+  stats.Collect(1.0);
+  for (int i = 0; i < 40; ++i) {
+    stats.Record(1.0 + 0.01 * i, 0.0);
+  }
+  const auto window = stats.Collect(2.0);
+  EXPECT_EQ(16, window.num_messages);
+  EXPECT_EQ(24, window.num_dropped);
+  EXPECT_NEAR(40.0, window.rate, 1e-9);
+  EXPECT_NEAR(2.0 - 1.39, window.max_gap, 1e-9);
+}
+
+TEST(TopicStatsTest, ConcurrentRecording) {
+  TopicStats stats(64);
+  constexpr int kNumMessages = 200000;
+  std::thread recorder([&stats] {
+    for (int i = 1; i <= kNumMessages; ++i) {
+      stats.Record(i, i - 0.5);
+    }
+  });
+  int num_seen = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const auto window = stats.Collect(kNumMessages + 1.0);
+    num_seen += window.num_messages + window.num_dropped;
+    if (window.num_messages > 0) {
+      EXPECT_DOUBLE_EQ(0.5, window.latency_mean);
+      EXPECT_DOUBLE_EQ(0.5, window.latency_max);
+    }
+  }
+  recorder.join();
+  const auto window = stats.Collect(kNumMessages + 1.0);
+  EXPECT_EQ(kNumMessages, num_seen + window.num_messages + window.num_dropped);
+}
+
+}  // namespace monitor
+}  // namespace apollo
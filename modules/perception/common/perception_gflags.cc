@@ -39,6 +39,9 @@ DEFINE_string(onboard_roi_filter, "DummyROIFilter", "onboard roi filter");
 DEFINE_string(onboard_segmentor, "DummySegmentation", "onboard segmentation");
 DEFINE_string(onboard_object_builder, "DummyObjectBuilder",
               "onboard object builder");
+DEFINE_int32(min_box_object_builder_thread_num, 1,
+             "number of threads building objects in MinBoxObjectBuilder, "
+             "which builds them in the caller thread if it is 1");
 DEFINE_string(onboard_tracker, "DummyTracker", "onboard tracker");
 DEFINE_string(onboard_type_fuser, "DummyTypeFuser", "onboard type fuser");
 
@@ -63,6 +66,12 @@ DEFINE_string(radar_tf2_child_frame_id, "radar",
               "the tf2 transform child frame id");
 DEFINE_double(front_radar_forward_distance, 120.0,
               "get front radar forward distancer");
+DEFINE_double(radar_roi_update_distance, 10.0,
+              "query the hdmap roi shared by the radars again and rebuild its "
+              "index after a radar moved this distance from the last query");
+DEFINE_int32(radar_process_thread_num, 0,
+             "number of threads processing the frames of all the radars, "
+             "which are processed in their callbacks if it is 0");
 DEFINE_string(radar_extrinsic_file,
               "modules/perception/data/params/radar_extrinsics.yaml",
               "radar extrinsic file");
@@ -78,6 +87,13 @@ DEFINE_double(query_signal_range, 100.0, "max distance to front signals");
 DEFINE_bool(output_raw_img, false, "write raw image to disk");
 DEFINE_bool(output_debug_img, false, "write debug image to disk");
 
+/// obstacle/fusion/probabilistic_fusion/probabilistic_fusion.cc
+DEFINE_double(fusion_max_out_of_sequence_delay, 0.0,
+              "max delay in seconds of sensor frames older than the last "
+              "fusion, which are fused at the fusion time by predicting their "
+              "objects, and older frames are dropped. Late frames are fused "
+              "at their own time if it is 0");
+
 /// Temporarily change Kalman motion fusion to config here.
 DEFINE_double(q_matrix_coefficient_amplifier, 0.5,
               "Kalman fitler matrix Q coeffcients");
@@ -37,6 +37,7 @@ DECLARE_bool(enable_hdmap_input);
 DECLARE_string(onboard_roi_filter);
 DECLARE_string(onboard_segmentor);
 DECLARE_string(onboard_object_builder);
+DECLARE_int32(min_box_object_builder_thread_num);
 DECLARE_string(onboard_tracker);
 DECLARE_string(onboard_type_fuser);
 DECLARE_int32(tf2_buff_in_ms);
@@ -47,6 +48,8 @@ DECLARE_bool(enable_visualization);
 
 /// obstacle/onboard/radar_process_subnode.cc
 DECLARE_double(front_radar_forward_distance);
+DECLARE_double(radar_roi_update_distance);
+DECLARE_int32(radar_process_thread_num);
 DECLARE_string(onboard_radar_detector);
 DECLARE_int32(localization_buffer_size);
 DECLARE_string(radar_tf2_frame_id);
@@ -64,6 +67,9 @@ DECLARE_bool(output_debug_img);
 /// perception.cc
 DECLARE_string(dag_config_path);
 
+/// obstacle/fusion/probabilistic_fusion/probabilistic_fusion.cc
+DECLARE_double(fusion_max_out_of_sequence_delay);
+
 /// pbf_kalman_motion_fusion.cc
 DECLARE_double(q_matrix_coefficient_amplifier);
 DECLARE_double(r_matrix_amplifier);
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/obstacle/common/convex_hullxy.h"
+#include "modules/perception/obstacle/common/fast_convex_hullxy.h"
+
+namespace apollo {
+namespace perception {
+namespace {
+
+using pcl_util::Point;
+using pcl_util::PointCloud;
+using pcl_util::PointCloudPtr;
+
+// Clusters of obstacles of the given number of points, scattered in boxes of
+// pedestrian to truck sizes.
+std::vector<PointCloudPtr> RandomClusters(const int point_num) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> center(-60.0f, 60.0f);
+  std::uniform_real_distribution<float> size(0.5f, 10.0f);
+  std::uniform_real_distribution<float> unit(-0.5f, 0.5f);
+  std::vector<PointCloudPtr> clouds;
+  for (int i = 0; i < 64; ++i) {
+    const float center_x = center(engine);
+    const float center_y = center(engine);
+    const float length = size(engine);
+    const float width = size(engine) * 0.3f;
+    PointCloudPtr cloud(new PointCloud);
+    for (int j = 0; j < point_num; ++j) {
+      Point p;
+      p.x = center_x + unit(engine) * length;
+      p.y = center_y + unit(engine) * width;
+      p.z = unit(engine);
+      cloud->points.push_back(p);
+    }
+    clouds.push_back(cloud);
+  }
+  return clouds;
+}
+
+template <typename ConvexHull>
+void BM_Reconstruct2dxy(benchmark::State& state) {
+  const std::vector<PointCloudPtr> clouds = RandomClusters(state.range(0));
+  ConvexHull convex_hull;
+  std::vector<pcl::Vertices> poly_vt;
+  PointCloudPtr plane_hull(new PointCloud);
+  while (state.KeepRunning()) {
+    for (const auto& cloud : clouds) {
+      convex_hull.setInputCloud(cloud);
+      convex_hull.setDimension(2);
+      convex_hull.Reconstruct2dxy(plane_hull, &poly_vt);
+      benchmark::DoNotOptimize(plane_hull->points.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * clouds.size());
+}
+BENCHMARK_TEMPLATE(BM_Reconstruct2dxy, ConvexHull2DXY<Point>)
+    ->RangeMultiplier(4)
+    ->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(BM_Reconstruct2dxy, FastConvexHull2DXY<Point>)
+    ->RangeMultiplier(4)
+    ->Range(8, 8 << 10);
+
+}  // namespace
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
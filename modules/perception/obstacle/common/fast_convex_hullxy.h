@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_COMMON_FAST_CONVEX_HULLXY_H_
+#define MODULES_PERCEPTION_OBSTACLE_COMMON_FAST_CONVEX_HULLXY_H_
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "pcl/Vertices.h"
+#include "pcl/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+
+// @brief: convex hull of points in the xy plane, a drop-in for
+// ConvexHull2DXY which needs no qhull. The hull is computed by Andrew's
+// monotone chain, in buffers which are reused by the next reconstructions.
+// It has the same vertices as ConvexHull2DXY, in the same order, and fails
+// for the same degenerate clouds. Vertices of duplicate points are copied
+// from the first of them. Unlike ConvexHull2DXY, hulls may be
+// reconstructed in parallel by different instances.
+template <typename PointInT>
+class FastConvexHull2DXY {
+ public:
+  typedef pcl::PointCloud<PointInT> PointCloud;
+  typedef typename PointCloud::Ptr PointCloudPtr;
+  typedef typename PointCloud::ConstPtr PointCloudConstPtr;
+
+  FastConvexHull2DXY() = default;
+  virtual ~FastConvexHull2DXY() = default;
+
+  void setInputCloud(const PointCloudConstPtr &cloud) {
+    input_ = cloud;
+  }
+
+  // @brief: hulls are always computed in the xy plane, the dimension is only
+  // accepted as ConvexHull2DXY does.
+  void setDimension(const int dimension) {}
+
+  // @brief: reconstruct the hull of the input cloud
+  // @params[OUT] hull: vertices of the hull, copied from the input cloud and
+  // sorted clockwise, or none if the hull is degenerate
+  // @params[OUT] polygons: one polygon of the indices of the vertices in
+  // hull, or none if the hull is degenerate
+  void Reconstruct2dxy(PointCloudPtr hull,
+                       std::vector<pcl::Vertices> *polygons) {
+    hull->header = input_->header;
+    if (input_->points.empty()) {
+      hull->points.clear();
+      return;
+    }
+
+    if (ComputeHull()) {
+      const size_t num_vertices = chain_.size();
+      const size_t first = FirstVertex();
+      hull->points.resize(num_vertices);
+      polygons->resize(1);
+      (*polygons)[0].vertices.resize(num_vertices);
+      for (size_t i = 0; i < num_vertices; ++i) {
+        hull->points[i] =
+            input_->points[chain_[(first + num_vertices - i) % num_vertices]
+                               .index];
+        (*polygons)[0].vertices[i] = static_cast<uint32_t>(i);
+      }
+    } else {
+      hull->points.clear();
+      polygons->clear();
+    }
+
+    hull->width = static_cast<uint32_t>(hull->points.size());
+    hull->height = 1;
+    hull->is_dense = true;
+  }
+
+  std::string getClassName() const {
+    return "FastConvexHull2DXY";
+  }
+
+ private:
+  struct XyPoint {
+    double x;
+    double y;
+    int index;
+  };
+
+  // Twice the signed area of the triangle o, a, b, positive if it is
+  // counterclockwise.
+  static double Cross(const XyPoint &o, const XyPoint &a, const XyPoint &b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+  }
+
+  // Copies the points which may be vertices of the hull to sorted_points_.
+  // Points strictly inside the octagon of the extreme points along the axes
+  // and the diagonals are inside the hull, and are dropped before sorting.
+  void CollectCandidates() {
+    const auto &points = input_->points;
+    const int num_points = static_cast<int>(points.size());
+    // Extreme points in the directions (-1, 0), (-1, -1), (0, -1), (1, -1),
+    // (1, 0), (1, 1), (0, 1) and (-1, 1), which are counterclockwise.
+    XyPoint extremes[8];
+    for (int i = 0; i < num_points; ++i) {
+      const XyPoint point = {points[i].x, points[i].y, i};
+      if (i == 0) {
+        std::fill(extremes, extremes + 8, point);
+        continue;
+      }
+      if (point.x < extremes[0].x) extremes[0] = point;
+      if (point.x + point.y < extremes[1].x + extremes[1].y) {
+        extremes[1] = point;
+      }
+      if (point.y < extremes[2].y) extremes[2] = point;
+      if (point.x - point.y > extremes[3].x - extremes[3].y) {
+        extremes[3] = point;
+      }
+      if (point.x > extremes[4].x) extremes[4] = point;
+      if (point.x + point.y > extremes[5].x + extremes[5].y) {
+        extremes[5] = point;
+      }
+      if (point.y > extremes[6].y) extremes[6] = point;
+      if (point.y - point.x > extremes[7].y - extremes[7].x) {
+        extremes[7] = point;
+      }
+    }
+    // Edges of the octagon, skipping those of duplicate extreme points.
+    int num_edges = 0;
+    XyPoint edges[8][2];
+    for (int i = 0; i < 8; ++i) {
+      const XyPoint &a = extremes[i];
+      const XyPoint &b = extremes[(i + 1) % 8];
+      if (a.x != b.x || a.y != b.y) {
+        edges[num_edges][0] = a;
+        edges[num_edges][1] = b;
+        ++num_edges;
+      }
+    }
+
+    sorted_points_.clear();
+    for (int i = 0; i < num_points; ++i) {
+      const XyPoint point = {points[i].x, points[i].y, i};
+      bool inside = num_edges >= 3;
+      for (int j = 0; j < num_edges && inside; ++j) {
+        inside = Cross(edges[j][0], edges[j][1], point) > 0.0;
+      }
+      if (!inside) {
+        sorted_points_.push_back(point);
+      }
+    }
+  }
+
+  // Computes the vertices of the hull counterclockwise in chain_, dropping
+  // the points on its edges. Returns false if the hull has no area.
+  bool ComputeHull() {
+    CollectCandidates();
+    // Of duplicate points, the first one may be a vertex.
+    std::sort(sorted_points_.begin(), sorted_points_.end(),
+              [](const XyPoint &a, const XyPoint &b) {
+                return a.x < b.x ||
+                       (a.x == b.x &&
+                        (a.y < b.y || (a.y == b.y && a.index < b.index)));
+              });
+    sorted_points_.erase(
+        std::unique(sorted_points_.begin(), sorted_points_.end(),
+                    [](const XyPoint &a, const XyPoint &b) {
+                      return a.x == b.x && a.y == b.y;
+                    }),
+        sorted_points_.end());
+    const int num_points = static_cast<int>(sorted_points_.size());
+
+    // The lower chain from left to right, then the upper chain back to the
+    // leftmost point, which ends the chain again.
+    chain_.resize(2 * num_points);
+    int num_vertices = 0;
+    for (int i = 0; i < num_points; ++i) {
+      while (num_vertices >= 2 &&
+             Cross(chain_[num_vertices - 2], chain_[num_vertices - 1],
+                   sorted_points_[i]) <= 0.0) {
+        --num_vertices;
+      }
+      chain_[num_vertices++] = sorted_points_[i];
+    }
+    const int lower_size = num_vertices + 1;
+    for (int i = num_points - 2; i >= 0; --i) {
+      while (num_vertices >= lower_size &&
+             Cross(chain_[num_vertices - 2], chain_[num_vertices - 1],
+                   sorted_points_[i]) <= 0.0) {
+        --num_vertices;
+      }
+      chain_[num_vertices++] = sorted_points_[i];
+    }
+    chain_.resize(std::max(num_vertices - 1, 0));
+    return chain_.size() >= 3u;
+  }
+
+  // Returns the vertex of chain_ which starts the hull. ConvexHull2DXY sorts
+  // the vertices by decreasing angles around their centroid, from pi to -pi,
+  // which are computed in float in the same way.
+  size_t FirstVertex() const {
+    const auto &points = input_->points;
+    float centroid_x = 0.0f;
+    float centroid_y = 0.0f;
+    for (const auto &vertex : chain_) {
+      centroid_x += points[vertex.index].x;
+      centroid_y += points[vertex.index].y;
+    }
+    centroid_x /= chain_.size();
+    centroid_y /= chain_.size();
+    size_t first = 0;
+    float max_angle = 0.0f;
+    for (size_t i = 0; i < chain_.size(); ++i) {
+      const auto &point = points[chain_[i].index];
+      const float angle =
+          std::atan2(point.y - centroid_y, point.x - centroid_x);
+      if (i == 0 || angle > max_angle) {
+        first = i;
+        max_angle = angle;
+      }
+    }
+    return first;
+  }
+
+  PointCloudConstPtr input_;
+  std::vector<XyPoint> sorted_points_;
+  std::vector<XyPoint> chain_;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_COMMON_FAST_CONVEX_HULLXY_H_
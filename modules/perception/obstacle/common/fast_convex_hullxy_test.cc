@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/common/fast_convex_hullxy.h"
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/obstacle/common/convex_hullxy.h"
+
+namespace apollo {
+namespace perception {
+
+using pcl_util::Point;
+using pcl_util::PointCloud;
+using pcl_util::PointCloudPtr;
+
+namespace {
+
+std::vector<PointCloudPtr> ReadClusters() {
+  std::ifstream cluster_ifs(
+      "modules/perception/data/obstacle_common_test/"
+      "QB9178_3_1461381834_1461382134_30651.pcd");
+  std::vector<PointCloudPtr> clouds;
+  std::string point_buf;
+  while (std::getline(cluster_ifs, point_buf)) {
+    std::stringstream ss(point_buf);
+    int point_num = 0;
+    ss >> point_num;
+    if (point_num <= 0) {
+      continue;
+    }
+    uint64_t intensity;
+    PointCloudPtr cloud(new PointCloud);
+    for (int i = 0; i < point_num; ++i) {
+      Point p;
+      ss >> p.x >> p.y >> p.z >> intensity;
+      p.intensity = static_cast<uint8_t>(intensity);
+      cloud->points.push_back(p);
+    }
+    clouds.push_back(cloud);
+  }
+  return clouds;
+}
+
+// Clusters of obstacles: points scattered in a rotated box, some of them on
+// a grid to have collinear and duplicate points.
+PointCloudPtr RandomCluster(const int point_num, std::mt19937* engine) {
+  std::uniform_real_distribution<float> center(-60.0f, 60.0f);
+  std::uniform_real_distribution<float> size(0.2f, 5.0f);
+  std::uniform_real_distribution<float> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<float> unit(-0.5f, 0.5f);
+  const float center_x = center(*engine);
+  const float center_y = center(*engine);
+  const float length = size(*engine);
+  const float width = size(*engine);
+  const float theta = heading(*engine);
+  PointCloudPtr cloud(new PointCloud);
+  for (int i = 0; i < point_num; ++i) {
+    float x = unit(*engine) * length;
+    float y = unit(*engine) * width;
+    if (i % 3 == 0) {
+      x = std::round(x * 10.0f) / 10.0f;
+      y = std::round(y * 10.0f) / 10.0f;
+    }
+    Point p;
+    p.x = center_x + std::cos(theta) * x - std::sin(theta) * y;
+    p.y = center_y + std::sin(theta) * x + std::cos(theta) * y;
+    p.z = unit(*engine);
+    cloud->points.push_back(p);
+  }
+  return cloud;
+}
+
+void ExpectSameHull(const PointCloudPtr& cloud) {
+  ConvexHull2DXY<Point> convex_hull;
+  convex_hull.setInputCloud(cloud);
+  convex_hull.setDimension(2);
+  std::vector<pcl::Vertices> poly_vt;
+  PointCloudPtr plane_hull(new PointCloud);
+  convex_hull.Reconstruct2dxy(plane_hull, &poly_vt);
+
+  FastConvexHull2DXY<Point> fast_convex_hull;
+  fast_convex_hull.setInputCloud(cloud);
+  fast_convex_hull.setDimension(2);
+  std::vector<pcl::Vertices> fast_poly_vt;
+  PointCloudPtr fast_plane_hull(new PointCloud);
+  fast_convex_hull.Reconstruct2dxy(fast_plane_hull, &fast_poly_vt);
+
+  ASSERT_EQ(poly_vt.size(), fast_poly_vt.size());
+  ASSERT_EQ(plane_hull->points.size(), fast_plane_hull->points.size());
+  for (size_t i = 0; i < poly_vt.size(); ++i) {
+    EXPECT_EQ(poly_vt[i].vertices, fast_poly_vt[i].vertices);
+  }
+  // Vertices of duplicate points may be copied from any of them.
+  for (size_t i = 0; i < plane_hull->points.size(); ++i) {
+    EXPECT_EQ(plane_hull->points[i].x, fast_plane_hull->points[i].x);
+    EXPECT_EQ(plane_hull->points[i].y, fast_plane_hull->points[i].y);
+  }
+  EXPECT_EQ(plane_hull->width, fast_plane_hull->width);
+  EXPECT_EQ(plane_hull->height, fast_plane_hull->height);
+}
+
+}  // namespace
+
+TEST(FastConvexHull2DXYTest, same_as_convex_hull_2dxy) {
+  const std::vector<PointCloudPtr> clouds = ReadClusters();
+  EXPECT_EQ(5, clouds.size());
+  for (const auto& cloud : clouds) {
+    ExpectSameHull(cloud);
+  }
+  std::mt19937 engine(0);
+  for (int point_num = 3; point_num < 2000; point_num = point_num * 5 / 4 + 1) {
+    ExpectSameHull(RandomCluster(point_num, &engine));
+  }
+}
+
+TEST(FastConvexHull2DXYTest, degenerate) {
+  FastConvexHull2DXY<Point> convex_hull;
+  EXPECT_EQ(convex_hull.getClassName(), "FastConvexHull2DXY");
+  std::vector<pcl::Vertices> poly_vt;
+  PointCloudPtr plane_hull(new PointCloud);
+  // collinear and duplicate points
+  PointCloudPtr cloud(new PointCloud);
+  for (int i = 0; i < 4; ++i) {
+    Point pt;
+    pt.x = i;
+    pt.y = 2.0 * i;
+    pt.z = 0.0;
+    cloud->push_back(pt);
+    cloud->push_back(pt);
+  }
+  ExpectSameHull(cloud);
+  convex_hull.setInputCloud(cloud);
+  convex_hull.Reconstruct2dxy(plane_hull, &poly_vt);
+  EXPECT_EQ(0, poly_vt.size());
+  EXPECT_EQ(0, plane_hull->points.size());
+  // one point
+  cloud->resize(1);
+  ExpectSameHull(cloud);
+  convex_hull.Reconstruct2dxy(plane_hull, &poly_vt);
+  EXPECT_EQ(0, poly_vt.size());
+  // a triangle after a degenerate hull
+  Point pt;
+  pt.x = 1.0;
+  pt.y = 0.0;
+  pt.z = 0.0;
+  cloud->push_back(pt);
+  pt.y = 1.0;
+  cloud->push_back(pt);
+  ExpectSameHull(cloud);
+  convex_hull.Reconstruct2dxy(plane_hull, &poly_vt);
+  ASSERT_EQ(1, poly_vt.size());
+  EXPECT_EQ(3, poly_vt[0].vertices.size());
+  EXPECT_EQ(3, plane_hull->points.size());
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -75,6 +75,17 @@ class BaseFusion {
   // @return true if fuse successfully, otherwise return false
   virtual bool Fuse(const std::vector<SensorObjects> &multi_sensor_objects,
                     std::vector<ObjectPtr> *fused_objects) = 0;
+
+  // @brief: get timestamp of the latest fused frame of a sensor, which is
+  // the time of its data in the fused objects.
+  // @param [in]: sensor id.
+  // @param [out]: timestamp of the frame.
+  // @return true if a frame of the sensor has been fused
+  virtual bool GetFusedSensorTimestamp(const std::string &sensor_id,
+                                       double *timestamp) {
+    return false;
+  }
+
   virtual std::string name() const = 0;
 
  private:
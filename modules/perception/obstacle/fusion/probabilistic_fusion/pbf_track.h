@@ -103,10 +103,11 @@ class PbfTrack {
 
   static void SetMotionFusionMethod(const std::string motion_fusion_method);
 
- protected:
   /**@brief use obj's velocity to update obj's location to input timestamp*/
-  void PerformMotionCompensation(PbfSensorObjectPtr obj, double timestamp);
+  static void PerformMotionCompensation(PbfSensorObjectPtr obj,
+                                        double timestamp);
 
+ protected:
   void PerformMotionFusion(PbfSensorObjectPtr obj);
 
   void UpdateMeasurementsLifeWithMeasurement(
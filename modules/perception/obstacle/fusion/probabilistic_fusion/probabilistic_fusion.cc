@@ -16,10 +16,12 @@
 
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/probabilistic_fusion.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <string>
 #include <vector>
 #include "modules/common/macro.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_base_track_object_matcher.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_hm_track_object_matcher.h"
@@ -34,6 +36,7 @@ ProbabilisticFusion::ProbabilisticFusion()
       matcher_(nullptr),
       sensor_manager_(nullptr),
       track_manager_(nullptr),
+      fused_timestamp_(0.0),
       use_radar_(true),
       use_lidar_(true) {}
 
@@ -220,6 +223,17 @@ bool ProbabilisticFusion::Fuse(
   return true;
 }
 
+bool ProbabilisticFusion::GetFusedSensorTimestamp(
+    const std::string &sensor_id, double *timestamp) {
+  std::lock_guard<std::mutex> lock(fusion_mutex_);
+  auto it = fused_sensor_timestamps_.find(sensor_id);
+  if (it == fused_sensor_timestamps_.end()) {
+    return false;
+  }
+  *timestamp = it->second;
+  return true;
+}
+
 std::string ProbabilisticFusion::name() const {
   return "ProbabilisticFusion";
 }
@@ -229,15 +243,52 @@ void ProbabilisticFusion::FuseFrame(const PbfSensorFramePtr &frame) {
         << "object_number: " << frame->objects.size() << ","
         << "timestamp: " << std::fixed << std::setprecision(12)
         << frame->timestamp;
-  std::vector<PbfSensorObjectPtr> &objects = frame->objects;
+  // Frames arriving after the last fusion don't update tracks back in time
+  // if an out of sequence delay is set, their objects are predicted to it.
+  PbfSensorFramePtr fused_frame = frame;
+  if (FLAGS_fusion_max_out_of_sequence_delay > 0.0 &&
+      frame->timestamp < fused_timestamp_) {
+    fused_frame = PredictLateFrame(frame);
+    if (fused_frame == nullptr) {
+      return;
+    }
+  }
+  std::vector<PbfSensorObjectPtr> &objects = fused_frame->objects;
   std::vector<PbfSensorObjectPtr> background_objects;
   std::vector<PbfSensorObjectPtr> foreground_objects;
   DecomposeFrameObjects(objects, &foreground_objects, &background_objects);
 
-  Eigen::Vector3d ref_point = frame->sensor2world_pose.topRightCorner(3, 1);
-  FuseForegroundObjects(&foreground_objects, ref_point, frame->sensor_type,
-                        frame->sensor_id, frame->timestamp);
+  Eigen::Vector3d ref_point =
+      fused_frame->sensor2world_pose.topRightCorner(3, 1);
+  FuseForegroundObjects(&foreground_objects, ref_point,
+                        fused_frame->sensor_type, fused_frame->sensor_id,
+                        fused_frame->timestamp);
   track_manager_->RemoveLostTracks();
+
+  fused_timestamp_ = std::max(fused_timestamp_, fused_frame->timestamp);
+  double &sensor_timestamp = fused_sensor_timestamps_[frame->sensor_id];
+  sensor_timestamp = std::max(sensor_timestamp, frame->timestamp);
+}
+
+PbfSensorFramePtr ProbabilisticFusion::PredictLateFrame(
+    const PbfSensorFramePtr &frame) const {
+  double delay = fused_timestamp_ - frame->timestamp;
+  if (delay > FLAGS_fusion_max_out_of_sequence_delay) {
+    AWARN << "Drop frame: " << frame->sensor_id << ", "
+          << "timestamp: " << GLOG_TIMESTAMP(frame->timestamp) << ", "
+          << delay << "s older than the last fusion";
+    return nullptr;
+  }
+  PbfSensorFramePtr predicted_frame(new PbfSensorFrame(*frame));
+  predicted_frame->timestamp = fused_timestamp_;
+  for (size_t i = 0; i < predicted_frame->objects.size(); i++) {
+    PbfSensorObjectPtr obj(new PbfSensorObject());
+    obj->clone(*(frame->objects[i]));
+    PbfTrack::PerformMotionCompensation(obj, fused_timestamp_);
+    predicted_frame->objects[i] = obj;
+  }
+  ADEBUG << "Predict frame: " << frame->sensor_id << " by " << delay << "s";
+  return predicted_frame;
 }
 
 void ProbabilisticFusion::CreateNewTracks(
@@ -16,6 +16,7 @@
 
 #ifndef MODULES_PERCEPTION_OBSTACLE_FUSION_PROBABILISTIC_FUSION_PROBABILISTIC_FUSION_H_ // NOLINT
 #define MODULES_PERCEPTION_OBSTACLE_FUSION_PROBABILISTIC_FUSION_PROBABILISTIC_FUSION_H_ // NOLINT
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -44,11 +45,18 @@ class ProbabilisticFusion : public BaseFusion {
   virtual bool Fuse(const std::vector<SensorObjects> &multi_sensor_objects,
                     std::vector<ObjectPtr> *fused_objects);
 
+  virtual bool GetFusedSensorTimestamp(const std::string &sensor_id,
+                                       double *timestamp);
+
   virtual std::string name() const;
 
  protected:
   void FuseFrame(const PbfSensorFramePtr &frame);
 
+  /**@brief predict objects of a late frame to the timestamp of the last
+   * fusion, and return nullptr if the frame is too late to fuse*/
+  PbfSensorFramePtr PredictLateFrame(const PbfSensorFramePtr &frame) const;
+
   /**@brief create new tracks for objects not assigned to current tracks*/
   void CreateNewTracks(const std::vector<PbfSensorObjectPtr> &sensor_objects,
                        const std::vector<int> &unassigned_ids);
@@ -89,6 +97,10 @@ class ProbabilisticFusion : public BaseFusion {
   PbfTrackManager *track_manager_;
   std::mutex sensor_data_rw_mutex_;
   std::mutex fusion_mutex_;
+  /**@brief timestamp of the latest fused frame*/
+  double fused_timestamp_;
+  /**@brief timestamp of the latest fused frame of each sensor*/
+  std::map<std::string, double> fused_sensor_timestamps_;
   bool use_radar_;
   bool use_lidar_;
 
@@ -17,6 +17,8 @@
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/probabilistic_fusion.h"
 
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
 #include "modules/common/log.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/obstacle/base/object.h"
@@ -104,5 +106,88 @@ TEST(ProbabilisticFusionTest, probabilistic_fusion_test) {
   AINFO << "end probabilistic_fusion_test\n";
 }
 
+namespace {
+
+SensorObjects MakeSensorObjects(const SensorType sensor_type,
+                                const double timestamp) {
+  // A vehicle moving along x at 10m/s, which is at (0, 20) at 10s.
+  Eigen::Vector3d velocity(10, 0, 0);
+  Eigen::Vector3d position =
+      Eigen::Vector3d(0, 20, 0) + velocity * (timestamp - 10.0);
+  ObjectPtr obj(new Object());
+  obj->center = position;
+  obj->anchor_point = position;
+  obj->length = 4;
+  obj->width = 2;
+  obj->height = 2;
+  obj->velocity = velocity;
+  obj->type = VEHICLE;
+  obj->polygon.resize(1);
+  obj->polygon.points[0].x = position(0);
+  obj->polygon.points[0].y = position(1);
+  obj->polygon.points[0].z = position(2);
+
+  SensorObjects sensor_objects;
+  sensor_objects.sensor_type = sensor_type;
+  sensor_objects.seq_num = 0;
+  sensor_objects.timestamp = timestamp;
+  sensor_objects.sensor2world_pose = Eigen::Matrix4d::Identity();
+  sensor_objects.objects.push_back(obj);
+  return sensor_objects;
+}
+
+}  // namespace
+
+TEST(ProbabilisticFusionTest, fuse_late_frames) {
+  // restores the flags below when the test ends, even on a failed assertion
+  google::FlagSaver flag_saver;
+  FLAGS_work_root = "modules/perception";
+  FLAGS_config_manager_path = "./conf/config_manager.config";
+  FLAGS_fusion_max_out_of_sequence_delay = 0.2;
+  ProbabilisticFusion probabilistic_fusion;
+  EXPECT_TRUE(probabilistic_fusion.Init());
+  const std::string lidar_id = GetSensorType(VELODYNE_64);
+  const std::string radar_id = GetSensorType(RADAR);
+  double sensor_timestamp = 0.0;
+  EXPECT_FALSE(
+      probabilistic_fusion.GetFusedSensorTimestamp(radar_id, &sensor_timestamp));
+
+  // Replay lidar frames every 0.1s, with radar frames arriving late.
+  const double lidar_timestamps[] = {10.0, 10.1, 10.2, 10.3, 10.4, 10.5};
+  std::vector<ObjectPtr> fused_objects;
+  for (const double timestamp : lidar_timestamps) {
+    std::vector<SensorObjects> sensor_objects;
+    if (timestamp == 10.2) {
+      // 0.05s older than the last fusion, fused at 10.1
+      sensor_objects.push_back(MakeSensorObjects(RADAR, 10.05));
+    } else if (timestamp == 10.5) {
+      // 0.25s older than the last fusion, dropped
+      sensor_objects.push_back(MakeSensorObjects(RADAR, 10.15));
+    }
+    if (!sensor_objects.empty()) {
+      EXPECT_TRUE(probabilistic_fusion.Fuse(sensor_objects, &fused_objects));
+    }
+    std::vector<SensorObjects> lidar_objects;
+    lidar_objects.push_back(MakeSensorObjects(VELODYNE_64, timestamp));
+    EXPECT_TRUE(probabilistic_fusion.Fuse(lidar_objects, &fused_objects));
+
+    ASSERT_EQ(1u, fused_objects.size());
+    const ObjectPtr &obj = lidar_objects[0].objects[0];
+    EXPECT_DOUBLE_EQ(timestamp, fused_objects[0]->latest_tracked_time);
+    EXPECT_TRUE((fused_objects[0]->center - obj->center).norm() < 1.0e-2);
+    EXPECT_TRUE((fused_objects[0]->velocity - obj->velocity).norm() < 1.0e-1);
+
+    EXPECT_TRUE(probabilistic_fusion.GetFusedSensorTimestamp(
+        lidar_id, &sensor_timestamp));
+    EXPECT_DOUBLE_EQ(timestamp, sensor_timestamp);
+    if (timestamp >= 10.2) {
+      EXPECT_TRUE(probabilistic_fusion.GetFusedSensorTimestamp(
+          radar_id, &sensor_timestamp));
+      EXPECT_DOUBLE_EQ(10.05, sensor_timestamp);
+      AINFO << "radar data age: " << timestamp - sensor_timestamp;
+    }
+  }
+}
+
 }  // namespace perception
 }  // namespace apollo
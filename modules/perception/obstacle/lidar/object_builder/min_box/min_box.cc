@@ -16,11 +16,13 @@
 
 #include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
 
+#include <atomic>
+#include <future>
 #include <limits>
 #include <vector>
 
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
-#include "modules/perception/obstacle/common/convex_hullxy.h"
 #include "modules/perception/obstacle/common/geometry_util.h"
 
 namespace apollo {
@@ -31,6 +33,15 @@ using pcl_util::PointCloudPtr;
 
 const float EPSILON = 1e-6;
 
+bool MinBoxObjectBuilder::Init() {
+  const int thread_num = FLAGS_min_box_object_builder_thread_num;
+  if (thread_num > 1 && thread_pool_ == nullptr) {
+    thread_pool_.reset(new common::util::ThreadPool(thread_num));
+    buffers_.resize(thread_num);
+  }
+  return true;
+}
+
 bool MinBoxObjectBuilder::Build(const ObjectBuilderOptions& options,
                                 std::vector<ObjectPtr>* objects) {
   if (objects == NULL) {
@@ -40,17 +51,42 @@ bool MinBoxObjectBuilder::Build(const ObjectBuilderOptions& options,
   for (size_t i = 0; i < objects->size(); ++i) {
     if ((*objects)[i]) {
       (*objects)[i]->id = i;
-      BuildObject(options, (*objects)[i]);
     }
   }
 
+  if (thread_pool_ == nullptr || objects->size() < 2u) {
+    for (size_t i = 0; i < objects->size(); ++i) {
+      if ((*objects)[i]) {
+        BuildObject(options, (*objects)[i], &buffers_[0]);
+      }
+    }
+    return true;
+  }
+
+  // Workers take the next object to build until all of them are built, which
+  // balances objects of different sizes.
+  std::atomic<size_t> next_object(0);
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    futures.push_back(thread_pool_->Push([&](int id) {
+      for (size_t j = next_object++; j < objects->size(); j = next_object++) {
+        if ((*objects)[j]) {
+          BuildObject(options, (*objects)[j], &buffers_[id]);
+        }
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
   return true;
 }
 
 double MinBoxObjectBuilder::ComputeAreaAlongOneEdge(
     ObjectPtr obj, size_t first_in_point, Eigen::Vector3d* center,
-    double* lenth, double* width, Eigen::Vector3d* dir) {
-  std::vector<Eigen::Vector3d> ns;
+    double* lenth, double* width, Eigen::Vector3d* dir, BuildBuffer* buffer) {
+  std::vector<Eigen::Vector3d>& ns = buffer->pedals;
+  ns.clear();
   Eigen::Vector3d v(0.0, 0.0, 0.0);
   Eigen::Vector3d vn(0.0, 0.0, 0.0);
   Eigen::Vector3d n(0.0, 0.0, 0.0);
@@ -128,7 +164,8 @@ double MinBoxObjectBuilder::ComputeAreaAlongOneEdge(
 }
 
 void MinBoxObjectBuilder::ReconstructPolygon(const Eigen::Vector3d& ref_ct,
-                                             ObjectPtr obj) {
+                                             ObjectPtr obj,
+                                             BuildBuffer* buffer) {
   if (obj->polygon.points.size() <= 0) {
     return;
   }
@@ -252,7 +289,8 @@ void MinBoxObjectBuilder::ReconstructPolygon(const Eigen::Vector3d& ref_ct,
         double width = 0;
         Eigen::Vector3d dir;
         double area =
-            ComputeAreaAlongOneEdge(obj, i, &center, &length, &width, &dir);
+            ComputeAreaAlongOneEdge(obj, i, &center, &length, &width, &dir,
+                                    buffer);
         if (area < min_area) {
           obj->center = center;
           obj->length = length;
@@ -273,7 +311,8 @@ void MinBoxObjectBuilder::ReconstructPolygon(const Eigen::Vector3d& ref_ct,
       double width = 0;
       Eigen::Vector3d dir;
       double area =
-          ComputeAreaAlongOneEdge(obj, i, &center, &length, &width, &dir);
+          ComputeAreaAlongOneEdge(obj, i, &center, &length, &width, &dir,
+                                  buffer);
       if (area < min_area) {
         obj->center = center;
         obj->length = length;
@@ -293,7 +332,8 @@ void MinBoxObjectBuilder::ReconstructPolygon(const Eigen::Vector3d& ref_ct,
         double width = 0.0;
         Eigen::Vector3d dir;
         double area =
-            ComputeAreaAlongOneEdge(obj, i, &center, &length, &width, &dir);
+            ComputeAreaAlongOneEdge(obj, i, &center, &length, &width, &dir,
+                                    buffer);
         if (area < min_area) {
           obj->center = center;
           obj->length = length;
@@ -309,7 +349,8 @@ void MinBoxObjectBuilder::ReconstructPolygon(const Eigen::Vector3d& ref_ct,
   obj->direction.normalize();
 }
 
-void MinBoxObjectBuilder::ComputePolygon2dxy(ObjectPtr obj) {
+void MinBoxObjectBuilder::ComputePolygon2dxy(ObjectPtr obj,
+                                             BuildBuffer* buffer) {
   Eigen::Vector4f min_pt;
   Eigen::Vector4f max_pt;
   pcl_util::PointCloudPtr cloud = obj->cloud;
@@ -343,23 +384,25 @@ void MinBoxObjectBuilder::ComputePolygon2dxy(ObjectPtr obj) {
     cloud->points[1].x -= min_eps;
   }
 
-  PointCloudPtr pcd_xy(new PointCloud);
+  PointCloudPtr& pcd_xy = buffer->pcd_xy;
+  pcd_xy->clear();
   for (size_t i = 0; i < cloud->points.size(); ++i) {
     pcl_util::Point p = cloud->points[i];
     p.z = min_pt[2];
     pcd_xy->push_back(p);
   }
 
-  ConvexHull2DXY<pcl_util::Point> hull;
+  std::vector<pcl::Vertices>& poly_vt = buffer->poly_vt;
+  poly_vt.clear();
+  PointCloudPtr& plane_hull = buffer->plane_hull;
+  FastConvexHull2DXY<pcl_util::Point>& hull = buffer->hull;
   hull.setInputCloud(pcd_xy);
   hull.setDimension(2);
-  std::vector<pcl::Vertices> poly_vt;
-  PointCloudPtr plane_hull(new PointCloud);
   hull.Reconstruct2dxy(plane_hull, &poly_vt);
 
   if (poly_vt.size() == 1u) {
-    std::vector<int> ind(poly_vt[0].vertices.begin(),
-                         poly_vt[0].vertices.end());
+    std::vector<int>& ind = buffer->hull_indices;
+    ind.assign(poly_vt[0].vertices.begin(), poly_vt[0].vertices.end());
     TransformPointCloud(plane_hull, ind, &obj->polygon);
   } else {
     obj->polygon.points.resize(4);
@@ -382,14 +425,15 @@ void MinBoxObjectBuilder::ComputePolygon2dxy(ObjectPtr obj) {
 }
 
 void MinBoxObjectBuilder::ComputeGeometricFeature(const Eigen::Vector3d& ref_ct,
-                                                  ObjectPtr obj) {
-  ComputePolygon2dxy(obj);
-  ReconstructPolygon(ref_ct, obj);
+                                                  ObjectPtr obj,
+                                                  BuildBuffer* buffer) {
+  ComputePolygon2dxy(obj, buffer);
+  ReconstructPolygon(ref_ct, obj, buffer);
 }
 
 void MinBoxObjectBuilder::BuildObject(ObjectBuilderOptions options,
-                                      ObjectPtr object) {
-  ComputeGeometricFeature(options.ref_center, object);
+                                      ObjectPtr object, BuildBuffer* buffer) {
+  ComputeGeometricFeature(options.ref_center, object, buffer);
 }
 
 }  // namespace perception
@@ -17,10 +17,16 @@
 #ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_OBJECT_BUILDER_MIN_BOX_H
 #define MODULES_PERCEPTION_OBSTACLE_LIDAR_OBJECT_BUILDER_MIN_BOX_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "pcl/Vertices.h"
+
+#include "modules/common/util/ctpl_stl.h"
+#include "modules/perception/lib/pcl_util/pcl_types.h"
 #include "modules/perception/obstacle/base/object.h"
+#include "modules/perception/obstacle/common/fast_convex_hullxy.h"
 #include "modules/perception/obstacle/lidar/interface/base_object_builder.h"
 
 namespace apollo {
@@ -28,13 +34,18 @@ namespace perception {
 
 class MinBoxObjectBuilder : public BaseObjectBuilder {
  public:
-  MinBoxObjectBuilder() : BaseObjectBuilder() {}
+  MinBoxObjectBuilder() : BaseObjectBuilder() {
+    buffers_.resize(1);
+  }
   virtual ~MinBoxObjectBuilder() {}
 
-  bool Init() override {
-    return true;
-  }
+  // @brief: start the workers building objects in parallel, whose number is
+  // FLAGS_min_box_object_builder_thread_num. Objects are built in the caller
+  // thread of Build if it is not called.
+  bool Init() override;
 
+  // @brief: build objects, in parallel if there are workers. Each object is
+  // built independently, so the results do not depend on the workers.
   bool Build(const ObjectBuilderOptions& options,
              std::vector<ObjectPtr>* objects) override;
   std::string name() const override {
@@ -42,19 +53,42 @@ class MinBoxObjectBuilder : public BaseObjectBuilder {
   }
 
  protected:
-  void BuildObject(ObjectBuilderOptions options, ObjectPtr object);
+  // @brief: scratch buffers of a worker, reused by the objects it builds.
+  struct BuildBuffer {
+    BuildBuffer()
+        : pcd_xy(new pcl_util::PointCloud),
+          plane_hull(new pcl_util::PointCloud) {}
 
-  void ComputePolygon2dxy(ObjectPtr obj);
+    pcl_util::PointCloudPtr pcd_xy;
+    pcl_util::PointCloudPtr plane_hull;
+    FastConvexHull2DXY<pcl_util::Point> hull;
+    std::vector<pcl::Vertices> poly_vt;
+    std::vector<int> hull_indices;
+    std::vector<Eigen::Vector3d> pedals;
+  };
+
+  void BuildObject(ObjectBuilderOptions options, ObjectPtr object,
+                   BuildBuffer* buffer);
+
+  void ComputePolygon2dxy(ObjectPtr obj, BuildBuffer* buffer);
 
   double ComputeAreaAlongOneEdge(ObjectPtr obj, size_t first_in_point,
                                  Eigen::Vector3d* center, double* lenth,
-                                 double* width, Eigen::Vector3d* dir);
+                                 double* width, Eigen::Vector3d* dir,
+                                 BuildBuffer* buffer);
 
-  void ReconstructPolygon(const Eigen::Vector3d& ref_ct, ObjectPtr obj);
+  void ReconstructPolygon(const Eigen::Vector3d& ref_ct, ObjectPtr obj,
+                          BuildBuffer* buffer);
 
-  void ComputeGeometricFeature(const Eigen::Vector3d& ref_ct, ObjectPtr obj);
+  void ComputeGeometricFeature(const Eigen::Vector3d& ref_ct, ObjectPtr obj,
+                               BuildBuffer* buffer);
 
  private:
+  std::unique_ptr<common::util::ThreadPool> thread_pool_;
+  // buffers of workers, indexed by their ids, or of the caller thread of
+  // Build if there are no workers
+  std::vector<BuildBuffer> buffers_;
+
   DISALLOW_COPY_AND_ASSIGN(MinBoxObjectBuilder);
 };
 
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/obstacle/common/file_system_util.h"
+#include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
+
+namespace apollo {
+namespace perception {
+namespace {
+
+const char kDataPath[] = "modules/perception/data/hm_tracker_test/";
+
+// Segments of a recorded frame of the hm tracker test.
+std::vector<ObjectPtr> ReadObjects(const std::string& filename) {
+  std::vector<ObjectPtr> objects;
+  std::ifstream ifs(filename);
+  std::string type;
+  int no_point = 0;
+  float tmp = 0;
+  while (ifs >> type) {
+    ifs >> tmp >> tmp >> tmp >> no_point;
+    ObjectPtr obj(new Object());
+    obj->cloud->resize(no_point);
+    for (int j = 0; j < no_point; ++j) {
+      ifs >> obj->cloud->points[j].x >> obj->cloud->points[j].y >>
+          obj->cloud->points[j].z >> obj->cloud->points[j].intensity;
+    }
+    objects.push_back(obj);
+  }
+  return objects;
+}
+
+// Builds the objects of all the recorded frames, frame by frame, with the
+// given number of threads. Objects are rebuilt in place, which overwrites
+// all of their built fields.
+void BM_Build(benchmark::State& state) {
+  std::vector<std::string> seg_filenames;
+  GetFileNamesInFolderById(kDataPath, ".seg", &seg_filenames);
+  std::vector<std::vector<ObjectPtr>> frames;
+  int no_object = 0;
+  for (const auto& seg_filename : seg_filenames) {
+    frames.push_back(ReadObjects(kDataPath + seg_filename));
+    no_object += frames.back().size();
+  }
+  if (no_object == 0) {
+    state.SkipWithError("failed to read recorded frames");
+    return;
+  }
+  FLAGS_min_box_object_builder_thread_num = state.range(0);
+  MinBoxObjectBuilder object_builder;
+  object_builder.Init();
+  ObjectBuilderOptions options;
+  options.ref_center = Eigen::Vector3d(0, 0, -1.7);
+
+  while (state.KeepRunning()) {
+    for (auto& frame : frames) {
+      object_builder.Build(options, &frame);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * no_object);
+}
+BENCHMARK(BM_Build)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(std::thread::hardware_concurrency())
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -17,9 +17,12 @@
 #include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
 
 #include <fstream>
+#include <vector>
 
 #include "gtest/gtest.h"
 
+#include "modules/perception/common/perception_gflags.h"
+
 namespace apollo {
 namespace perception {
 
@@ -122,5 +125,53 @@ TEST_F(MinBoxObjectBuilderTest, build) {
   EXPECT_NEAR(0.0, objects[4]->direction[2], EPSILON);
 }
 
+TEST_F(MinBoxObjectBuilderTest, build_in_parallel) {
+  std::vector<ObjectPtr> clusters;
+  ConstructPointCloud(&clusters);
+  // copies of the clusters, shifted so that no two objects are the same
+  std::vector<ObjectPtr> objects;
+  std::vector<ObjectPtr> parallel_objects;
+  for (int i = 0; i < 40; ++i) {
+    for (const auto& cluster : clusters) {
+      ObjectPtr object(new Object);
+      object->cloud.reset(new pcl_util::PointCloud(*cluster->cloud));
+      for (auto& point : object->cloud->points) {
+        point.x += i * 0.37;
+        point.y -= i * 0.19;
+      }
+      ObjectPtr parallel_object(new Object);
+      parallel_object->cloud.reset(new pcl_util::PointCloud(*object->cloud));
+      objects.push_back(object);
+      parallel_objects.push_back(parallel_object);
+    }
+  }
+  ObjectBuilderOptions options;
+  EXPECT_TRUE(min_box_object_builder_->Build(options, &objects));
+
+  FLAGS_min_box_object_builder_thread_num = 4;
+  MinBoxObjectBuilder parallel_builder;
+  EXPECT_TRUE(parallel_builder.Init());
+  EXPECT_TRUE(parallel_builder.Build(options, &parallel_objects));
+  FLAGS_min_box_object_builder_thread_num = 1;
+
+  ASSERT_EQ(objects.size(), parallel_objects.size());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    EXPECT_EQ(objects[i]->id, parallel_objects[i]->id);
+    EXPECT_EQ(objects[i]->length, parallel_objects[i]->length);
+    EXPECT_EQ(objects[i]->width, parallel_objects[i]->width);
+    EXPECT_EQ(objects[i]->height, parallel_objects[i]->height);
+    EXPECT_EQ(objects[i]->center, parallel_objects[i]->center);
+    EXPECT_EQ(objects[i]->direction, parallel_objects[i]->direction);
+    ASSERT_EQ(objects[i]->polygon.points.size(),
+              parallel_objects[i]->polygon.points.size());
+    for (size_t j = 0; j < objects[i]->polygon.points.size(); ++j) {
+      EXPECT_EQ(objects[i]->polygon.points[j].x,
+                parallel_objects[i]->polygon.points[j].x);
+      EXPECT_EQ(objects[i]->polygon.points[j].y,
+                parallel_objects[i]->polygon.points[j].y);
+    }
+  }
+}
+
 }  // namespace perception
 }  // namespace apollo
@@ -17,9 +17,9 @@
 #ifndef MODULES_PERCEPTION_OBSTACLE_TRACKER_HM_TRACKER_FEATURE_DESCRIPTOR_H_
 #define MODULES_PERCEPTION_OBSTACLE_TRACKER_HM_TRACKER_FEATURE_DESCRIPTOR_H_
 
-#include <algorithm>
 #include <vector>
 
+#include "Eigen/Core"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
 
 namespace apollo {
@@ -43,11 +43,14 @@ class FeatureDescriptor {
   void ComputeHistogram(const int bin_size, std::vector<float>* feature);
 
  private:
-  void GetMinMaxCenter();
+  // @brief compute min & max of the first three coordinates of cloud points,
+  // in a single pass over the points
+  // @params[OUT] min_pt: min of points, whose last coefficient is ignored
+  // @params[OUT] max_pt: max of points, whose last coefficient is ignored
+  // @return nothing
+  void GetMinMax(Eigen::Array4f* min_pt, Eigen::Array4f* max_pt) const;
+
   apollo::perception::pcl_util::PointCloudPtr cloud_;
-  pcl_util::Point min_pt_;
-  pcl_util::Point max_pt_;
-  pcl_util::Point center_pt_;
 };  // class FeatureDescriptor
 
 }  // namespace perception
@@ -171,12 +171,8 @@ void HungarianMatcher::ComputeAssociateMatrix(
     const std::vector<TrackedObjectPtr>& new_objects,
     Eigen::MatrixXf* association_mat) {
   // Compute matrix of association distance
-  for (size_t i = 0; i < tracks.size(); ++i) {
-    for (size_t j = 0; j < new_objects.size(); ++j) {
-      (*association_mat)(i, j) = TrackObjectDistance::ComputeDistance(
-          tracks[i], tracks_predict[i], new_objects[j]);
-    }
-  }
+  TrackObjectDistance::ComputeDistances(tracks, tracks_predict, new_objects,
+                                        association_mat);
 }
 
 void HungarianMatcher::ComputeConnectedComponents(
@@ -17,11 +17,28 @@
 #include <algorithm>
 
 #include "modules/common/log.h"
+#include "modules/common/math/matrix_operations.h"
 #include "modules/perception/obstacle/common/geometry_util.h"
 #include "modules/perception/obstacle/lidar/tracker/hm_tracker/kalman_filter.h"
 
 namespace apollo {
 namespace perception {
+namespace {
+
+// Computes the kalman gain p * c^T * s^-1 by solving s * k^T = c * p^T with
+// the Cholesky factor of the innovation covariance s = c * p * c^T + q.
+Eigen::Matrix3d ComputeKalmanGain(const Eigen::Matrix3d& mat_p,
+                                  const Eigen::Matrix3d& mat_c,
+                                  const Eigen::Matrix3d& mat_q) {
+  Eigen::Matrix3d mat_s = mat_c * mat_p * mat_c.transpose() + mat_q;
+  Eigen::Matrix3d mat_kt = mat_c * mat_p.transpose();
+  if (!apollo::common::math::CholeskySolve<double, 3, 3>(mat_s, &mat_kt)) {
+    return mat_p * mat_c.transpose() * mat_s.inverse();
+  }
+  return mat_kt.transpose();
+}
+
+}  // namespace
 
 bool KalmanFilter::s_use_adaptive_ = true;
 double KalmanFilter::s_association_score_maximum_ = 1.0;
@@ -382,9 +399,7 @@ void KalmanFilter::UpdateVelocity(const Eigen::VectorXf& measured_anchor_point,
   // Compute kalman gain
   Eigen::Matrix3d mat_c = Eigen::Matrix3d::Identity();
   Eigen::Matrix3d mat_q = s_measurement_noise_ * Eigen::Matrix3d::Identity();
-  Eigen::Matrix3d mat_k =
-      velocity_covariance_ * mat_c.transpose() *
-      (mat_c * velocity_covariance_ * mat_c.transpose() + mat_q).inverse();
+  Eigen::Matrix3d mat_k = ComputeKalmanGain(velocity_covariance_, mat_c, mat_q);
 
   // Compute posterior belief
   Eigen::Vector3d measured_anchor_point_d =
@@ -413,9 +428,10 @@ void KalmanFilter::UpdateVelocity(const Eigen::VectorXf& measured_anchor_point,
     belief_velocity_ += belief_acceleration_gain_ * time_diff;
   }
 
-  // Compute posterior covariance
-  velocity_covariance_ =
-      (Eigen::Matrix3d::Identity() - mat_k * mat_c) * velocity_covariance_;
+  // Compute posterior covariance in Joseph form, which keeps it symmetric
+  Eigen::Matrix3d mat_ikc = Eigen::Matrix3d::Identity() - mat_k * mat_c;
+  velocity_covariance_ = mat_ikc * velocity_covariance_ * mat_ikc.transpose() +
+                         mat_k * mat_q * mat_k.transpose();
 }
 
 void KalmanFilter::ComputeUpdateQuality(const TrackedObjectPtr& new_object,
@@ -524,9 +540,7 @@ void KalmanFilter::UpdateAcceleration(
   Eigen::Matrix3d mat_c = Eigen::Matrix3d::Identity();
   Eigen::Matrix3d mat_q =
       s_measurement_noise_ * Eigen::Matrix3d::Identity() * 3;
-  Eigen::Matrix3d mat_k =
-      velocity_covariance_ * mat_c.transpose() *
-      (mat_c * velocity_covariance_ * mat_c.transpose() + mat_q).inverse();
+  Eigen::Matrix3d mat_k = ComputeKalmanGain(velocity_covariance_, mat_c, mat_q);
   // Compute posterior belief
   Eigen::Vector3d measured_acceleration_d =
       measured_acceleration.cast<double>();
@@ -94,13 +94,69 @@ float TrackObjectDistance::ComputeDistance(const ObjectTrackPtr& track,
                                            const Eigen::VectorXf& track_predict,
                                            const TrackedObjectPtr& new_object) {
   // Compute distance for given trakc & object
-  float location_distance =
-      ComputeLocationDistance(track, track_predict, new_object);
-  float direction_distance =
-      ComputeDirectionDistance(track, track_predict, new_object);
-  float bbox_size_distance = ComputeBboxSizeDistance(track, new_object);
-  float point_num_distance = ComputePointNumDistance(track, new_object);
-  float histogram_distance = ComputeHistogramDistance(track, new_object);
+  TrackTerms track_terms;
+  GetTrackTerms(track, track_predict, &track_terms);
+  ObjectTerms object_terms;
+  GetObjectTerms(new_object, &object_terms);
+  return ComputeDistance(track_terms, object_terms);
+}
+
+void TrackObjectDistance::ComputeDistances(
+    const std::vector<ObjectTrackPtr>& tracks,
+    const std::vector<Eigen::VectorXf>& tracks_predict,
+    const std::vector<TrackedObjectPtr>& new_objects,
+    Eigen::MatrixXf* distances) {
+  // Compute distances for given tracks & objects in batch
+  int no_track = tracks.size();
+  int no_object = new_objects.size();
+  distances->resize(no_track, no_object);
+  std::vector<ObjectTerms> objects_terms(no_object);
+  for (int j = 0; j < no_object; ++j) {
+    GetObjectTerms(new_objects[j], &objects_terms[j]);
+  }
+  TrackTerms track_terms;
+  for (int i = 0; i < no_track; ++i) {
+    GetTrackTerms(tracks[i], tracks_predict[i], &track_terms);
+    for (int j = 0; j < no_object; ++j) {
+      (*distances)(i, j) = ComputeDistance(track_terms, objects_terms[j]);
+    }
+  }
+}
+
+void TrackObjectDistance::GetTrackTerms(const ObjectTrackPtr& track,
+                                        const Eigen::VectorXf& track_predict,
+                                        TrackTerms* terms) {
+  const TrackedObjectPtr& last_object = track->current_object_;
+  terms->predicted_anchor_point = track_predict.head(2);
+  terms->motion_dir = last_object->velocity.head(2);
+  terms->speed = terms->motion_dir.norm();
+  terms->motion_dir /= terms->speed;
+  terms->anchor_point = last_object->anchor_point;
+  terms->predicted_motion = track_predict.head(6).tail(3);
+  terms->predicted_motion(2) = 0;
+  terms->predicted_motion_is_zero = terms->predicted_motion.head(2).isZero();
+  terms->direction = last_object->direction;
+  terms->size = last_object->size;
+  terms->point_num = last_object->object_ptr->cloud->size();
+  terms->shape_features = &last_object->object_ptr->shape_features;
+}
+
+void TrackObjectDistance::GetObjectTerms(const TrackedObjectPtr& new_object,
+                                         ObjectTerms* terms) {
+  terms->anchor_point = new_object->anchor_point;
+  terms->direction = new_object->direction;
+  terms->size = new_object->size;
+  terms->point_num = new_object->object_ptr->cloud->size();
+  terms->shape_features = &new_object->object_ptr->shape_features;
+}
+
+float TrackObjectDistance::ComputeDistance(const TrackTerms& track,
+                                           const ObjectTerms& object) {
+  float location_distance = ComputeLocationDistance(track, object);
+  float direction_distance = ComputeDirectionDistance(track, object);
+  float bbox_size_distance = ComputeBboxSizeDistance(track, object);
+  float point_num_distance = ComputePointNumDistance(track, object);
+  float histogram_distance = ComputeHistogramDistance(track, object);
 
   float result_distance = s_location_distance_weight_ * location_distance +
                           s_direction_distance_weight_ * direction_distance +
@@ -110,25 +166,20 @@ float TrackObjectDistance::ComputeDistance(const ObjectTrackPtr& track,
   return result_distance;
 }
 
-float TrackObjectDistance::ComputeLocationDistance(
-    const ObjectTrackPtr& track, const Eigen::VectorXf& track_predict,
-    const TrackedObjectPtr& new_object) {
+float TrackObjectDistance::ComputeLocationDistance(const TrackTerms& track,
+                                                   const ObjectTerms& object) {
   // Compute locatin distance for given track & object
   // range from 0 to positive infinity
-  const TrackedObjectPtr& last_object = track->current_object_;
-  Eigen::Vector2f measured_anchor_point = new_object->anchor_point.head(2);
-  Eigen::Vector2f predicted_anchor_point = track_predict.head(2);
+  Eigen::Vector2f measured_anchor_point = object.anchor_point.head(2);
   Eigen::Vector2f measurement_predict_diff =
-      measured_anchor_point - predicted_anchor_point;
+      measured_anchor_point - track.predicted_anchor_point;
   float location_distance = measurement_predict_diff.norm();
 
-  Eigen::Vector2f track_motion_dir = last_object->velocity.head(2);
-  float track_speed = track_motion_dir.norm();
-  track_motion_dir /= track_speed;
+  const Eigen::Vector2f& track_motion_dir = track.motion_dir;
   /* Assume location distance is generated from a normal distribution with
    * symmetric variance. Modify its variance when track speed greater than
    * a threshold. Penalize variance in the orthogonal direction of motion. */
-  if (track_speed > 2) {
+  if (track.speed > 2) {
     Eigen::Vector2f track_motion_orthogonal_dir =
         Eigen::Vector2f(track_motion_dir(1), -track_motion_dir(0));
     float motion_dir_distance =
@@ -144,37 +195,31 @@ float TrackObjectDistance::ComputeLocationDistance(
   return location_distance;
 }
 
-float TrackObjectDistance::ComputeDirectionDistance(
-    const ObjectTrackPtr& track, const Eigen::VectorXf& track_predict,
-    const TrackedObjectPtr& new_object) {
+float TrackObjectDistance::ComputeDirectionDistance(const TrackTerms& track,
+                                                    const ObjectTerms& object) {
   // Compute direction distance for given track & object
   // range from 0 to 2
-  const TrackedObjectPtr& last_object = track->current_object_;
-  Eigen::Vector3f old_anchor_point = last_object->anchor_point;
-  Eigen::Vector3f new_anchor_point = new_object->anchor_point;
-  Eigen::Vector3f anchor_point_shift = new_anchor_point - old_anchor_point;
+  Eigen::Vector3f anchor_point_shift =
+      object.anchor_point - track.anchor_point;
   anchor_point_shift(2) = 0;
-  Eigen::Vector3f predicted_track_motion = track_predict.head(6).tail(3);
-  predicted_track_motion(2) = 0;
 
   double cos_theta = 0.994;  // average cos
   if (!anchor_point_shift.head(2).isZero() &&
-      !predicted_track_motion.head(2).isZero()) {
-    cos_theta = VectorCosTheta2dXy(predicted_track_motion, anchor_point_shift);
+      !track.predicted_motion_is_zero) {
+    cos_theta = VectorCosTheta2dXy(track.predicted_motion, anchor_point_shift);
   }
   float direction_distance = -cos_theta + 1.0;
   return direction_distance;
 }
 
-float TrackObjectDistance::ComputeBboxSizeDistance(
-    const ObjectTrackPtr& track, const TrackedObjectPtr& new_object) {
+float TrackObjectDistance::ComputeBboxSizeDistance(const TrackTerms& track,
+                                                   const ObjectTerms& object) {
   // Compute bbox size distance for given track & object
   // range from 0 to 1
-  const TrackedObjectPtr& last_object = track->current_object_;
-  Eigen::Vector3f old_bbox_dir = last_object->direction;
-  Eigen::Vector3f new_bbox_dir = new_object->direction;
-  Eigen::Vector3f old_bbox_size = last_object->size;
-  Eigen::Vector3f new_bbox_size = new_object->size;
+  const Eigen::Vector3f& old_bbox_dir = track.direction;
+  const Eigen::Vector3f& new_bbox_dir = object.direction;
+  const Eigen::Vector3f& old_bbox_size = track.size;
+  const Eigen::Vector3f& new_bbox_size = object.size;
 
   float size_distance = 0.0;
   double dot_val_00 = fabs(old_bbox_dir(0) * new_bbox_dir(0) +
@@ -199,37 +244,34 @@ float TrackObjectDistance::ComputeBboxSizeDistance(
   return size_distance;
 }
 
-float TrackObjectDistance::ComputePointNumDistance(
-    const ObjectTrackPtr& track, const TrackedObjectPtr& new_object) {
+float TrackObjectDistance::ComputePointNumDistance(const TrackTerms& track,
+                                                   const ObjectTerms& object) {
   // Compute point num distance for given track & object
   // range from 0 and 1
-  const TrackedObjectPtr& last_object = track->current_object_;
-  int old_point_number = last_object->object_ptr->cloud->size();
-  int new_point_number = new_object->object_ptr->cloud->size();
+  int old_point_number = track.point_num;
+  int new_point_number = object.point_num;
   float point_num_distance = fabs(old_point_number - new_point_number) * 1.0f /
                              std::max(old_point_number, new_point_number);
   return point_num_distance;
 }
 
-float TrackObjectDistance::ComputeHistogramDistance(
-    const ObjectTrackPtr& track, const TrackedObjectPtr& new_object) {
+float TrackObjectDistance::ComputeHistogramDistance(const TrackTerms& track,
+                                                    const ObjectTerms& object) {
   // Compute histogram distance for given track & object
   // range from 0 to 3
-  const TrackedObjectPtr& last_object = track->current_object_;
-  std::vector<float>& old_object_shape_features =
-      last_object->object_ptr->shape_features;
-  std::vector<float>& new_object_shape_features =
-      new_object->object_ptr->shape_features;
+  const std::vector<float>& old_object_shape_features = *track.shape_features;
+  const std::vector<float>& new_object_shape_features = *object.shape_features;
   if (old_object_shape_features.size() != new_object_shape_features.size()) {
     AERROR << "sizes of compared features not matched. TrackObjectDistance";
     return FLT_MAX;
   }
 
-  float histogram_distance = 0.0;
-  for (size_t i = 0; i < old_object_shape_features.size(); ++i) {
-    histogram_distance +=
-        std::fabs(old_object_shape_features[i] - new_object_shape_features[i]);
-  }
+  // sum of absolute differences, in packets of features
+  Eigen::Map<const Eigen::ArrayXf> old_features(
+      old_object_shape_features.data(), old_object_shape_features.size());
+  Eigen::Map<const Eigen::ArrayXf> new_features(
+      new_object_shape_features.data(), new_object_shape_features.size());
+  float histogram_distance = (old_features - new_features).abs().sum();
   return histogram_distance;
 }
 
@@ -18,6 +18,7 @@
 #define MODULES_PERCEPTION_OBSTACLE_TRACK_OBJECT_DISTANCE_H_
 
 #include <string>
+#include <vector>
 
 #include "Eigen/Core"
 #include "modules/common/macro.h"
@@ -70,49 +71,106 @@ class TrackObjectDistance {
                                const Eigen::VectorXf& track_predict,
                                const TrackedObjectPtr& new_object);
 
+  // @brief compute distances for all the given tracks & objects in batch,
+  // with the same results as ComputeDistance. Terms of each track and each
+  // object are gathered once, instead of once per <track, object> pair
+  // @params[IN] tracks: tracks for <track, object> distance computing
+  // @params[IN] tracks_predict: predicted states of given tracks
+  // @params[IN] new_objects: recently detected objects
+  // @params[OUT] distances: <track, object> distances, whose rows are tracks
+  // and whose cols are objects
+  // @return nothing
+  static void ComputeDistances(
+      const std::vector<ObjectTrackPtr>& tracks,
+      const std::vector<Eigen::VectorXf>& tracks_predict,
+      const std::vector<TrackedObjectPtr>& new_objects,
+      Eigen::MatrixXf* distances);
+
   std::string Name() const {
     return "TrackObjectDistance";
   }
 
  private:
-  // @brief compute location distance for given track & object
+  // terms of a track shared by all of its <track, object> distances
+  struct TrackTerms {
+    Eigen::Vector2f predicted_anchor_point;
+    Eigen::Vector2f motion_dir;
+    float speed;
+    Eigen::Vector3f anchor_point;
+    Eigen::Vector3f predicted_motion;
+    bool predicted_motion_is_zero;
+    Eigen::Vector3f direction;
+    Eigen::Vector3f size;
+    int point_num;
+    const std::vector<float>* shape_features;
+  };
+
+  // terms of an object shared by all of its <track, object> distances
+  struct ObjectTerms {
+    Eigen::Vector3f anchor_point;
+    Eigen::Vector3f direction;
+    Eigen::Vector3f size;
+    int point_num;
+    const std::vector<float>* shape_features;
+  };
+
+  // @brief gather distance terms of given track
   // @params[IN] track: track for <track, object> distance computing
   // @params[IN] track_predict: predicted state of given track
+  // @params[OUT] terms: distance terms of given track
+  // @return nothing
+  static void GetTrackTerms(const ObjectTrackPtr& track,
+                            const Eigen::VectorXf& track_predict,
+                            TrackTerms* terms);
+
+  // @brief gather distance terms of given object
   // @params[IN] new_object: recently detected object
+  // @params[OUT] terms: distance terms of given object
+  // @return nothing
+  static void GetObjectTerms(const TrackedObjectPtr& new_object,
+                             ObjectTerms* terms);
+
+  // @brief compute distance for given track & object terms
+  // @params[IN] track: terms of track for <track, object> distance computing
+  // @params[IN] object: terms of recently detected object
+  // @return computed <track, object> distance
+  static float ComputeDistance(const TrackTerms& track,
+                               const ObjectTerms& object);
+
+  // @brief compute location distance for given track & object
+  // @params[IN] track: terms of track for <track, object> distance computing
+  // @params[IN] object: terms of recently detected object
   // @return location distacne of given <track, object>
-  static float ComputeLocationDistance(const ObjectTrackPtr& track,
-                                       const Eigen::VectorXf& track_predict,
-                                       const TrackedObjectPtr& new_object);
+  static float ComputeLocationDistance(const TrackTerms& track,
+                                       const ObjectTerms& object);
 
   // @brief compute direction distance for given track & object
-  // @params[IN] track: track for <track, object> distance computing
-  // @params[IN] track_predict: predicted state of given track
-  // @params[IN] new_object: recently detected object
+  // @params[IN] track: terms of track for <track, object> distance computing
+  // @params[IN] object: terms of recently detected object
   // @return direction distance of given <track, object>
-  static float ComputeDirectionDistance(const ObjectTrackPtr& track,
-                                        const Eigen::VectorXf& track_predict,
-                                        const TrackedObjectPtr& new_object);
+  static float ComputeDirectionDistance(const TrackTerms& track,
+                                        const ObjectTerms& object);
 
   // @brief compute bbox size distance for given track & object
-  // @params[IN] track: track for <track, object> distance computing
-  // @params[IN] new_object: recently detected object
+  // @params[IN] track: terms of track for <track, object> distance computing
+  // @params[IN] object: terms of recently detected object
   // @return bbox size distance of given <track, object>
-  static float ComputeBboxSizeDistance(const ObjectTrackPtr& track,
-                                       const TrackedObjectPtr& new_object);
+  static float ComputeBboxSizeDistance(const TrackTerms& track,
+                                       const ObjectTerms& object);
 
   // @brief compute point num distance for given track & object
-  // @params[IN] track: track for <track, object> distance computing
-  // @params[IN] new_object: recently detected object
+  // @params[IN] track: terms of track for <track, object> distance computing
+  // @params[IN] object: terms of recently detected object
   // @return point num distance of given <track, object>
-  static float ComputePointNumDistance(const ObjectTrackPtr& track,
-                                       const TrackedObjectPtr& new_object);
+  static float ComputePointNumDistance(const TrackTerms& track,
+                                       const ObjectTerms& object);
 
   // @brief compute histogram distance for given track & object
-  // @params[IN] track: track for <track, object> distance computing
-  // @params[IN] new_object: recently detected object
+  // @params[IN] track: terms of track for <track, object> distance computing
+  // @params[IN] object: terms of recently detected object
   // @return histogram distance of given <track, object>
-  static float ComputeHistogramDistance(const ObjectTrackPtr& track,
-                                        const TrackedObjectPtr& new_object);
+  static float ComputeHistogramDistance(const TrackTerms& track,
+                                        const ObjectTerms& object);
 
  protected:
   // distance weights
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/obstacle/common/file_system_util.h"
+#include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
+#include "modules/perception/obstacle/lidar/tracker/hm_tracker/feature_descriptor.h"
+#include "modules/perception/obstacle/lidar/tracker/hm_tracker/track_object_distance.h"
+
+namespace apollo {
+namespace perception {
+namespace {
+
+const char kDataPath[] = "modules/perception/data/hm_tracker_test/";
+
+void ReadObjects(const std::string& filename,
+                 std::vector<ObjectPtr>* objects) {
+  std::ifstream ifs(filename);
+  std::string type;
+  int no_point = 0;
+  float tmp = 0;
+  while (ifs >> type) {
+    ifs >> tmp >> tmp >> tmp >> no_point;
+    ObjectPtr obj(new Object());
+    obj->cloud->resize(no_point);
+    for (int j = 0; j < no_point; ++j) {
+      ifs >> obj->cloud->points[j].x >> obj->cloud->points[j].y >>
+          obj->cloud->points[j].z >> obj->cloud->points[j].intensity;
+    }
+    objects->push_back(obj);
+  }
+}
+
+// Segments of all the recorded frames of the hm tracker test, built into
+// objects as one dense scene.
+const std::vector<ObjectPtr>& RecordedObjects() {
+  static std::vector<ObjectPtr> objects;
+  if (objects.empty()) {
+    std::vector<std::string> seg_filenames;
+    GetFileNamesInFolderById(kDataPath, ".seg", &seg_filenames);
+    for (const auto& seg_filename : seg_filenames) {
+      ReadObjects(kDataPath + seg_filename, &objects);
+    }
+    MinBoxObjectBuilder object_builder;
+    object_builder.Init();
+    ObjectBuilderOptions object_builder_options;
+    object_builder_options.ref_center = Eigen::Vector3d(0, 0, -1.7);
+    object_builder.Build(object_builder_options, &objects);
+  }
+  return objects;
+}
+
+std::vector<TrackedObjectPtr> TrackedObjects() {
+  std::vector<TrackedObjectPtr> tracked_objects;
+  for (const auto& object : RecordedObjects()) {
+    TrackedObjectPtr tracked_object(new TrackedObject(object));
+    FeatureDescriptor fd(object->cloud);
+    fd.ComputeHistogram(10, &object->shape_features);
+    tracked_objects.push_back(tracked_object);
+  }
+  return tracked_objects;
+}
+
+// Tracks of all the objects, moving at a few m/s, with predicted states.
+std::vector<ObjectTrackPtr> ObjectTracks(
+    const std::vector<TrackedObjectPtr>& tracked_objects,
+    std::vector<Eigen::VectorXf>* tracks_predict) {
+  std::vector<ObjectTrackPtr> tracks;
+  tracks_predict->clear();
+  for (size_t i = 0; i < tracked_objects.size(); ++i) {
+    TrackedObjectPtr last_object(new TrackedObject());
+    last_object->clone(*tracked_objects[i]);
+    last_object->velocity = Eigen::Vector3f(i % 7, i % 5 - 2.0f, 0.0f);
+    tracks.push_back(new ObjectTrack(last_object));
+    Eigen::VectorXf track_predict(6);
+    track_predict.head(3) =
+        last_object->anchor_point + last_object->velocity * 0.1f;
+    track_predict.tail(3) = last_object->velocity;
+    tracks_predict->push_back(track_predict);
+  }
+  return tracks;
+}
+
+void BM_ComputeHistogram(benchmark::State& state) {
+  const std::vector<ObjectPtr>& objects = RecordedObjects();
+  if (objects.empty()) {
+    state.SkipWithError("failed to read recorded objects");
+    return;
+  }
+  int no_point = 0;
+  for (const auto& object : objects) {
+    no_point += object->cloud->points.size();
+  }
+  while (state.KeepRunning()) {
+    for (const auto& object : objects) {
+      FeatureDescriptor fd(object->cloud);
+      fd.ComputeHistogram(10, &object->shape_features);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * no_point);
+}
+BENCHMARK(BM_ComputeHistogram);
+
+void BM_ComputeDistance(benchmark::State& state) {
+  const std::vector<TrackedObjectPtr> new_objects = TrackedObjects();
+  if (new_objects.empty()) {
+    state.SkipWithError("failed to read recorded objects");
+    return;
+  }
+  std::vector<Eigen::VectorXf> tracks_predict;
+  std::vector<ObjectTrackPtr> tracks =
+      ObjectTracks(new_objects, &tracks_predict);
+  Eigen::MatrixXf distances(tracks.size(), new_objects.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < tracks.size(); ++i) {
+      for (size_t j = 0; j < new_objects.size(); ++j) {
+        distances(i, j) = TrackObjectDistance::ComputeDistance(
+            tracks[i], tracks_predict[i], new_objects[j]);
+      }
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(state.iterations() * distances.size());
+  for (auto& track : tracks) {
+    delete track;
+  }
+}
+BENCHMARK(BM_ComputeDistance);
+
+void BM_ComputeDistances(benchmark::State& state) {
+  const std::vector<TrackedObjectPtr> new_objects = TrackedObjects();
+  if (new_objects.empty()) {
+    state.SkipWithError("failed to read recorded objects");
+    return;
+  }
+  std::vector<Eigen::VectorXf> tracks_predict;
+  std::vector<ObjectTrackPtr> tracks =
+      ObjectTracks(new_objects, &tracks_predict);
+  Eigen::MatrixXf distances;
+  while (state.KeepRunning()) {
+    TrackObjectDistance::ComputeDistances(tracks, tracks_predict, new_objects,
+                                          &distances);
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(state.iterations() * distances.size());
+  for (auto& track : tracks) {
+    delete track;
+  }
+}
+BENCHMARK(BM_ComputeDistances);
+
+}  // namespace
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/tracker/hm_tracker/track_object_distance.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/obstacle/common/geometry_util.h"
+#include "modules/perception/obstacle/lidar/tracker/hm_tracker/feature_descriptor.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+// The scalar histogram that FeatureDescriptor::ComputeHistogram computed
+// before it was vectorized, as a reference.
+std::vector<float> ReferenceHistogram(const pcl_util::PointCloudPtr& cloud,
+                                      const int bin_size) {
+  pcl_util::Point min_pt;
+  pcl_util::Point max_pt;
+  min_pt.x = min_pt.y = min_pt.z = FLT_MAX;
+  max_pt.x = max_pt.y = max_pt.z = -FLT_MAX;
+  for (const auto& pt : cloud->points) {
+    min_pt.x = std::min(min_pt.x, pt.x);
+    max_pt.x = std::max(max_pt.x, pt.x);
+    min_pt.y = std::min(min_pt.y, pt.y);
+    max_pt.y = std::max(max_pt.y, pt.y);
+    min_pt.z = std::min(min_pt.z, pt.z);
+    max_pt.z = std::max(max_pt.z, pt.z);
+  }
+  std::vector<int> stat_feat(bin_size * 3, 0);
+  float xsize = (max_pt.x - min_pt.x) / bin_size + 0.000001;
+  float ysize = (max_pt.y - min_pt.y) / bin_size + 0.000001;
+  float zsize = (max_pt.z - min_pt.z) / bin_size + 0.000001;
+  const int pt_num = cloud->points.size();
+  for (const auto& pt : cloud->points) {
+    stat_feat[static_cast<int>((pt.x - min_pt.x) / xsize)]++;
+    stat_feat[static_cast<int>(bin_size + (pt.y - min_pt.y) / ysize)]++;
+    stat_feat[static_cast<int>(bin_size * 2 + (pt.z - min_pt.z) / zsize)]++;
+  }
+  std::vector<float> feature(stat_feat.size());
+  for (size_t i = 0; i < stat_feat.size(); ++i) {
+    feature[i] = static_cast<float>(stat_feat[i]) / static_cast<float>(pt_num);
+  }
+  return feature;
+}
+
+// The pairwise distance that TrackObjectDistance::ComputeDistance computed
+// before the distances were batched, with the default weights, as a
+// reference.
+float ReferenceDistance(const ObjectTrackPtr& track,
+                        const Eigen::VectorXf& track_predict,
+                        const TrackedObjectPtr& new_object) {
+  const TrackedObjectPtr& last_object = track->current_object_;
+
+  // location distance
+  Eigen::Vector2f measurement_predict_diff =
+      new_object->anchor_point.head(2) - track_predict.head(2);
+  float location_distance = measurement_predict_diff.norm();
+  Eigen::Vector2f track_motion_dir = last_object->velocity.head(2);
+  float track_speed = track_motion_dir.norm();
+  track_motion_dir /= track_speed;
+  if (track_speed > 2) {
+    Eigen::Vector2f track_motion_orthogonal_dir =
+        Eigen::Vector2f(track_motion_dir(1), -track_motion_dir(0));
+    float motion_dir_distance =
+        track_motion_dir(0) * measurement_predict_diff(0) +
+        track_motion_dir(1) * measurement_predict_diff(1);
+    float motion_orthogonal_dir_distance =
+        track_motion_orthogonal_dir(0) * measurement_predict_diff(0) +
+        track_motion_orthogonal_dir(1) * measurement_predict_diff(1);
+    location_distance = sqrt(motion_dir_distance * motion_dir_distance * 0.25 +
+                             motion_orthogonal_dir_distance *
+                                 motion_orthogonal_dir_distance * 4);
+  }
+
+  // direction distance
+  Eigen::Vector3f anchor_point_shift =
+      new_object->anchor_point - last_object->anchor_point;
+  anchor_point_shift(2) = 0;
+  Eigen::Vector3f predicted_track_motion = track_predict.head(6).tail(3);
+  predicted_track_motion(2) = 0;
+  double cos_theta = 0.994;
+  if (!anchor_point_shift.head(2).isZero() &&
+      !predicted_track_motion.head(2).isZero()) {
+    cos_theta = VectorCosTheta2dXy(predicted_track_motion, anchor_point_shift);
+  }
+  float direction_distance = -cos_theta + 1.0;
+
+  // bbox size distance
+  const Eigen::Vector3f& old_bbox_dir = last_object->direction;
+  const Eigen::Vector3f& new_bbox_dir = new_object->direction;
+  const Eigen::Vector3f& old_bbox_size = last_object->size;
+  const Eigen::Vector3f& new_bbox_size = new_object->size;
+  double dot_val_00 = fabs(old_bbox_dir(0) * new_bbox_dir(0) +
+                           old_bbox_dir(1) * new_bbox_dir(1));
+  double dot_val_01 = fabs(old_bbox_dir(0) * new_bbox_dir(1) -
+                           old_bbox_dir(1) * new_bbox_dir(0));
+  float bbox_size_distance = 0.0;
+  if (dot_val_00 > dot_val_01) {
+    float diff_1 = fabs(old_bbox_size(0) - new_bbox_size(0)) /
+                   std::max(old_bbox_size(0), new_bbox_size(0));
+    float diff_2 = fabs(old_bbox_size(1) - new_bbox_size(1)) /
+                   std::max(old_bbox_size(1), new_bbox_size(1));
+    bbox_size_distance = std::min(diff_1, diff_2);
+  } else {
+    float diff_1 = fabs(old_bbox_size(0) - new_bbox_size(1)) /
+                   std::max(old_bbox_size(0), new_bbox_size(1));
+    float diff_2 = fabs(old_bbox_size(1) - new_bbox_size(0)) /
+                   std::max(old_bbox_size(1), new_bbox_size(0));
+    bbox_size_distance = std::min(diff_1, diff_2);
+  }
+
+  // point num distance
+  int old_point_number = last_object->object_ptr->cloud->size();
+  int new_point_number = new_object->object_ptr->cloud->size();
+  float point_num_distance = fabs(old_point_number - new_point_number) * 1.0f /
+                             std::max(old_point_number, new_point_number);
+
+  // histogram distance
+  const std::vector<float>& old_features =
+      last_object->object_ptr->shape_features;
+  const std::vector<float>& new_features =
+      new_object->object_ptr->shape_features;
+  float histogram_distance = 0.0;
+  if (old_features.size() != new_features.size()) {
+    histogram_distance = FLT_MAX;
+  } else {
+    for (size_t i = 0; i < old_features.size(); ++i) {
+      histogram_distance += std::fabs(old_features[i] - new_features[i]);
+    }
+  }
+
+  return 0.6 * location_distance + 0.2 * direction_distance +
+         0.1 * bbox_size_distance + 0.1 * point_num_distance +
+         0.5 * histogram_distance;
+}
+
+TrackedObjectPtr RandomObject(std::mt19937* engine) {
+  std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+  std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+  std::uniform_real_distribution<float> heading(-M_PI, M_PI);
+  std::uniform_int_distribution<int> point_num(1, 200);
+  ObjectPtr obj(new Object());
+  const float x = position(*engine);
+  const float y = position(*engine);
+  obj->cloud->resize(point_num(*engine));
+  for (auto& pt : obj->cloud->points) {
+    pt.x = x + offset(*engine);
+    pt.y = y + offset(*engine);
+    pt.z = offset(*engine);
+  }
+  FeatureDescriptor fd(obj->cloud);
+  fd.ComputeHistogram(10, &obj->shape_features);
+
+  TrackedObjectPtr tracked_obj(new TrackedObject());
+  tracked_obj->object_ptr = obj;
+  tracked_obj->anchor_point = Eigen::Vector3f(x, y, 0.0f);
+  const float theta = heading(*engine);
+  tracked_obj->direction =
+      Eigen::Vector3f(std::cos(theta), std::sin(theta), 0.0f);
+  tracked_obj->size = Eigen::Vector3f(1.0f + offset(*engine) * offset(*engine),
+                                      1.0f + offset(*engine) * offset(*engine),
+                                      1.5f);
+  tracked_obj->velocity =
+      Eigen::Vector3f(offset(*engine), offset(*engine), 0.0f) * 2.0f;
+  return tracked_obj;
+}
+
+}  // namespace
+
+TEST(TrackObjectDistanceTest, ComputeDistances) {
+  std::mt19937 engine(0);
+  std::vector<ObjectTrackPtr> tracks;
+  std::vector<Eigen::VectorXf> tracks_predict;
+  for (int i = 0; i < 50; ++i) {
+    tracks.push_back(new ObjectTrack(RandomObject(&engine)));
+    Eigen::VectorXf predict(6);
+    const TrackedObjectPtr& obj = tracks.back()->current_object_;
+    predict.head(3) = obj->anchor_point + obj->velocity * 0.1f;
+    predict.tail(3) = obj->velocity;
+    // static tracks
+    if (i % 5 == 0) {
+      predict.tail(3).setZero();
+    }
+    tracks_predict.push_back(predict);
+  }
+  std::vector<TrackedObjectPtr> new_objects;
+  for (int i = 0; i < 60; ++i) {
+    new_objects.push_back(RandomObject(&engine));
+  }
+  // objects at the anchor points of tracks
+  new_objects[0]->anchor_point = tracks[0]->current_object_->anchor_point;
+  new_objects[1]->anchor_point = tracks[1]->current_object_->anchor_point;
+  // features of different sizes
+  new_objects[2]->object_ptr->shape_features.resize(3);
+
+  Eigen::MatrixXf distances;
+  TrackObjectDistance::ComputeDistances(tracks, tracks_predict, new_objects,
+                                        &distances);
+  ASSERT_EQ(tracks.size(), distances.rows());
+  ASSERT_EQ(new_objects.size(), distances.cols());
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    for (size_t j = 0; j < new_objects.size(); ++j) {
+      EXPECT_EQ(TrackObjectDistance::ComputeDistance(
+                    tracks[i], tracks_predict[i], new_objects[j]),
+                distances(i, j));
+      // The histogram distance is summed in a different order.
+      const float expected =
+          ReferenceDistance(tracks[i], tracks_predict[i], new_objects[j]);
+      EXPECT_NEAR(expected, distances(i, j),
+                  1e-5 * std::max(1.0f, std::fabs(expected)))
+          << i << ", " << j;
+    }
+  }
+  for (auto& track : tracks) {
+    delete track;
+  }
+}
+
+TEST(FeatureDescriptorTest, ComputeHistogram) {
+  pcl_util::PointCloudPtr cloud(new pcl_util::PointCloud());
+  cloud->resize(2);
+  cloud->points[0].x = 0.0f;
+  cloud->points[0].y = 0.0f;
+  cloud->points[0].z = 0.0f;
+  cloud->points[1].x = 1.0f;
+  cloud->points[1].y = 2.0f;
+  cloud->points[1].z = 3.0f;
+  std::vector<float> feature;
+  FeatureDescriptor(cloud).ComputeHistogram(2, &feature);
+  EXPECT_EQ(std::vector<float>({0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f}),
+            feature);
+
+  // A single point, and clouds of odd and even sizes.
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> coordinate(-5.0f, 5.0f);
+  for (int point_num = 1; point_num <= 40; ++point_num) {
+    cloud->resize(point_num);
+    for (auto& pt : cloud->points) {
+      pt.x = coordinate(engine);
+      pt.y = coordinate(engine);
+      pt.z = coordinate(engine);
+    }
+    // Flat clouds, of no extent along z.
+    if (point_num % 3 == 0) {
+      for (auto& pt : cloud->points) {
+        pt.z = 1.0f;
+      }
+    }
+    for (const int bin_size : {1, 7, 10}) {
+      FeatureDescriptor(cloud).ComputeHistogram(bin_size, &feature);
+      EXPECT_EQ(ReferenceHistogram(cloud, bin_size), feature)
+          << point_num << " points, " << bin_size << " bins";
+    }
+  }
+}
+
+TEST(TrackObjectDistanceTest, ComputeDistancesEmpty) {
+  std::mt19937 engine(0);
+  std::vector<ObjectTrackPtr> tracks;
+  std::vector<Eigen::VectorXf> tracks_predict;
+  std::vector<TrackedObjectPtr> new_objects = {RandomObject(&engine)};
+  Eigen::MatrixXf distances;
+  TrackObjectDistance::ComputeDistances(tracks, tracks_predict, new_objects,
+                                        &distances);
+  EXPECT_EQ(0, distances.rows());
+  EXPECT_EQ(1, distances.cols());
+}
+
+}  // namespace perception
+}  // namespace apollo
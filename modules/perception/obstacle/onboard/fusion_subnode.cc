@@ -19,6 +19,7 @@
 #include <map>
 
 #include "modules/common/log.h"
+#include "modules/common/time/time.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/onboard/event_manager.h"
 #include "modules/perception/onboard/shared_data_manager.h"
@@ -126,6 +127,14 @@ Status FusionSubnode::ProcEvents() {
     }
     AINFO << "Publish 3d perception fused msg. timestamp:"
           << GLOG_TIMESTAMP(timestamp_) << " obj_cnt:" << objects_.size();
+
+    const double end_timestamp = common::time::Clock::NowInSeconds();
+    const double end_latency = (end_timestamp - timestamp_) * 1e3;
+    AINFO << "FRAME_STATISTICS:Fusion:End:msg_time["
+          << GLOG_TIMESTAMP(timestamp_) << "]:cur_time["
+          << GLOG_TIMESTAMP(end_timestamp) << "]:cur_latency[" << end_latency
+          << "]:lidar_age[" << GetSensorDataAge(VELODYNE_64)
+          << "]:radar_age[" << GetSensorDataAge(RADAR) << "]";
   }
   return Status::OK();
 }
@@ -226,7 +235,9 @@ bool FusionSubnode::GeneratePbMsg(PerceptionObstacles *obstacles) {
   common::Header *header = obstacles->mutable_header();
   header->set_lidar_timestamp(timestamp_ * 1e9);  // in ns
   header->set_camera_timestamp(0);
-  header->set_radar_timestamp(0);
+  double radar_timestamp = 0.0;
+  fusion_->GetFusedSensorTimestamp(GetSensorType(RADAR), &radar_timestamp);
+  header->set_radar_timestamp(radar_timestamp * 1e9);  // in ns
 
   obstacles->set_error_code(error_code_);
 
@@ -239,6 +250,15 @@ bool FusionSubnode::GeneratePbMsg(PerceptionObstacles *obstacles) {
   return true;
 }
 
+double FusionSubnode::GetSensorDataAge(const SensorType sensor_type) {
+  double sensor_timestamp = 0.0;
+  if (!fusion_->GetFusedSensorTimestamp(GetSensorType(sensor_type),
+                                        &sensor_timestamp)) {
+    return -1.0;
+  }
+  return (timestamp_ - sensor_timestamp) * 1e3;
+}
+
 void FusionSubnode::RegistAllAlgorithm() {
   RegisterFactoryProbabilisticFusion();
 }
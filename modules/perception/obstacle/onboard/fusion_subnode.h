@@ -62,6 +62,9 @@ class FusionSubnode : public Subnode {
                      std::shared_ptr<SensorObjects> *sensor_objects) const;
   apollo::common::Status Process(const EventMeta &event_meta,
                                  const std::vector<Event> &events);
+  // @brief: age in ms of the latest fused data of a sensor at the fusion
+  // time, or -1 if none of its data has been fused
+  double GetSensorDataAge(const SensorType sensor_type);
   void RegistAllAlgorithm();
 
   double timestamp_;
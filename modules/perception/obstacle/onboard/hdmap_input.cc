@@ -37,7 +37,9 @@ using apollo::hdmap::LineSegment;
 using apollo::hdmap::BoundaryEdge;
 using apollo::hdmap::RoadROIBoundaryPtr;
 using apollo::hdmap::JunctionInfoConstPtr;
+using apollo::hdmap::JunctionBoundary;
 using apollo::hdmap::JunctionBoundaryPtr;
+using apollo::hdmap::RoadROIBoundary;
 using apollo::hdmap::BoundaryEdge_Type_LEFT_BOUNDARY;
 using apollo::hdmap::BoundaryEdge_Type_RIGHT_BOUNDARY;
 using apollo::hdmap::HDMapUtil;
@@ -49,6 +51,33 @@ using std::vector;
 
 constexpr double kRadianToDegree = 180.0 / M_PI;
 
+// The cache is trimmed when it holds this many times the visible elements.
+constexpr size_t kMaxCacheRatio = 4;
+
+namespace {
+
+// Roads are returned once per section, which has no id, so sections of a road
+// are told apart by the first point of their boundaries.
+string RoadBoundaryKey(const RoadROIBoundary& boundary) {
+  string key = boundary.id().id();
+  for (const auto& road_boundary : boundary.road_boundaries()) {
+    for (const BoundaryEdge& edge : road_boundary.outer_polygon().edge()) {
+      for (const auto& segment : edge.curve().segment()) {
+        if (segment.has_line_segment() &&
+            segment.line_segment().point_size() > 0) {
+          const auto& point = segment.line_segment().point(0);
+          key += "@" + std::to_string(point.x()) + "," +
+                 std::to_string(point.y());
+          return key;
+        }
+      }
+    }
+  }
+  return key;
+}
+
+}  // namespace
+
 // HDMapInput
 HDMapInput::HDMapInput() {}
 
@@ -63,6 +92,11 @@ bool HDMapInput::GetROI(const PointD& pointd, const double& map_radius,
     return false;
   }
   std::unique_lock<std::mutex> lock(mutex_);
+  if (hdmap != cached_hdmap_) {
+    road_cache_.clear();
+    junction_cache_.clear();
+    cached_hdmap_ = hdmap;
+  }
   if (mapptr != NULL && *mapptr == nullptr) {
     (*mapptr).reset(new HdmapStruct);
   }
@@ -122,47 +156,89 @@ Status HDMapInput::MergeBoundaryJunction(
     return Status(ErrorCode::PERCEPTION_ERROR,
                   "HdmapStructPtr mapptr is null.");
   }
+  ++num_queries_;
   (*mapptr)->road_boundary.resize(boundaries.size());
   (*mapptr)->junction.resize(junctions.size());
 
   for (size_t i = 0; i < boundaries.size(); i++) {
-    for (const auto& road_boundary : boundaries[i]->road_boundaries()) {
-      auto& mapped_boundary = (*mapptr)->road_boundary[i];
-      for (const BoundaryEdge& edge : road_boundary.outer_polygon().edge()) {
-        PolygonDType* edge_side = nullptr;
-        if (edge.type() == BoundaryEdge::LEFT_BOUNDARY) {
-          edge_side = &mapped_boundary.left_boundary;
-        } else if (edge.type() == BoundaryEdge::RIGHT_BOUNDARY) {
-          edge_side = &mapped_boundary.right_boundary;
-        } else {
-          continue;
-        }
-        for (const auto& segment : edge.curve().segment()) {
-          if (segment.has_line_segment()) {
-            DownSampleBoundary(segment.line_segment(), edge_side);
-          }
-        }
-      }
+    auto cached = road_cache_.emplace(RoadBoundaryKey(*boundaries[i]),
+                                      CachedRoad());
+    if (cached.second) {
+      ConvertRoadBoundary(*boundaries[i], &cached.first->second.boundary);
     }
+    cached.first->second.last_query = num_queries_;
+    (*mapptr)->road_boundary[i] = cached.first->second.boundary;
   }
 
   for (size_t i = 0; i < junctions.size(); i++) {
-    const Polygon2d& polygon = junctions[i]->junction_info->polygon();
-    const vector<Vec2d>& points = polygon.points();
-    auto& junction = (*mapptr)->junction[i];
-    junction.reserve(points.size());
-    for (const auto& point : points) {
-      PointD pointd;
-      pointd.x = point.x();
-      pointd.y = point.y();
-      pointd.z = 0.0;
-      junction.push_back(pointd);
+    auto cached = junction_cache_.emplace(
+        junctions[i]->junction_info->id().id(), CachedJunction());
+    if (cached.second) {
+      ConvertJunction(*junctions[i], &cached.first->second.polygon);
     }
+    cached.first->second.last_query = num_queries_;
+    (*mapptr)->junction[i] = cached.first->second.polygon;
   }
 
+  if (road_cache_.size() > kMaxCacheRatio * boundaries.size() ||
+      junction_cache_.size() > kMaxCacheRatio * junctions.size()) {
+    TrimCache();
+  }
   return Status::OK();
 }
 
+void HDMapInput::ConvertRoadBoundary(const RoadROIBoundary& boundary,
+                                     RoadBoundary* road_boundary) const {
+  for (const auto& section_boundary : boundary.road_boundaries()) {
+    for (const BoundaryEdge& edge : section_boundary.outer_polygon().edge()) {
+      PolygonDType* edge_side = nullptr;
+      if (edge.type() == BoundaryEdge::LEFT_BOUNDARY) {
+        edge_side = &road_boundary->left_boundary;
+      } else if (edge.type() == BoundaryEdge::RIGHT_BOUNDARY) {
+        edge_side = &road_boundary->right_boundary;
+      } else {
+        continue;
+      }
+      for (const auto& segment : edge.curve().segment()) {
+        if (segment.has_line_segment()) {
+          DownSampleBoundary(segment.line_segment(), edge_side);
+        }
+      }
+    }
+  }
+}
+
+void HDMapInput::ConvertJunction(const JunctionBoundary& junction,
+                                 PolygonDType* polygon) const {
+  const Polygon2d& junction_polygon = junction.junction_info->polygon();
+  const vector<Vec2d>& points = junction_polygon.points();
+  polygon->reserve(points.size());
+  for (const auto& point : points) {
+    PointD pointd;
+    pointd.x = point.x();
+    pointd.y = point.y();
+    pointd.z = 0.0;
+    polygon->push_back(pointd);
+  }
+}
+
+void HDMapInput::TrimCache() {
+  for (auto it = road_cache_.begin(); it != road_cache_.end();) {
+    if (it->second.last_query != num_queries_) {
+      it = road_cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = junction_cache_.begin(); it != junction_cache_.end();) {
+    if (it->second.last_query != num_queries_) {
+      it = junction_cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void HDMapInput::DownSampleBoundary(const hdmap::LineSegment& line,
                                     PolygonDType* out_boundary_line) const {
   PointDCloudPtr raw_cloud(new PointDCloud);
@@ -17,9 +17,11 @@
 #ifndef MODULES_PERCEPTION_ONBOARD_HDMAP_INPUT_H_
 #define MODULES_PERCEPTION_ONBOARD_HDMAP_INPUT_H_
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "gtest/gtest_prod.h"
@@ -57,10 +59,39 @@ class HDMapInput {
       const std::vector<hdmap::JunctionBoundaryPtr>& junctions,
       HdmapStructPtr* mapptr);
 
+  // @brief: convert and downsample the boundaries of a road
+  void ConvertRoadBoundary(const hdmap::RoadROIBoundary& boundary,
+                           RoadBoundary* road_boundary) const;
+
+  // @brief: convert the polygon of a junction
+  void ConvertJunction(const hdmap::JunctionBoundary& junction,
+                       PolygonDType* polygon) const;
+
+  // @brief: drop the cached elements which are not visible any more
+  void TrimCache();
+
   std::mutex mutex_;  // multi-thread init safe.
 
+  // Converted roads and junctions of the map, keyed by their ids, so that
+  // GetROI only converts the newly visible ones. last_query is the query
+  // which last returned an element.
+  struct CachedRoad {
+    RoadBoundary boundary;
+    uint64_t last_query = 0;
+  };
+  struct CachedJunction {
+    PolygonDType polygon;
+    uint64_t last_query = 0;
+  };
+  std::unordered_map<std::string, CachedRoad> road_cache_;
+  std::unordered_map<std::string, CachedJunction> junction_cache_;
+  // The map which the cache is converted from.
+  const hdmap::HDMap* cached_hdmap_ = nullptr;
+  uint64_t num_queries_ = 0;
+
   FRIEND_TEST(HDMapInputTest, test_Init);
   FRIEND_TEST(HDMapInputTest, test_GetROI);
+  FRIEND_TEST(HDMapInputTest, test_GetROICache);
 
   DECLARE_SINGLETON(HDMapInput);
 };
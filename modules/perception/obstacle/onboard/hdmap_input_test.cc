@@ -49,5 +49,49 @@ TEST(HDMapInputTest, test_GetROI) {
   EXPECT_TRUE(hdmap != nullptr);
 }
 
+void ExpectSamePolygons(const PolygonDType& expected,
+                        const PolygonDType& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected.points[i].x, actual.points[i].x);
+    EXPECT_EQ(expected.points[i].y, actual.points[i].y);
+    EXPECT_EQ(expected.points[i].z, actual.points[i].z);
+  }
+}
+
+TEST(HDMapInputTest, test_GetROICache) {
+  auto* hdmap_input = HDMapInput::instance();
+  FLAGS_map_dir = "modules/map/data/sunnyvale_loop";
+  FLAGS_base_map_filename = "base_map.xml";
+  EXPECT_TRUE(hdmap_input->Init());
+  pcl_util::PointD pose = {587054.96336391149, 4141606.3593586856, 0.0};
+  pcl_util::PointD other_pose = {587104.96336391149, 4141606.3593586856, 0.0};
+
+  // Converted without cache.
+  hdmap_input->road_cache_.clear();
+  hdmap_input->junction_cache_.clear();
+  HdmapStructPtr expected(new HdmapStruct);
+  EXPECT_TRUE(hdmap_input->GetROI(pose, FLAGS_map_radius, &expected));
+  EXPECT_FALSE(expected->road_boundary.empty());
+
+  // Converted partly from the cache, after the visible set changed.
+  HdmapStructPtr other(new HdmapStruct);
+  EXPECT_TRUE(hdmap_input->GetROI(other_pose, FLAGS_map_radius, &other));
+  HdmapStructPtr actual(new HdmapStruct);
+  EXPECT_TRUE(hdmap_input->GetROI(pose, FLAGS_map_radius, &actual));
+
+  ASSERT_EQ(expected->road_boundary.size(), actual->road_boundary.size());
+  for (size_t i = 0; i < expected->road_boundary.size(); ++i) {
+    ExpectSamePolygons(expected->road_boundary[i].left_boundary,
+                       actual->road_boundary[i].left_boundary);
+    ExpectSamePolygons(expected->road_boundary[i].right_boundary,
+                       actual->road_boundary[i].right_boundary);
+  }
+  ASSERT_EQ(expected->junction.size(), actual->junction.size());
+  for (size_t i = 0; i < expected->junction.size(); ++i) {
+    ExpectSamePolygons(expected->junction[i], actual->junction[i]);
+  }
+}
+
 }  // namespace perception
 }  // namespace apollo
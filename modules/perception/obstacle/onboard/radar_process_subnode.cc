@@ -16,8 +16,10 @@
 
 #include "modules/perception/obstacle/onboard/radar_process_subnode.h"
 
+#include <cmath>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "Eigen/Core"
 #include "eigen_conversions/eigen_msg.h"
@@ -26,6 +28,7 @@
 
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
+#include "modules/common/util/ctpl_stl.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/base/time_util.h"
 #include "modules/perception/lib/base/timer.h"
@@ -46,6 +49,33 @@ using Eigen::Affine3d;
 using std::string;
 using std::map;
 
+namespace {
+
+// Workers processing the frames of all the radars, or nullptr if they are
+// processed in their callbacks.
+common::util::ThreadPool *RadarThreadPool() {
+  static common::util::ThreadPool *thread_pool =
+      FLAGS_radar_process_thread_num > 0
+          ? new common::util::ThreadPool(FLAGS_radar_process_thread_num)
+          : nullptr;
+  return thread_pool;
+}
+
+// Hdmap roi shared by all the radars.
+RadarRoiCache *SharedRoiCache() {
+  static RadarRoiCache roi_cache(FLAGS_radar_roi_update_distance);
+  return &roi_cache;
+}
+
+}  // namespace
+
+RadarProcessSubnode::~RadarProcessSubnode() {
+  MutexLock lock(&frames_mutex_);
+  while (processing_frames_) {
+    frames_processed_.Wait(&frames_mutex_);
+  }
+}
+
 bool RadarProcessSubnode::InitInternal() {
   if (inited_) {
     return true;
@@ -107,21 +137,25 @@ bool RadarProcessSubnode::InitInternal() {
 }
 
 void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
-  PERF_FUNCTION("RadarProcess");
-  ContiRadar radar_obs_proto = radar_obs;
+  RadarFrame frame;
+  frame.radar_obs = radar_obs;
+  ContiRadar &radar_obs_proto = frame.radar_obs;
   double timestamp = radar_obs_proto.header().timestamp_sec();
-  double unix_timestamp = timestamp;
-  const double cur_time = common::time::Clock::NowInSeconds();
-  const double start_latency = (cur_time - unix_timestamp) * 1e3;
+  frame.unix_timestamp = timestamp;
+  frame.receive_time = common::time::Clock::NowInSeconds();
+  const double start_latency = (frame.receive_time - timestamp) * 1e3;
   AINFO << "FRAME_STATISTICS:Radar:Start:msg_time[" << GLOG_TIMESTAMP(timestamp)
-        << "]:cur_time[" << GLOG_TIMESTAMP(cur_time) << "]:cur_latency["
-        << start_latency << "]";
+        << "]:cur_time[" << GLOG_TIMESTAMP(frame.receive_time)
+        << "]:cur_latency[" << start_latency << "]:device_id[" << device_id_
+        << "]";
   // 0. correct radar timestamp
   timestamp -= 0.07;
   auto *header = radar_obs_proto.mutable_header();
   header->set_timestamp_sec(timestamp);
   header->set_radar_timestamp(timestamp * 1e9);
+  frame.timestamp = timestamp;
 
+  // Ids are expanded in the order the frames are received.
   _conti_id_expansion.UpdateTimestamp(timestamp);
   _conti_id_expansion.ExpandIds(&radar_obs_proto);
 
@@ -129,6 +163,43 @@ void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
     AERROR << "Error timestamp: " << GLOG_TIMESTAMP(timestamp);
     return;
   }
+
+  common::util::ThreadPool *thread_pool = RadarThreadPool();
+  if (thread_pool == nullptr) {
+    ProcessRadar(frame);
+    return;
+  }
+  MutexLock lock(&frames_mutex_);
+  pending_frames_.push_back(std::move(frame));
+  if (!processing_frames_) {
+    processing_frames_ = true;
+    thread_pool->Push([this](int id) { ProcessPendingFrames(); });
+  }
+}
+
+void RadarProcessSubnode::ProcessPendingFrames() {
+  while (true) {
+    RadarFrame frame;
+    {
+      MutexLock lock(&frames_mutex_);
+      if (pending_frames_.empty()) {
+        processing_frames_ = false;
+        frames_processed_.Signalall();
+        return;
+      }
+      frame = std::move(pending_frames_.front());
+      pending_frames_.pop_front();
+    }
+    ProcessRadar(frame);
+  }
+}
+
+void RadarProcessSubnode::ProcessRadar(const RadarFrame &frame) {
+  PERF_FUNCTION("RadarProcess");
+  const ContiRadar &radar_obs_proto = frame.radar_obs;
+  const double timestamp = frame.timestamp;
+  const double unix_timestamp = frame.unix_timestamp;
+  const double process_start_time = common::time::Clock::NowInSeconds();
   ADEBUG << "recv radar msg: [timestamp: " << GLOG_TIMESTAMP(timestamp)
          << " num_raw_obstacles: " << radar_obs_proto.contiobs_size() << "]";
 
@@ -150,20 +221,14 @@ void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
   position.y = (*radar2world_pose)(1, 3);
   position.z = (*radar2world_pose)(2, 3);
   // 2. Get map polygons.
-  std::vector<PolygonDType> map_polygons;
-  HdmapStructPtr hdmap(new HdmapStruct);
-  if (FLAGS_enable_hdmap_input && hdmap_input_ &&
-      !hdmap_input_->GetROI(position, FLAGS_front_radar_forward_distance,
-                            &hdmap)) {
-    AWARN << "Failed to get roi. timestamp: " << GLOG_TIMESTAMP(timestamp)
-          << " position: [" << position.x << ", " << position.y << ", "
-          << position.z << "]";
-    // NOTE: if call hdmap failed, using empty map_polygons.
-  }
-  if (roi_filter_ != nullptr) {
-    roi_filter_->MergeHdmapStructToPolygons(hdmap, &map_polygons);
-  }
+  RadarRoiConstPtr roi = SharedRoiCache()->Get(
+      position, [this](const PointD &query_position,
+                       std::vector<PolygonDType> *polygons) {
+        return QueryRoi(query_position, polygons);
+      });
+  const std::vector<PolygonDType> &map_polygons = roi->polygons;
   RadarDetectorOptions options;
+  options.roi_index = &roi->index;
 
   // 3. get car car_linear_speed
   if (!GetCarLinearSpeed(timestamp, &(options.car_linear_speed))) {
@@ -196,9 +261,11 @@ void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
 
   const double end_timestamp = common::time::Clock::NowInSeconds();
   const double end_latency = (end_timestamp - unix_timestamp) * 1e3;
+  const double wait_latency = (process_start_time - frame.receive_time) * 1e3;
   AINFO << "FRAME_STATISTICS:Radar:End:msg_time[" << GLOG_TIMESTAMP(timestamp)
         << "]:cur_time[" << GLOG_TIMESTAMP(end_timestamp) << "]:cur_latency["
-        << end_latency << "]";
+        << end_latency << "]:wait_latency[" << wait_latency
+        << "]:device_id[" << device_id_ << "]";
   ADEBUG << "radar process succ, there are " << (radar_objects->objects).size()
          << " objects.";
   return;
@@ -211,6 +278,7 @@ void RadarProcessSubnode::OnLocalization(
   LocalizationPair localization_pair;
   localization_pair.first = timestamp;
   localization_pair.second = localization;
+  MutexLock lock(&mutex_);
   localization_buffer_.push_back(localization_pair);
 }
 
@@ -316,6 +384,29 @@ bool RadarProcessSubnode::InitAlgorithmPlugin() {
   return true;
 }
 
+bool RadarProcessSubnode::QueryRoi(const PointD &position,
+                                   std::vector<PolygonDType> *map_polygons) {
+  // The roi is queried with a margin of the update distance, so that it
+  // covers the forward distance until it is queried again.
+  HdmapStructPtr hdmap(new HdmapStruct);
+  bool succ = true;
+  if (FLAGS_enable_hdmap_input && hdmap_input_ &&
+      !hdmap_input_->GetROI(position,
+                            FLAGS_front_radar_forward_distance +
+                                FLAGS_radar_roi_update_distance,
+                            &hdmap)) {
+    AWARN << "Failed to get roi. position: [" << position.x << ", "
+          << position.y << ", " << position.z << "]";
+    // NOTE: if call hdmap failed, using empty map_polygons and query again
+    // with the next frame.
+    succ = false;
+  }
+  if (roi_filter_ != nullptr) {
+    roi_filter_->MergeHdmapStructToPolygons(hdmap, map_polygons);
+  }
+  return succ;
+}
+
 void RadarProcessSubnode::PublishDataAndEvent(
     double timestamp, const SharedDataPtr<SensorObjects> &data) {
   // set shared data
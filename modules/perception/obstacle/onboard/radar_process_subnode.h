@@ -17,6 +17,7 @@
 #ifndef MODULES_PERCEPTION_OBSTACLE_ONBOARD_SUBNODE_H_
 #define MODULES_PERCEPTION_OBSTACLE_ONBOARD_SUBNODE_H_
 #include <boost/circular_buffer.hpp>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -39,6 +40,7 @@
 #include "modules/perception/obstacle/radar/interface/base_radar_detector.h"
 #include "modules/perception/obstacle/radar/modest/conti_radar_id_expansion.h"
 #include "modules/perception/obstacle/radar/modest/modest_radar_detector.h"
+#include "modules/perception/obstacle/radar/modest/radar_roi_cache.h"
 #include "modules/perception/onboard/subnode.h"
 #include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/perception/obstacle/common/pose_util.h"
@@ -49,7 +51,8 @@ namespace perception {
 class RadarProcessSubnode : public Subnode {
  public:
   RadarProcessSubnode() = default;
-  ~RadarProcessSubnode() = default;
+  // Waits for the frames being processed by workers.
+  ~RadarProcessSubnode();
 
   apollo::common::Status ProcEvents() override {
     return apollo::common::Status::OK();
@@ -58,10 +61,29 @@ class RadarProcessSubnode : public Subnode {
  private:
   typedef std::pair<double,
     apollo::localization::LocalizationEstimate> LocalizationPair;
+
+  // A received radar frame, with the timestamp corrected and the ids
+  // expanded.
+  struct RadarFrame {
+    ContiRadar radar_obs;
+    double timestamp = 0.0;
+    // timestamp of the message before correction
+    double unix_timestamp = 0.0;
+    double receive_time = 0.0;
+  };
+
   bool InitInternal() override;
 
   void OnRadar(const ContiRadar &radar_obs);
 
+  // Detects the objects of a frame and publishes them to fusion.
+  void ProcessRadar(const RadarFrame &frame);
+
+  // Processes the pending frames in the order they were received, until
+  // there are none. Frames of a radar are processed by one worker at a time,
+  // while those of different radars are processed in parallel.
+  void ProcessPendingFrames();
+
   void OnLocalization(
     const apollo::localization::LocalizationEstimate &localization);
 
@@ -76,6 +98,10 @@ class RadarProcessSubnode : public Subnode {
 
   bool GetCarLinearSpeed(double timestamp, Eigen::Vector3f *car_linear_speed);
 
+  // Queries the hdmap roi polygons around the radar position.
+  bool QueryRoi(const pcl_util::PointD &position,
+                std::vector<PolygonDType> *map_polygons);
+
   bool inited_ = false;
   SeqId seq_num_ = 0;
   common::ErrorCode error_code_ = common::OK;
@@ -91,6 +117,11 @@ class RadarProcessSubnode : public Subnode {
   // here we use HdmapROIFilter
   std::unique_ptr<HdmapROIFilter> roi_filter_;
   Mutex mutex_;
+  // Frames waiting for a worker, and whether a worker is processing them.
+  std::deque<RadarFrame> pending_frames_;
+  bool processing_frames_ = false;
+  Mutex frames_mutex_;
+  CondVar frames_processed_;
 };
 
 REGISTER_SUBNODE(RadarProcessSubnode);
@@ -73,9 +73,14 @@ using ::apollo::common::Header;
 using ::apollo::drivers::ContiRadarObs;
 using ::apollo::drivers::ContiRadar;
 
+class RadarRoiIndex;
+
 struct RadarDetectorOptions {
   Eigen::Matrix4d *radar2world_pose = nullptr;
   Eigen::Vector3f car_linear_speed = Eigen::Vector3f::Zero();
+  // Optional index built from the map polygons passed to Detect, which tests
+  // objects against them in constant time.
+  const RadarRoiIndex *roi_index = nullptr;
 };
 enum ContiObjectType {
   CONTI_POINT = 0,
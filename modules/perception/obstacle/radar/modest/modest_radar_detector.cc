@@ -190,7 +190,7 @@ bool ModestRadarDetector::Detect(const ContiRadar &raw_obstacles,
 
   // roi filter
   auto &filter_objects = radar_objects.objects;
-  RoiFilter(map_polygons, &filter_objects);
+  RoiFilter(map_polygons, options.roi_index, &filter_objects);
   // treatment
   radar_tracker_->Process(radar_objects);
   AINFO << "After process, object size: " << radar_objects.objects.size();
@@ -222,6 +222,7 @@ bool ModestRadarDetector::CollectRadarResult(std::vector<ObjectPtr> *objects) {
 
 void ModestRadarDetector::RoiFilter(
     const std::vector<PolygonDType> &map_polygons,
+    const RadarRoiIndex *roi_index,
     std::vector<ObjectPtr>* filter_objects) {
   AINFO << "Before using hdmap, object size:" << filter_objects->size();
   // use new hdmap
@@ -233,8 +234,13 @@ void ModestRadarDetector::RoiFilter(
         obs_position.x = filter_objects->at(i)->center(0);
         obs_position.y = filter_objects->at(i)->center(1);
         obs_position.z = filter_objects->at(i)->center(2);
-        if (RadarUtil::IsXyPointInHdmap<pcl_util::PointD>(obs_position,
-                                                          map_polygons)) {
+        // The index, if any, gives the same results as the polygons.
+        const bool in_roi =
+            roi_index != nullptr
+                ? roi_index->IsXyPointIn(obs_position)
+                : RadarUtil::IsXyPointInHdmap<pcl_util::PointD>(obs_position,
+                                                                map_polygons);
+        if (in_roi) {
           filter_objects->at(obs_number) = filter_objects->at(i);
           obs_number++;
         }
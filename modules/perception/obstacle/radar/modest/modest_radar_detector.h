@@ -22,6 +22,7 @@
 
 #include "modules/perception/obstacle/radar/interface/base_radar_detector.h"
 #include "modules/perception/obstacle/radar/modest/object_builder.h"
+#include "modules/perception/obstacle/radar/modest/radar_roi_index.h"
 #include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
 
 namespace apollo {
@@ -56,6 +57,7 @@ class ModestRadarDetector : public BaseRadarDetector {
 
  private:
   void RoiFilter(const std::vector<PolygonDType> &map_polygons,
+                 const RadarRoiIndex *roi_index,
                  std::vector<ObjectPtr>* filter_objects);
 
   // for unit test
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/radar/modest/radar_roi_cache.h"
+
+#include <cmath>
+
+namespace apollo {
+namespace perception {
+
+RadarRoiConstPtr RadarRoiCache::Get(const pcl_util::PointD &position,
+                                    const QueryFunction &query) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (roi_ != nullptr && std::hypot(position.x - roi_->position.x,
+                                    position.y - roi_->position.y) <=
+                             update_distance_) {
+    return roi_;
+  }
+  std::shared_ptr<RadarRoi> roi(new RadarRoi);
+  roi->position = position;
+  ++num_queries_;
+  const bool succ = query(position, &roi->polygons);
+  roi->index.Build(roi->polygons);
+  if (succ) {
+    roi_ = roi;
+  }
+  return roi;
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_ROI_CACHE_H_
+#define MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_ROI_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "modules/perception/obstacle/base/types.h"
+#include "modules/perception/obstacle/radar/modest/radar_roi_index.h"
+
+namespace apollo {
+namespace perception {
+
+// @brief: hdmap roi polygons queried around a position, and their index.
+struct RadarRoi {
+  pcl_util::PointD position;
+  std::vector<PolygonDType> polygons;
+  RadarRoiIndex index;
+};
+
+typedef std::shared_ptr<const RadarRoi> RadarRoiConstPtr;
+
+// @brief: Roi shared by the radars, so that the hdmap is queried once for all
+// of them while they stay near the position of the last query. Rois are
+// immutable once queried, and may be used by any thread while the cache
+// queries the next one.
+class RadarRoiCache {
+ public:
+  // @brief: query the roi polygons around a position, returning false if
+  // the query failed.
+  typedef std::function<bool(const pcl_util::PointD &,
+                             std::vector<PolygonDType> *)>
+      QueryFunction;
+
+  // @param [in]: distance from the position of the last query within which
+  // its roi is used.
+  explicit RadarRoiCache(const double update_distance)
+      : update_distance_(update_distance) {}
+
+  // @brief: get the roi around a position, querying it if the cached roi is
+  // too far. Rois of failed queries are returned but not cached, so that the
+  // next call queries again. Concurrent calls wait for a running query and
+  // share its roi.
+  RadarRoiConstPtr Get(const pcl_util::PointD &position,
+                       const QueryFunction &query);
+
+  int num_queries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_queries_;
+  }
+
+ private:
+  const double update_distance_;
+  mutable std::mutex mutex_;
+  RadarRoiConstPtr roi_;
+  int num_queries_ = 0;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_ROI_CACHE_H_
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/obstacle/radar/modest/radar_roi_cache.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace {
+
+pcl_util::PointD MakePoint(const double x, const double y) {
+  pcl_util::PointD point;
+  point.x = x;
+  point.y = y;
+  point.z = 0.0;
+  return point;
+}
+
+// Queries a square around the position.
+bool QuerySquare(const pcl_util::PointD &position,
+                 std::vector<PolygonDType> *polygons) {
+  PolygonDType polygon;
+  polygon.points.push_back(MakePoint(position.x - 1.0, position.y - 1.0));
+  polygon.points.push_back(MakePoint(position.x + 1.0, position.y - 1.0));
+  polygon.points.push_back(MakePoint(position.x + 1.0, position.y + 1.0));
+  polygon.points.push_back(MakePoint(position.x - 1.0, position.y + 1.0));
+  polygons->push_back(polygon);
+  return true;
+}
+
+bool QueryFailed(const pcl_util::PointD &position,
+                 std::vector<PolygonDType> *polygons) {
+  return false;
+}
+
+}  // namespace
+
+TEST(RadarRoiCacheTest, query_once_nearby) {
+  RadarRoiCache cache(10.0);
+  RadarRoiConstPtr roi = cache.Get(MakePoint(0.0, 0.0), QuerySquare);
+  ASSERT_TRUE(roi != nullptr);
+  EXPECT_EQ(1, cache.num_queries());
+  EXPECT_EQ(1u, roi->polygons.size());
+  EXPECT_TRUE(roi->index.IsXyPointIn(MakePoint(0.5, 0.5)));
+  EXPECT_FALSE(roi->index.IsXyPointIn(MakePoint(1.5, 0.5)));
+
+  EXPECT_EQ(roi, cache.Get(MakePoint(6.0, 8.0), QuerySquare));
+  EXPECT_EQ(1, cache.num_queries());
+
+  RadarRoiConstPtr next_roi = cache.Get(MakePoint(6.0, 8.5), QuerySquare);
+  EXPECT_NE(roi, next_roi);
+  EXPECT_EQ(2, cache.num_queries());
+  EXPECT_TRUE(next_roi->index.IsXyPointIn(MakePoint(6.5, 8.5)));
+  // Rois in use stay valid after the next query.
+  EXPECT_TRUE(roi->index.IsXyPointIn(MakePoint(0.5, 0.5)));
+}
+
+TEST(RadarRoiCacheTest, query_again_after_failure) {
+  RadarRoiCache cache(10.0);
+  RadarRoiConstPtr roi = cache.Get(MakePoint(0.0, 0.0), QueryFailed);
+  ASSERT_TRUE(roi != nullptr);
+  EXPECT_TRUE(roi->polygons.empty());
+  EXPECT_FALSE(roi->index.IsXyPointIn(MakePoint(0.0, 0.0)));
+
+  roi = cache.Get(MakePoint(0.0, 0.0), QuerySquare);
+  EXPECT_EQ(2, cache.num_queries());
+  EXPECT_TRUE(roi->index.IsXyPointIn(MakePoint(0.0, 0.0)));
+}
+
+TEST(RadarRoiCacheTest, share_concurrent_queries) {
+  RadarRoiCache cache(10.0);
+  std::vector<RadarRoiConstPtr> rois(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < rois.size(); ++i) {
+    threads.emplace_back([&cache, &rois, i]() {
+      rois[i] = cache.Get(MakePoint(0.5 * i, 0.0), QuerySquare);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(1, cache.num_queries());
+  for (const auto &roi : rois) {
+    EXPECT_EQ(rois[0], roi);
+  }
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/radar/modest/radar_roi_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace apollo {
+namespace perception {
+namespace {
+
+// Edges within this distance of a cell are considered to cross it, so that
+// rounding errors never classify a cell which an edge crosses.
+constexpr double kMargin = 1e-3;
+
+// Cells are enlarged to keep their number below this.
+constexpr double kMaxNumCells = 1 << 20;
+
+}  // namespace
+
+void RadarRoiIndex::Clear() {
+  cell_size_ = 0.0;
+  origin_x_ = 0.0;
+  origin_y_ = 0.0;
+  num_cols_ = 0;
+  num_rows_ = 0;
+  polygons_.clear();
+  cell_states_.clear();
+  candidate_begins_.clear();
+  candidates_.clear();
+}
+
+void RadarRoiIndex::Build(const std::vector<PolygonDType> &polygons) {
+  Clear();
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+  for (const auto &polygon : polygons) {
+    // Points are never in polygons of less than 3 points.
+    if (polygon.points.size() < 3) {
+      continue;
+    }
+    polygons_.push_back(polygon);
+    for (const auto &point : polygon.points) {
+      min_x = std::min(min_x, point.x);
+      min_y = std::min(min_y, point.y);
+      max_x = std::max(max_x, point.x);
+      max_y = std::max(max_y, point.y);
+    }
+  }
+  if (polygons_.empty()) {
+    return;
+  }
+
+  cell_size_ = default_cell_size_;
+  while ((std::floor((max_x - min_x) / cell_size_) + 1.0) *
+             (std::floor((max_y - min_y) / cell_size_) + 1.0) >
+         kMaxNumCells) {
+    cell_size_ *= 2.0;
+  }
+  origin_x_ = min_x;
+  origin_y_ = min_y;
+  num_cols_ = static_cast<int>(std::floor((max_x - min_x) / cell_size_)) + 1;
+  num_rows_ = static_cast<int>(std::floor((max_y - min_y) / cell_size_)) + 1;
+  const int num_cells = num_cols_ * num_rows_;
+  cell_states_.assign(num_cells, OUTSIDE);
+
+  std::vector<int> marks(num_cells, -1);
+  std::vector<int> cells;
+  std::vector<std::pair<int, int>> boundary_cells;
+  for (int i = 0; i < static_cast<int>(polygons_.size()); ++i) {
+    cells.clear();
+    CollectBoundaryCells(polygons_[i], i, &marks, &cells);
+    for (const int cell : cells) {
+      boundary_cells.emplace_back(cell, i);
+    }
+    MarkInsideCells(polygons_[i], i, marks);
+  }
+
+  // Cells inside any polygon need no candidates.
+  candidate_begins_.assign(num_cells + 1, 0);
+  for (const auto &boundary_cell : boundary_cells) {
+    const int cell = boundary_cell.first;
+    if (cell_states_[cell] != INSIDE) {
+      cell_states_[cell] = BOUNDARY;
+      ++candidate_begins_[cell + 1];
+    }
+  }
+  for (int i = 0; i < num_cells; ++i) {
+    candidate_begins_[i + 1] += candidate_begins_[i];
+  }
+  candidates_.resize(candidate_begins_[num_cells]);
+  std::vector<int> ends(candidate_begins_.begin(),
+                        candidate_begins_.end() - 1);
+  for (const auto &boundary_cell : boundary_cells) {
+    const int cell = boundary_cell.first;
+    if (cell_states_[cell] == BOUNDARY) {
+      candidates_[ends[cell]++] = boundary_cell.second;
+    }
+  }
+}
+
+void RadarRoiIndex::CollectBoundaryCells(const PolygonDType &polygon,
+                                         const int index,
+                                         std::vector<int> *marks,
+                                         std::vector<int> *cells) const {
+  const auto &points = polygon.points;
+  const size_t num_points = points.size();
+  for (size_t i = 0, j = num_points - 1; i < num_points; j = i++) {
+    const double x1 = points[j].x;
+    const double y1 = points[j].y;
+    const double x2 = points[i].x;
+    const double y2 = points[i].y;
+    const int col_begin = std::max(
+        0, static_cast<int>(
+               std::floor((std::min(x1, x2) - kMargin - origin_x_) /
+                          cell_size_)));
+    const int col_end = std::min(
+        num_cols_ - 1,
+        static_cast<int>(std::floor(
+            (std::max(x1, x2) + kMargin - origin_x_) / cell_size_)));
+    const int row_begin = std::max(
+        0, static_cast<int>(
+               std::floor((std::min(y1, y2) - kMargin - origin_y_) /
+                          cell_size_)));
+    const int row_end = std::min(
+        num_rows_ - 1,
+        static_cast<int>(std::floor(
+            (std::max(y1, y2) + kMargin - origin_y_) / cell_size_)));
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    for (int row = row_begin; row <= row_end; ++row) {
+      const double cell_y1 = origin_y_ + row * cell_size_ - kMargin;
+      const double cell_y2 = cell_y1 + cell_size_ + 2.0 * kMargin;
+      for (int col = col_begin; col <= col_end; ++col) {
+        const int cell = row * num_cols_ + col;
+        if ((*marks)[cell] == index) {
+          continue;
+        }
+        // The edge misses the cell if all its corners are strictly on the
+        // same side of the edge.
+        const double cell_x1 = origin_x_ + col * cell_size_ - kMargin;
+        const double cell_x2 = cell_x1 + cell_size_ + 2.0 * kMargin;
+        const double side1 = dx * (cell_y1 - y1) - dy * (cell_x1 - x1);
+        const double side2 = dx * (cell_y1 - y1) - dy * (cell_x2 - x1);
+        const double side3 = dx * (cell_y2 - y1) - dy * (cell_x1 - x1);
+        const double side4 = dx * (cell_y2 - y1) - dy * (cell_x2 - x1);
+        if ((side1 > 0.0 && side2 > 0.0 && side3 > 0.0 && side4 > 0.0) ||
+            (side1 < 0.0 && side2 < 0.0 && side3 < 0.0 && side4 < 0.0)) {
+          continue;
+        }
+        (*marks)[cell] = index;
+        cells->push_back(cell);
+      }
+    }
+  }
+}
+
+void RadarRoiIndex::MarkInsideCells(const PolygonDType &polygon,
+                                    const int index,
+                                    const std::vector<int> &marks) {
+  const auto &points = polygon.points;
+  const size_t num_points = points.size();
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+  for (const auto &point : points) {
+    min_x = std::min(min_x, point.x);
+    min_y = std::min(min_y, point.y);
+    max_x = std::max(max_x, point.x);
+    max_y = std::max(max_y, point.y);
+  }
+  const int col_begin =
+      static_cast<int>(std::floor((min_x - origin_x_) / cell_size_));
+  const int col_end = std::min(
+      num_cols_ - 1,
+      static_cast<int>(std::floor((max_x - origin_x_) / cell_size_)));
+  const int row_begin =
+      static_cast<int>(std::floor((min_y - origin_y_) / cell_size_));
+  const int row_end = std::min(
+      num_rows_ - 1,
+      static_cast<int>(std::floor((max_y - origin_y_) / cell_size_)));
+
+  // Cells which no edge crosses are classified by their centers, counting
+  // the edges crossing the column of centers below each of them.
+  std::vector<double> crossings;
+  for (int col = col_begin; col <= col_end; ++col) {
+    const double x = origin_x_ + (col + 0.5) * cell_size_;
+    crossings.clear();
+    for (size_t i = 0, j = num_points - 1; i < num_points; j = i++) {
+      const double x1 = points[j].x;
+      const double y1 = points[j].y;
+      const double x2 = points[i].x;
+      const double y2 = points[i].y;
+      if ((x1 <= x) != (x2 <= x)) {
+        crossings.push_back(y1 + (x - x1) * (y2 - y1) / (x2 - x1));
+      }
+    }
+    if (crossings.empty()) {
+      continue;
+    }
+    std::sort(crossings.begin(), crossings.end());
+    size_t num_below = 0;
+    for (int row = row_begin; row <= row_end; ++row) {
+      const double y = origin_y_ + (row + 0.5) * cell_size_;
+      while (num_below < crossings.size() && crossings[num_below] < y) {
+        ++num_below;
+      }
+      const int cell = row * num_cols_ + col;
+      if (num_below % 2 == 1 && marks[cell] != index) {
+        cell_states_[cell] = INSIDE;
+      }
+    }
+  }
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_ROI_INDEX_H_
+#define MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_ROI_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/perception/obstacle/base/types.h"
+#include "modules/perception/obstacle/radar/modest/radar_util.h"
+
+namespace apollo {
+namespace perception {
+
+// @brief: Grid index of hdmap roi polygons, which tests points as
+// RadarUtil::IsXyPointInHdmap does, with the same results.
+// Cells which no polygon edge crosses are entirely inside or outside the
+// polygons, and are classified when the index is built, so that points in
+// them are tested in constant time. Points in the other cells are tested
+// against the polygons crossing their cell only.
+class RadarRoiIndex {
+ public:
+  // @param [in]: size of the grid cells, which are enlarged if the polygons
+  // span too many cells.
+  explicit RadarRoiIndex(const double cell_size = 2.0)
+      : default_cell_size_(cell_size) {}
+
+  // @brief: build the index of polygons, which are copied.
+  // @param [in]: roi map polygons, using world frame.
+  void Build(const std::vector<PolygonDType> &polygons);
+
+  // @brief: test whether a point is in any of the polygons.
+  template <typename PointT>
+  bool IsXyPointIn(const PointT &point) const {
+    const double col = (point.x - origin_x_) / cell_size_;
+    const double row = (point.y - origin_y_) / cell_size_;
+    if (!(col >= 0.0 && col < num_cols_ && row >= 0.0 && row < num_rows_)) {
+      return false;
+    }
+    const int cell =
+        static_cast<int>(row) * num_cols_ + static_cast<int>(col);
+    switch (cell_states_[cell]) {
+      case INSIDE:
+        return true;
+      case OUTSIDE:
+        return false;
+      default:
+        break;
+    }
+    for (int i = candidate_begins_[cell]; i < candidate_begins_[cell + 1];
+         ++i) {
+      if (RadarUtil::IsXyPointIn2dXyPolygon<PointT>(
+              point, polygons_[candidates_[i]])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  enum CellState : uint8_t {
+    OUTSIDE = 0,
+    INSIDE = 1,
+    BOUNDARY = 2,
+  };
+
+  void Clear();
+
+  // Appends the cells crossed by the edges of a polygon to cells, and marks
+  // them with the polygon index in marks.
+  void CollectBoundaryCells(const PolygonDType &polygon, const int index,
+                            std::vector<int> *marks,
+                            std::vector<int> *cells) const;
+
+  // Marks the cells of a polygon which are not boundary cells and whose
+  // center is in the polygon as inside.
+  void MarkInsideCells(const PolygonDType &polygon, const int index,
+                       const std::vector<int> &marks);
+
+  const double default_cell_size_;
+  double cell_size_ = 0.0;
+  double origin_x_ = 0.0;
+  double origin_y_ = 0.0;
+  int num_cols_ = 0;
+  int num_rows_ = 0;
+  std::vector<PolygonDType> polygons_;
+  std::vector<uint8_t> cell_states_;
+  // Polygons crossing boundary cells, with those of cell i in
+  // [candidate_begins_[i], candidate_begins_[i + 1]) of candidates_.
+  std::vector<int> candidate_begins_;
+  std::vector<int> candidates_;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_ROI_INDEX_H_
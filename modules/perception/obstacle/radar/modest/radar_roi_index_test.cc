@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/obstacle/radar/modest/radar_roi_index.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace {
+
+PolygonDType MakePolygon(const std::vector<std::pair<double, double>> &xys,
+                         const double offset_x, const double offset_y) {
+  PolygonDType polygon;
+  for (const auto &xy : xys) {
+    pcl_util::PointD point;
+    point.x = xy.first + offset_x;
+    point.y = xy.second + offset_y;
+    point.z = 0.0;
+    polygon.points.push_back(point);
+  }
+  return polygon;
+}
+
+// Roads and junctions around an offset, in the magnitude of utm coordinates.
+std::vector<PolygonDType> MakeRoiPolygons(const double offset_x,
+                                          const double offset_y) {
+  std::vector<PolygonDType> polygons;
+  // A straight road.
+  polygons.push_back(MakePolygon(
+      {{-100.0, -3.5}, {100.0, -3.5}, {100.0, 3.5}, {-100.0, 3.5}}, offset_x,
+      offset_y));
+  // A rotated road crossing it.
+  const double c = std::cos(0.6);
+  const double s = std::sin(0.6);
+  std::vector<std::pair<double, double>> rotated;
+  for (const auto &xy : std::vector<std::pair<double, double>>{
+           {-80.0, -4.0}, {80.0, -4.0}, {80.0, 4.0}, {-80.0, 4.0}}) {
+    rotated.emplace_back(c * xy.first - s * xy.second,
+                         s * xy.first + c * xy.second);
+  }
+  polygons.push_back(MakePolygon(rotated, offset_x, offset_y));
+  // A curved road, as a concave polygon.
+  std::vector<std::pair<double, double>> curve;
+  for (int i = 0; i <= 40; ++i) {
+    const double theta = M_PI * i / 40.0;
+    curve.emplace_back(30.0 + 40.0 * std::cos(theta),
+                       20.0 + 40.0 * std::sin(theta));
+  }
+  for (int i = 40; i >= 0; --i) {
+    const double theta = M_PI * i / 40.0;
+    curve.emplace_back(30.0 + 32.0 * std::cos(theta),
+                       20.0 + 32.0 * std::sin(theta));
+  }
+  polygons.push_back(MakePolygon(curve, offset_x, offset_y));
+  // A junction with vertices on cell borders.
+  polygons.push_back(MakePolygon(
+      {{-10.0, -10.0}, {10.0, -10.0}, {10.0, 10.0}, {-10.0, 10.0}}, offset_x,
+      offset_y));
+  // Degenerate polygons.
+  polygons.push_back(MakePolygon({{1.0, 1.0}, {2.0, 2.0}}, offset_x, offset_y));
+  polygons.push_back(MakePolygon({}, offset_x, offset_y));
+  return polygons;
+}
+
+void ExpectSameAsPolygons(const std::vector<PolygonDType> &polygons,
+                          const double offset_x, const double offset_y) {
+  std::vector<PolygonDType> valid_polygons;
+  for (const auto &polygon : polygons) {
+    if (!polygon.points.empty()) {
+      valid_polygons.push_back(polygon);
+    }
+  }
+  RadarRoiIndex index;
+  index.Build(polygons);
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> coordinate(-120.0, 120.0);
+  int num_in = 0;
+  for (int i = 0; i < 100000; ++i) {
+    pcl_util::PointD point;
+    point.x = coordinate(engine);
+    point.y = coordinate(engine);
+    // Points on cell borders, edges and vertices.
+    if (i % 4 == 0) {
+      point.x = std::round(point.x * 2.0) / 2.0;
+      point.y = std::round(point.y * 2.0) / 2.0;
+    }
+    point.x += offset_x;
+    point.y += offset_y;
+    point.z = 0.0;
+    const bool expected =
+        RadarUtil::IsXyPointInHdmap<pcl_util::PointD>(point, valid_polygons);
+    ASSERT_EQ(expected, index.IsXyPointIn(point))
+        << "point: " << point.x << ", " << point.y;
+    num_in += expected;
+  }
+  EXPECT_GT(num_in, 0);
+}
+
+}  // namespace
+
+TEST(RadarRoiIndexTest, same_as_polygons) {
+  ExpectSameAsPolygons(MakeRoiPolygons(0.0, 0.0), 0.0, 0.0);
+}
+
+TEST(RadarRoiIndexTest, same_as_polygons_in_utm) {
+  ExpectSameAsPolygons(MakeRoiPolygons(437000.25, 4417000.75), 437000.25,
+                       4417000.75);
+}
+
+TEST(RadarRoiIndexTest, empty) {
+  RadarRoiIndex index;
+  pcl_util::PointD point;
+  point.x = 0.0;
+  point.y = 0.0;
+  EXPECT_FALSE(index.IsXyPointIn(point));
+  index.Build(std::vector<PolygonDType>());
+  EXPECT_FALSE(index.IsXyPointIn(point));
+}
+
+TEST(RadarRoiIndexTest, rebuild) {
+  RadarRoiIndex index;
+  pcl_util::PointD point;
+  point.x = 0.0;
+  point.y = 0.0;
+  index.Build({MakePolygon({{-1.0, -1.0}, {1.0, -1.0}, {1.0, 1.0}}, 0.0, 0.0),
+               MakePolygon({{-1.0, -1.0}, {1.0, 1.0}, {-1.0, 1.0}}, 0.0,
+                           0.0)});
+  EXPECT_TRUE(index.IsXyPointIn(point));
+  index.Build({MakePolygon({{5.0, 5.0}, {6.0, 5.0}, {6.0, 6.0}}, 0.0, 0.0)});
+  EXPECT_FALSE(index.IsXyPointIn(point));
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -16,6 +16,7 @@
 
 #include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -44,24 +45,40 @@ void RadarTrackManager::AssignTrackObsIdMatch(
     std::vector<std::pair<int, int>> *assignment,
     std::vector<int> *unassigned_track,
     std::vector<int> *unassigned_obs) {
-  assignment->resize(obs_tracks_.size() * 2);
-  int assignment_num = 0;
+  assignment->clear();
+  assignment->reserve(obs_tracks_.size());
   std::vector<bool> track_used(obs_tracks_.size(), false);
   std::vector<bool> obs_used(radar_obs.objects.size(), false);
+  // Link the observations with the same id in ascending order, so that the
+  // assignment is in the same order as matching all pairs.
+  obs_id_heads_.clear();
+  obs_id_nexts_.resize(radar_obs.objects.size());
+  for (int j = static_cast<int>(radar_obs.objects.size()) - 1; j >= 0; j--) {
+    auto head = obs_id_heads_.emplace(radar_obs.objects[j]->track_id, j);
+    if (head.second) {
+      obs_id_nexts_[j] = -1;
+    } else {
+      obs_id_nexts_[j] = head.first->second;
+      head.first->second = j;
+    }
+  }
   for (size_t i = 0; i < obs_tracks_.size(); i++) {
     std::shared_ptr<Object> obs;
     obs = obs_tracks_[i].GetObsRadar();
     if (obs == nullptr) {
       continue;
     }
+    auto head = obs_id_heads_.find(obs->track_id);
+    if (head == obs_id_heads_.end()) {
+      continue;
+    }
     double timestamp_track = obs_tracks_[i].GetTimestamp();
     double timestamp_obs = radar_obs.timestamp;
-    for (size_t j = 0; j < radar_obs.objects.size(); j++) {
+    for (int j = head->second; j >= 0; j = obs_id_nexts_[j]) {
       double distance = DistanceBetweenObs(
           *obs, timestamp_track, *(radar_obs.objects[j]), timestamp_obs);
-      if (obs->track_id == radar_obs.objects[j]->track_id &&
-          distance < RADAR_TRACK_THRES) {
-        assignment->at(assignment_num++) = std::make_pair(i, j);
+      if (distance < RADAR_TRACK_THRES) {
+        assignment->push_back(std::make_pair(i, j));
         track_used[i] = true;
         obs_used[j] = true;
         obs_tracks_[i].IncreaseTrackedTimes();
@@ -69,7 +86,6 @@ void RadarTrackManager::AssignTrackObsIdMatch(
     }
   }
 
-  assignment->resize(assignment_num);
   unassigned_track->resize(obs_tracks_.size());
   int unassigned_track_num = 0;
   for (size_t i = 0; i < track_used.size(); i++) {
@@ -113,17 +129,17 @@ void RadarTrackManager::UpdateUnassignedTrack(
 }
 
 void RadarTrackManager::DeleteLostTrack() {
-  int track_num = 0;
-  for (size_t i = 0; i < obs_tracks_.size(); i++) {
-    if (obs_tracks_[i].GetObsRadar() != nullptr) {
-      obs_tracks_[track_num++] = obs_tracks_[i];
-    }
-  }
-  obs_tracks_.resize(track_num);
+  // Only the tracks after the first lost one are moved, keeping their order.
+  obs_tracks_.erase(std::remove_if(obs_tracks_.begin(), obs_tracks_.end(),
+                                   [](RadarTrack &track) {
+                                     return track.GetObsRadar() == nullptr;
+                                   }),
+                    obs_tracks_.end());
 }
 
 void RadarTrackManager::CreateNewTrack(const SensorObjects &radar_obs,
                                        const std::vector<int>& unassigned_obs) {
+  obs_tracks_.reserve(obs_tracks_.size() + unassigned_obs.size());
   for (size_t i = 0; i < unassigned_obs.size(); i++) {
     obs_tracks_.push_back(RadarTrack(
                          *(radar_obs.objects[unassigned_obs[i]]),
@@ -18,6 +18,7 @@
 #define MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_TRACK_MANAGER_H_
 
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,7 +46,9 @@ class RadarTrackManager {
   void Update(SensorObjects* radar_obs);
 
   // @brief match observation obstacles to existed tracking states by
-  //            tracking id
+  //            tracking id, looking up the observations of each tracking
+  //            state by its id, so that distances are only computed for
+  //            observations with the same id
   // @param [out]: assigement index pairs of observations and tracking states
   // @param [out]: indexs of unassigend tracking state
   // @param [out]: indexs of unassigned observation obstacles
@@ -94,6 +97,11 @@ class RadarTrackManager {
                             const Object &obs2, double timestamp2);
   SensorObjects radar_obs_;
   std::vector<RadarTrack> obs_tracks_;
+  // Observations by tracking id, reused across frames: obs_id_heads_ maps an
+  // id to its first observation, and obs_id_nexts_[j] is the next
+  // observation with the id of observation j, or -1.
+  std::unordered_map<int, int> obs_id_heads_;
+  std::vector<int> obs_id_nexts_;
 };
 
 }  // namespace perception
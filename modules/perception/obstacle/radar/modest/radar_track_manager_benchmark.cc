@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
+
+namespace apollo {
+namespace perception {
+namespace {
+
+// Frames of objects moving along x and keeping their ids.
+std::vector<SensorObjects> MakeFrames(const int num_objects,
+                                      const int num_frames) {
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+  std::vector<SensorObjects> frames(num_frames);
+  for (int frame = 0; frame < num_frames; ++frame) {
+    frames[frame].timestamp = frame * RADAR_CYCLE;
+    for (int i = 0; i < num_objects; ++i) {
+      ObjectPtr obs(new Object);
+      obs->track_id = i;
+      obs->center << 2.0 * i + 10.0 * frames[frame].timestamp +
+                         jitter(engine),
+          i % 8 + jitter(engine), 0.0;
+      obs->velocity << 10.0, 0.0, 0.0;
+      frames[frame].objects.push_back(obs);
+    }
+  }
+  return frames;
+}
+
+void BM_Process(benchmark::State &state) {
+  const auto frames = MakeFrames(state.range(0), 100);
+  RadarTrackManager track_manager;
+  size_t frame = 0;
+  while (state.KeepRunning()) {
+    track_manager.Process(frames[frame]);
+    frame = (frame + 1) % frames.size();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Process)->Arg(64)->Arg(128)->Arg(256);
+
+}  // namespace
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace {
+
+// Radar frames of objects moving along x, some of which keep their ids, some
+// of which jump away or share their ids with other objects.
+SensorObjects MakeFrame(const int frame, std::mt19937 *engine) {
+  std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+  std::uniform_int_distribution<int> event(0, 19);
+  SensorObjects radar_obs;
+  radar_obs.timestamp = frame * RADAR_CYCLE;
+  for (int i = 0; i < 128; ++i) {
+    ObjectPtr obs(new Object);
+    obs->track_id = i + frame / 10;
+    obs->center << 2.0 * i + 10.0 * radar_obs.timestamp + jitter(*engine),
+        i % 8 + jitter(*engine), 0.0;
+    obs->velocity << 10.0, 0.0, 0.0;
+    const int e = event(*engine);
+    if (e == 0) {
+      obs->center(1) += 5.0;
+    } else if (e == 1) {
+      obs->track_id = (i + 1) + frame / 10;
+    } else if (e == 2) {
+      continue;
+    }
+    radar_obs.objects.push_back(obs);
+  }
+  return radar_obs;
+}
+
+// Matches all pairs of tracks and observations.
+std::vector<std::pair<int, int>> MatchAllPairs(
+    std::vector<RadarTrack> *tracks, const SensorObjects &radar_obs) {
+  std::vector<std::pair<int, int>> assignment;
+  for (size_t i = 0; i < tracks->size(); ++i) {
+    ObjectPtr obs = (*tracks)[i].GetObsRadar();
+    if (obs == nullptr) {
+      continue;
+    }
+    const double time_diff =
+        radar_obs.timestamp - (*tracks)[i].GetTimestamp();
+    for (size_t j = 0; j < radar_obs.objects.size(); ++j) {
+      const Object &other = *radar_obs.objects[j];
+      const double distance =
+          (other.center - obs->center - obs->velocity * time_diff)
+              .head(2)
+              .norm();
+      if (obs->track_id == other.track_id && distance < RADAR_TRACK_THRES) {
+        assignment.emplace_back(i, j);
+      }
+    }
+  }
+  return assignment;
+}
+
+}  // namespace
+
+TEST(RadarTrackManagerTest, same_as_matching_all_pairs) {
+  RadarTrackManager track_manager;
+  std::mt19937 engine(0);
+  int num_assigned = 0;
+  int num_unassigned = 0;
+  for (int frame = 0; frame < 50; ++frame) {
+    const SensorObjects radar_obs = MakeFrame(frame, &engine);
+    const auto expected =
+        MatchAllPairs(&track_manager.GetTracks(), radar_obs);
+    std::vector<std::pair<int, int>> assignment;
+    std::vector<int> unassigned_track;
+    std::vector<int> unassigned_obs;
+    track_manager.AssignTrackObsIdMatch(radar_obs, &assignment,
+                                        &unassigned_track, &unassigned_obs);
+    ASSERT_EQ(expected, assignment);
+    std::vector<bool> obs_used(radar_obs.objects.size(), false);
+    for (const auto &pair : expected) {
+      obs_used[pair.second] = true;
+    }
+    std::vector<int> expected_unassigned_obs;
+    for (size_t j = 0; j < obs_used.size(); ++j) {
+      if (!obs_used[j]) {
+        expected_unassigned_obs.push_back(j);
+      }
+    }
+    EXPECT_EQ(expected_unassigned_obs, unassigned_obs);
+    num_assigned += assignment.size();
+    num_unassigned += unassigned_obs.size();
+    track_manager.Process(radar_obs);
+  }
+  EXPECT_GT(num_assigned, 0);
+  EXPECT_GT(num_unassigned, 0);
+}
+
+TEST(RadarTrackManagerTest, delete_lost_track) {
+  RadarTrackManager track_manager;
+  SensorObjects radar_obs;
+  for (int i = 0; i < 3; ++i) {
+    ObjectPtr obs(new Object);
+    obs->track_id = i;
+    obs->center << 10.0 * i, 0.0, 0.0;
+    radar_obs.objects.push_back(obs);
+  }
+  track_manager.Process(radar_obs);
+  ASSERT_EQ(3, track_manager.GetTracks().size());
+  const int first_id = track_manager.GetTracks()[0].GetObsId();
+  const int last_id = track_manager.GetTracks()[2].GetObsId();
+
+  // The second object is lost, and a new one appears.
+  radar_obs.timestamp = 0.1;
+  radar_obs.objects.erase(radar_obs.objects.begin() + 1);
+  ObjectPtr obs(new Object);
+  obs->track_id = 3;
+  radar_obs.objects.push_back(obs);
+  track_manager.Process(radar_obs);
+  auto &tracks = track_manager.GetTracks();
+  ASSERT_EQ(3, tracks.size());
+  EXPECT_EQ(first_id, tracks[0].GetObsId());
+  EXPECT_EQ(last_id, tracks[1].GetObsId());
+  EXPECT_EQ(3, tracks[2].GetObsRadar()->track_id);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "modules/perception/traffic_light/preprocessor/tl_preprocessor.h"
 
+#include <algorithm>
+
 #include "modules/perception/lib/base/time_util.h"
 #include "modules/perception/onboard/transform_input.h"
 #include "modules/perception/traffic_light/base/tl_shared_data.h"
@@ -80,7 +82,7 @@ bool TLPreprocessor::CacheLightsProjections(const CarPose &pose,
 
   // pop front if cached array'size > FLAGS_max_cached_image_lights_array_size
   while (cached_lights_.size() > static_cast<size_t>(max_cached_lights_size_)) {
-    cached_lights_.erase(cached_lights_.begin());
+    cached_lights_.pop_front();
   }
 
   // lights projection info. to be added in cached array
@@ -96,34 +98,9 @@ bool TLPreprocessor::CacheLightsProjections(const CarPose &pose,
   for (const auto &signal : signals) {
     AINFO << "signal info:" << signal.ShortDebugString();
   }
-  // lights projections info.
-
-  std::vector<std::shared_ptr<LightPtrs>> lights_on_image(kCountCameraId);
-  std::vector<std::shared_ptr<LightPtrs>> lights_outside_image(kCountCameraId);
-  for (auto &light_ptrs : lights_on_image) {
-    light_ptrs.reset(new LightPtrs);
-  }
-  for (auto &light_ptrs : lights_outside_image) {
-    light_ptrs.reset(new LightPtrs);
-  }
   if (signals.size() > 0) {
-    // project light region on each camera's image plane
-    for (int cam_id = 0; cam_id < kCountCameraId; ++cam_id) {
-      if (!ProjectLights(pose, signals, static_cast<CameraId>(cam_id),
-                         lights_on_image[cam_id].get(),
-                         lights_outside_image[cam_id].get())) {
-        AERROR << "add_cached_lights_projections project lights on "
-               << kCameraIdToStr.at(static_cast<CameraId>(cam_id))
-               << " image failed, "
-               << "ts: " << GLOG_TIMESTAMP(timestamp) << ", camera_id: "
-               << kCameraIdToStr.at(static_cast<CameraId>(cam_id));
-        return false;
-      }
-    }
-
     // select which image to be used
-    SelectImage(pose, lights_on_image, lights_outside_image,
-                &(image_lights->camera_id));
+    SelectImage(pose, signals, &(image_lights->camera_id));
     AINFO << "select camera: " << kCameraIdToStr.at(image_lights->camera_id);
 
   } else {
@@ -131,7 +108,14 @@ bool TLPreprocessor::CacheLightsProjections(const CarPose &pose,
   }
   image_lights->num_signals = signals.size();
   AINFO << "cached info with " << image_lights->num_signals << " signals";
-  cached_lights_.push_back(image_lights);
+  // keep the cache sorted, which appends in the usual case of increasing
+  // timestamps
+  cached_lights_.insert(
+      std::upper_bound(cached_lights_.begin(), cached_lights_.end(), timestamp,
+                       [](double ts, const std::shared_ptr<ImageLights> &l) {
+                         return ts < l->timestamp;
+                       }),
+      image_lights);
 
   return true;
 }
@@ -157,38 +141,48 @@ bool TLPreprocessor::SyncImage(const ImageSharedPtr &image,
   }
 
   // find close enough(by timestamp difference)
-  // lights projection from back to front
+  // lights projection from back to front, starting from the last one which is
+  // close enough, or earlier than the image
+  auto window_end = std::partition_point(
+      cached_lights_.begin(), cached_lights_.end(),
+      [this, image_ts](const std::shared_ptr<ImageLights> &lights) {
+        return lights->timestamp <= image_ts ||
+               fabs(lights->timestamp - image_ts) < sync_interval_seconds_;
+      });
 
   bool find_loc = false;  // if pose is found
-  auto cached_lights_ptr = cached_lights_.rbegin();
+  auto cached_lights_ptr =
+      std::deque<std::shared_ptr<ImageLights>>::reverse_iterator(window_end);
   for (; cached_lights_ptr != cached_lights_.rend(); ++cached_lights_ptr) {
     double light_ts = (*cached_lights_ptr)->timestamp;
-    if (fabs(light_ts - image_ts) < sync_interval_seconds_) {
-      find_loc = true;
-      auto proj_cam_id = static_cast<int>((*cached_lights_ptr)->camera_id);
-      auto image_cam_id = static_cast<int>(camera_id);
-      auto proj_cam_id_str =
-          (kCameraIdToStr.find(proj_cam_id) != kCameraIdToStr.end()
-               ? kCameraIdToStr.at(proj_cam_id)
-               : std::to_string(proj_cam_id));
-      // found related pose but if camear ID doesn't match
-      if (proj_cam_id != image_cam_id) {
-        AWARN << "find appropriate localization, but camera_id not match"
-              << ", cached projection's camera_id: " << proj_cam_id_str
-              << " , image's camera_id: " << kCameraIdToStr.at(image_cam_id);
-        continue;
-      }
-      if (image_ts < last_output_ts_) {
-        AWARN << "TLPreprocessor reject the image pub ts:"
-              << GLOG_TIMESTAMP(image_ts)
-              << " which is earlier than last output ts:"
-              << GLOG_TIMESTAMP(last_output_ts_)
-              << ", image camera_id: " << kCameraIdToStr.at(image_cam_id);
-        return false;
-      }
-      sync_ok = true;
+    // earlier lights projections are even farther from the image
+    if (fabs(light_ts - image_ts) >= sync_interval_seconds_) {
       break;
     }
+    find_loc = true;
+    auto proj_cam_id = static_cast<int>((*cached_lights_ptr)->camera_id);
+    auto image_cam_id = static_cast<int>(camera_id);
+    auto proj_cam_id_str =
+        (kCameraIdToStr.find(proj_cam_id) != kCameraIdToStr.end()
+             ? kCameraIdToStr.at(proj_cam_id)
+             : std::to_string(proj_cam_id));
+    // found related pose but if camear ID doesn't match
+    if (proj_cam_id != image_cam_id) {
+      AWARN << "find appropriate localization, but camera_id not match"
+            << ", cached projection's camera_id: " << proj_cam_id_str
+            << " , image's camera_id: " << kCameraIdToStr.at(image_cam_id);
+      continue;
+    }
+    if (image_ts < last_output_ts_) {
+      AWARN << "TLPreprocessor reject the image pub ts:"
+            << GLOG_TIMESTAMP(image_ts)
+            << " which is earlier than last output ts:"
+            << GLOG_TIMESTAMP(last_output_ts_)
+            << ", image camera_id: " << kCameraIdToStr.at(image_cam_id);
+      return false;
+    }
+    sync_ok = true;
+    break;
   }
 
   if (sync_ok) {
@@ -296,28 +290,35 @@ int TLPreprocessor::max_cached_lights_size() const {
 }
 
 void TLPreprocessor::SelectImage(const CarPose &pose,
-                                 const LightsArray &lights_on_image_array,
-                                 const LightsArray &lights_outside_image_array,
+                                 const std::vector<Signal> &signals,
                                  CameraId *selection) {
   *selection = static_cast<CameraId>(kShortFocusIdx);
 
   // check from long focus to short focus
+  Light light;
   for (int cam_id = 0; cam_id < kCountCameraId; ++cam_id) {
-    if (!lights_outside_image_array[cam_id]->empty()) {
-      continue;
+    // the short focus camera is selected by default, so that checking it last
+    // needs no projection
+    if (cam_id == kShortFocusIdx && cam_id == kCountCameraId - 1) {
+      break;
     }
     bool ok = true;
-    // find the short focus camera without range check
-    if (cam_id != kShortFocusIdx) {
-      for (const LightPtr &light : *(lights_on_image_array[cam_id])) {
-        if (IsOnBorder(cv::Size(projection_image_cols_, projection_image_rows_),
-                       light->region.projection_roi,
-                       image_border_size[cam_id])) {
-          ok = false;
-          AINFO << "light project on image border region, "
-                << "CameraId: " << kCameraIdToStr.at(cam_id);
-          break;
-        }
+    for (const auto &signal : signals) {
+      // all lights should be projected on the image
+      if (!projection_.Project(pose,
+                               ProjectOption(static_cast<CameraId>(cam_id)),
+                               signal, &light)) {
+        ok = false;
+        break;
+      }
+      // find the short focus camera without range check
+      if (cam_id != kShortFocusIdx &&
+          IsOnBorder(cv::Size(projection_image_cols_, projection_image_rows_),
+                     light.region.projection_roi, image_border_size[cam_id])) {
+        ok = false;
+        AINFO << "light project on image border region, "
+              << "CameraId: " << kCameraIdToStr.at(cam_id);
+        break;
       }
     }
     if (ok) {
@@ -17,6 +17,7 @@
 #ifndef MODULES_PERCEPTION_TRAFFIC_LIGHT_TL_PREPROCESSOR_H_
 #define MODULES_PERCEPTION_TRAFFIC_LIGHT_TL_PREPROCESSOR_H_
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -35,7 +36,6 @@ namespace perception {
 namespace traffic_light {
 
 using apollo::hdmap::Signal;
-typedef std::vector<std::shared_ptr<LightPtrs>> LightsArray;
 
 /**
  * @class TLPreprocessor
@@ -92,15 +92,13 @@ class TLPreprocessor : public BasePreprocessor {
                      LightPtrs *lights_outside_image);
 
   /**
-   * @brief given projected lights, select which camera to use
+   * @brief given signals, select which camera to use, projecting the signals
+   *        only on the cameras checked before the selected one
    * @param pose
-   * @param lights_on_image_array
-   * @param lights_outside_image_array
+   * @param signals
    * @param selectted camera
    */
-  void SelectImage(const CarPose &pose,
-                   const LightsArray &lights_on_image_array,
-                   const LightsArray &lights_outside_image_array,
+  void SelectImage(const CarPose &pose, const std::vector<Signal> &signals,
                    CameraId *selection);
 
   /**
@@ -125,7 +123,9 @@ class TLPreprocessor : public BasePreprocessor {
 
   double last_output_ts_ = 0.0;
 
-  std::vector<std::shared_ptr<ImageLights>> cached_lights_;
+  // lights projections sorted by timestamp, so that images are synced by
+  // binary search
+  std::deque<std::shared_ptr<ImageLights>> cached_lights_;
 
   Mutex mutex_;
 
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/traffic_light/preprocessor/tl_preprocessor.h"
+#include "modules/perception/traffic_light/projection/projection.h"
+
+namespace apollo {
+namespace perception {
+namespace traffic_light {
+namespace {
+
+// Signals of an intersection at the distance ahead of the car.
+std::vector<Signal> Signals(const double distance, const int num_signals) {
+  std::vector<Signal> signals(num_signals);
+  for (int i = 0; i < num_signals; ++i) {
+    signals[i].mutable_id()->set_id("signal_" + std::to_string(i));
+    const double y = -6.0 + 12.0 * i / num_signals;
+    const double corners[4][2] = {{y, 6.0}, {y + 0.4, 6.0}, {y + 0.4, 5.0},
+                                  {y, 5.0}};
+    for (const auto &corner : corners) {
+      auto *point = signals[i].mutable_boundary()->add_point();
+      point->set_x(distance);
+      point->set_y(corner[0]);
+      point->set_z(corner[1]);
+    }
+  }
+  return signals;
+}
+
+// Replays images of both cameras at 30 Hz while the car approaches the
+// signals, caching lights projections for each of them as the subnode does,
+// and reports the time to preprocess an image.
+void BM_PreprocessImage(benchmark::State &state) {
+  RegisterFactoryBoundaryProjection();
+  FLAGS_work_root = "modules/perception";
+  FLAGS_config_manager_path = "conf/config_manager.config";
+  if (!ConfigManager::instance()->Init()) {
+    state.SkipWithError("failed to init ConfigManager");
+    return;
+  }
+  TLPreprocessor preprocessor;
+  if (!preprocessor.Init()) {
+    state.SkipWithError("failed to init TLPreprocessor");
+    return;
+  }
+  const std::vector<Signal> signals = Signals(80.0, state.range(0));
+  const cv::Mat mat(1080, 1920, CV_8UC3);
+
+  int frame = 0;
+  while (state.KeepRunning()) {
+    const double ts = 1000.0 + frame / 30.0;
+    Eigen::Matrix4d pose_matrix = Eigen::Matrix4d::Identity();
+    pose_matrix(0, 3) = 10.0 * (frame % 150) / 30.0;
+    CarPose pose;
+    pose.set_pose(pose_matrix);
+    preprocessor.CacheLightsProjections(pose, signals, ts);
+
+    ImageSharedPtr image(new Image);
+    image->Init(ts, frame % 2 == 0 ? LONG_FOCUS : SHORT_FOCUS, mat);
+    ImageLightsPtr image_lights(new ImageLights);
+    bool should_pub = false;
+    preprocessor.SyncImage(image, &image_lights, &should_pub);
+    benchmark::DoNotOptimize(should_pub);
+    ++frame;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PreprocessImage)->Arg(4)->Arg(16);
+
+}  // namespace
+}  // namespace traffic_light
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
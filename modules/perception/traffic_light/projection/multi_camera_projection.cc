@@ -114,8 +114,14 @@ bool MultiCamerasProjection::Init() {
 bool MultiCamerasProjection::Project(const CarPose &pose,
                                      const ProjectOption &option,
                                      Light *light) const {
+  return Project(pose, option, light->info, light);
+}
+
+bool MultiCamerasProjection::Project(const CarPose &pose,
+                                     const ProjectOption &option,
+                                     const apollo::hdmap::Signal &tl_info,
+                                     Light *light) const {
   const Eigen::Matrix4d mpose = pose.pose();
-  const apollo::hdmap::Signal &tl_info = light->info;
   bool ret = true;
 
   auto camera_id = static_cast<int>(option.camera_id);
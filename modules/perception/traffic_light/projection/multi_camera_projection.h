@@ -36,6 +36,11 @@ class MultiCamerasProjection {
   virtual bool Init();
   virtual bool Project(const CarPose &pose, const ProjectOption &option,
                        Light *light) const;
+  // @brief Project the signal onto the region of the light, which does not
+  // need to hold a copy of the signal.
+  virtual bool Project(const CarPose &pose, const ProjectOption &option,
+                       const apollo::hdmap::Signal &signal,
+                       Light *light) const;
   std::string name() const { return "TLPreprocessor"; }
 
  private:
@@ -50,8 +50,10 @@ bool BoundaryProjection::Project(const CameraCoeffient &camera_coeffient,
   std::vector<int> x(bound_size);
   std::vector<int> y(bound_size);
 
+  const Eigen::Matrix4d world_to_camera =
+      camera_coeffient.camera_extrinsic * pose.inverse();
   for (int i = 0; i < bound_size; ++i) {
-    if (!ProjectPointDistort(camera_coeffient, pose,
+    if (!ProjectPointDistort(camera_coeffient, world_to_camera,
                              tl_info.boundary().point(i), &x[i], &y[i])) {
       return false;
     }
@@ -102,17 +104,15 @@ bool BoundaryProjection::ProjectPoint(const CameraCoeffient &coeffient,
   return true;
 }
 
-bool BoundaryProjection::ProjectPointDistort(const CameraCoeffient &coeffient,
-                                             const Eigen::Matrix4d &pose,
-                                             const common::PointENU &point,
-                                             int *center_x,
-                                             int *center_y) const {
+bool BoundaryProjection::ProjectPointDistort(
+    const CameraCoeffient &coeffient, const Eigen::Matrix4d &world_to_camera,
+    const common::PointENU &point, int *center_x, int *center_y) const {
   Eigen::Matrix<double, 4, 1> TL_loc_LTM;
   Eigen::Matrix<double, 3, 1> TL_loc_cam;
 
   TL_loc_LTM << point.x(), point.y(), point.z() + FLAGS_light_height_adjust,
       1.0;
-  TL_loc_LTM = coeffient.camera_extrinsic * pose.inverse() * TL_loc_LTM;
+  TL_loc_LTM = world_to_camera * TL_loc_LTM;
 
   if (TL_loc_LTM(2) < 0) {
     AWARN << "Compute a light behind the car. light to car Pose:\n"
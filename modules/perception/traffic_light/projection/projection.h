@@ -41,8 +41,10 @@ class BoundaryProjection : public BaseProjection {
                     const apollo::common::Point3D &point, int *center_x,
                     int *center_y) const;
 
+  // world_to_camera is camera_extrinsic * pose.inverse(), which is computed
+  // once for all the points of a light.
   bool ProjectPointDistort(const CameraCoeffient &coeffient,
-                           const Eigen::Matrix4d &pose,
+                           const Eigen::Matrix4d &world_to_camera,
                            const apollo::common::PointENU &point, int *center_x,
                            int *center_y) const;
 
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/traffic_light/recognizer/classify.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "modules/common/log.h"
@@ -46,44 +48,104 @@ void ClassifyBySimple::Init(const std::string &_class_net,
   resize_width_ = resize_width;
   unknown_threshold_ = threshold;
 
+  // Layers like ImageDistort are not part of the upstream caffe, the net is
+  // checked to give the same outputs to a batch as to each of its images.
+  batch_forward_ = CheckBatchForward();
+  if (!batch_forward_) {
+    AWARN << "Net " << _class_net << " does not support batches, "
+          << "lights are classified one by one.";
+  }
+
   AINFO << "Init Done";
 }
 
 void ClassifyBySimple::Perform(const cv::Mat &ros_image,
                                std::vector<LightPtr> *lights) {
-  caffe::Blob<float> *input_blob_recog = classify_net_ptr_->input_blobs()[0];
-  caffe::Blob<float> *output_blob_recog =
-      classify_net_ptr_->top_vecs()[classify_net_ptr_->top_vecs().size() - 1]
-                                   [0];
   cv::Mat img = ros_image(crop_box_);
+  std::vector<LightPtr> batch_lights;
   for (LightPtr light : *lights) {
-    if (!light->region.is_detected ||
-        !BoxIsValid(light->region.rectified_roi, ros_image.size())) {
-      continue;
+    if (light->region.is_detected &&
+        BoxIsValid(light->region.rectified_roi, ros_image.size())) {
+      batch_lights.push_back(light);
     }
+  }
+
+  // All lights are classified in one forward, as a batch of the input blob,
+  // unless the net does not support batches.
+  const size_t max_batch_size = batch_forward_ ? batch_lights.size() : 1;
+  std::vector<cv::Mat> light_images;
+  for (size_t begin = 0; begin < batch_lights.size();
+       begin += max_batch_size) {
+    const size_t end = std::min(begin + max_batch_size, batch_lights.size());
+    light_images.clear();
+    for (size_t i = begin; i < end; ++i) {
+      light_images.push_back(img(batch_lights[i]->region.rectified_roi));
+    }
+    const float *out_put_data = Forward(light_images);
+    for (size_t i = begin; i < end; ++i) {
+      ProbToColor(out_put_data + (i - begin) * output_size_,
+                  unknown_threshold_, batch_lights[i]);
+    }
+  }
+}
 
-    cv::Mat img_light = img(light->region.rectified_roi).clone();
+const float *ClassifyBySimple::Forward(
+    const std::vector<cv::Mat> &light_images) {
+  caffe::Blob<float> *input_blob_recog = classify_net_ptr_->input_blobs()[0];
+  const int batch_size = static_cast<int>(light_images.size());
+  if (input_blob_recog->num() != batch_size) {
+    input_blob_recog->Reshape(batch_size, 3, resize_height_, resize_width_);
+    classify_net_ptr_->Reshape();
+  }
+  float *data = input_blob_recog->mutable_cpu_data();
+  const int channel_size = resize_height_ * resize_width_;
+  for (int i = 0; i < batch_size; ++i) {
+    const cv::Mat &img_light = light_images[i];
     assert(img_light.rows > 0);
     assert(img_light.cols > 0);
 
-    cv::resize(img_light, img_light, cv::Size(resize_width_, resize_height_));
-    float *data = input_blob_recog->mutable_cpu_data();
-    uchar *pdata = img_light.data;
-    for (int h = 0; h < resize_height_; ++h) {
-      pdata = img_light.data + h * img_light.step;
-      for (int w = 0; w < resize_width_; ++w) {
-        for (int channel = 0; channel < 3; channel++) {
-          int index = (channel * resize_height_ + h) * resize_width_ + w;
-          data[index] = static_cast<float>((*pdata));
-          ++pdata;
-        }
-      }
+    cv::resize(img_light, resized_light_,
+               cv::Size(resize_width_, resize_height_));
+    resized_light_.convertTo(float_light_, CV_32FC3);
+    // Splits the channels into the planes of the light in the input blob.
+    cv::Mat channels[3];
+    for (int channel = 0; channel < 3; ++channel) {
+      channels[channel] =
+          cv::Mat(resize_height_, resize_width_, CV_32FC1,
+                  data + (i * 3 + channel) * channel_size);
     }
+    cv::split(float_light_, channels);
+  }
+
+  classify_net_ptr_->ForwardFrom(0);
+  caffe::Blob<float> *output_blob_recog =
+      classify_net_ptr_->top_vecs()[classify_net_ptr_->top_vecs().size() - 1]
+                                   [0];
+  output_size_ = output_blob_recog->count(1);
+  return output_blob_recog->cpu_data();
+}
 
-    classify_net_ptr_->ForwardFrom(0);
-    float *out_put_data = output_blob_recog->mutable_cpu_data();
-    ProbToColor(out_put_data, unknown_threshold_, light);
+bool ClassifyBySimple::CheckBatchForward() {
+  const int kBatchSize = 3;
+  std::vector<cv::Mat> light_images;
+  for (int i = 0; i < kBatchSize; ++i) {
+    cv::Mat img_light(resize_height_, resize_width_, CV_8UC3);
+    cv::randu(img_light, cv::Scalar::all(0), cv::Scalar::all(255));
+    light_images.push_back(img_light);
+  }
+  const float *batch_data = Forward(light_images);
+  const std::vector<float> batch_output(
+      batch_data, batch_data + kBatchSize * output_size_);
+  for (int i = 0; i < kBatchSize; ++i) {
+    const float *out_put_data = Forward({light_images[i]});
+    for (int j = 0; j < output_size_; ++j) {
+      if (std::fabs(out_put_data[j] - batch_output[i * output_size_ + j]) >
+          1e-4) {
+        return false;
+      }
+    }
   }
+  return true;
 }
 
 void ClassifyBySimple::ProbToColor(const float *out_put_data, float threshold,
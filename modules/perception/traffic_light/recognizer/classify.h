@@ -44,19 +44,36 @@ class ClassifyBySimple : public IRefine {
             float threshold, unsigned int resize_width,
             unsigned int resize_height);
 
+  // @brief classify the detected lights in one forward of the net, or one by
+  // one if the net does not support batches.
   virtual void Perform(const cv::Mat &ros_image, std::vector<LightPtr> *lights);
 
   void SetCropBox(const cv::Rect &box) override;
 
+  // @brief whether the lights are classified in one forward of the net.
+  bool batch_forward() const { return batch_forward_; }
+
   ~ClassifyBySimple() = default;
 
  private:
   void ProbToColor(const float *out_put_data, float threshold, LightPtr light);
+  // @brief forward the net with a batch of light images, and return the
+  // outputs, which are output_size_ floats per image.
+  const float *Forward(const std::vector<cv::Mat> &light_images);
+  // @brief check that the net gives the same outputs to a batch of images
+  // as to each of them alone.
+  bool CheckBatchForward();
+
   std::unique_ptr<caffe::Net<float>> classify_net_ptr_;
   cv::Rect crop_box_;
   int resize_width_ = 0;
   int resize_height_ = 0;
   float unknown_threshold_ = 0.0;
+  bool batch_forward_ = false;
+  int output_size_ = 0;
+  // Buffers of a light being preprocessed, reused across lights.
+  cv::Mat resized_light_;
+  cv::Mat float_light_;
 };
 
 }  // namespace traffic_light
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "caffe/caffe.hpp"
+
+#include "modules/perception/traffic_light/recognizer/classify.h"
+
+namespace apollo {
+namespace perception {
+namespace traffic_light {
+namespace {
+
+const char kModelDir[] =
+    "modules/perception/model/traffic_light/rcg_all/2017-11-17/vertical/";
+
+// Classifies range(0) vertical lights of an image with the day model, on the
+// CPU.
+void BM_ClassifyLights(benchmark::State &state) {
+  caffe::Caffe::set_mode(caffe::Caffe::CPU);
+  ClassifyBySimple classify(std::string(kModelDir) + "deploy.prototxt",
+                            std::string(kModelDir) +
+                                "baidu_iter_250000.caffemodel",
+                            0.5, 32, 96);
+  cv::Mat image(1080, 1920, CV_8UC3);
+  cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+  classify.SetCropBox(cv::Rect(0, 0, image.cols, image.rows));
+  std::vector<LightPtr> lights;
+  for (int i = 0; i < state.range(0); ++i) {
+    LightPtr light(new Light);
+    light->region.rectified_roi = cv::Rect(40 + 60 * i, 300, 20, 52);
+    light->region.is_detected = true;
+    light->region.detect_class_id = VERTICAL_CLASS;
+    lights.push_back(light);
+  }
+  while (state.KeepRunning()) {
+    classify.Perform(image, &lights);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ClassifyLights)->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace
+}  // namespace traffic_light
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/traffic_light/recognizer/classify.h"
+
+#include <string>
+#include <vector>
+
+#include "caffe/caffe.hpp"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace traffic_light {
+namespace {
+
+const char kModelDir[] = "modules/perception/model/traffic_light/rcg_all/";
+const int kNumLights = 5;
+
+// Checks that the lights of an image classified in one forward of a net get
+// the same colors and confidences as when each of them is classified alone.
+void ExpectBatchEqualsSingles(const std::string &net_dir,
+                              const std::string &model_name,
+                              unsigned int resize_width,
+                              unsigned int resize_height, cv::Size light_size) {
+  caffe::Caffe::set_mode(caffe::Caffe::CPU);
+  const std::string dir = std::string(kModelDir) + net_dir;
+  ClassifyBySimple classify(dir + "deploy.prototxt", dir + model_name, 0.5,
+                            resize_width, resize_height);
+  // The deployed nets start with the custom ImageDistort layer, which has to
+  // process every image of a batch.
+  EXPECT_TRUE(classify.batch_forward());
+
+  cv::Mat image(1080, 1920, CV_8UC3);
+  cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+  classify.SetCropBox(cv::Rect(0, 0, image.cols, image.rows));
+
+  std::vector<LightPtr> lights;
+  for (int i = 0; i < kNumLights; ++i) {
+    LightPtr light(new Light);
+    light->region.rectified_roi =
+        cv::Rect(cv::Point(100 + 150 * i, 300 + 20 * i), light_size);
+    light->region.is_detected = true;
+    lights.push_back(light);
+  }
+  classify.Perform(image, &lights);
+
+  for (int i = 0; i < kNumLights; ++i) {
+    LightPtr light(new Light);
+    light->region.rectified_roi = lights[i]->region.rectified_roi;
+    light->region.is_detected = true;
+    std::vector<LightPtr> single_light = {light};
+    classify.Perform(image, &single_light);
+    EXPECT_EQ(light->status.color, lights[i]->status.color) << i;
+    EXPECT_NEAR(light->status.confidence, lights[i]->status.confidence, 1e-5)
+        << i;
+  }
+}
+
+}  // namespace
+
+TEST(ClassifyBySimpleTest, DayVerticalBatch) {
+  ExpectBatchEqualsSingles("2017-11-17/vertical/",
+                           "baidu_iter_250000.caffemodel", 32, 96,
+                           cv::Size(20, 52));
+}
+
+TEST(ClassifyBySimpleTest, VerticalBatch) {
+  ExpectBatchEqualsSingles("2017-09-15/vertical/",
+                           "baidu_iter_200000.caffemodel", 32, 96,
+                           cv::Size(20, 52));
+}
+
+TEST(ClassifyBySimpleTest, HorizontalBatch) {
+  ExpectBatchEqualsSingles("2017-09-15/horizontal/",
+                           "baidu_iter_200000.caffemodel", 96, 32,
+                           cv::Size(52, 20));
+}
+
+TEST(ClassifyBySimpleTest, QuadrateBatch) {
+  ExpectBatchEqualsSingles("2017-09-15/quadrate/",
+                           "baidu_iter_200000.caffemodel", 64, 64,
+                           cv::Size(40, 40));
+}
+
+}  // namespace traffic_light
+}  // namespace perception
+}  // namespace apollo